@@ -0,0 +1,44 @@
+/**
+ * \file	frame_pacer_benchmark.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <lib_atlas/sys/frame_pacer.h>
+#include <iostream>
+
+using namespace atlas;
+
+// The jitter of the frames paced at a fractional rate.
+int main() {
+  const double kRate = 133.3;
+  const int kPeriods = 400;
+  FramePacer pacer(kRate);
+  for (int i = 0; i <= kPeriods; ++i) {
+    pacer.WaitNextFrame();
+  }
+  FramePacerStats stats = pacer.GetStats();
+  std::cout << "[ BENCHMARK] jitter at " << kRate << "Hz, "
+            << stats.late_frames << " late frames: "
+            << stats.jitter.ToString();
+  return 0;
+}
@@ -0,0 +1,97 @@
+/**
+ * \file	image_message_benchmark.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <lib_atlas/ros/image_message.h>
+#include <lib_atlas/sys/latency_histogram.h>
+#include <lib_atlas/sys/timer.h>
+#include <boost/make_shared.hpp>
+#include <sensor_msgs/image_encodings.h>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <string>
+
+using namespace atlas;
+
+namespace enc = sensor_msgs::image_encodings;
+
+namespace {
+
+/**
+ * Run frame for every iteration and print its latency and the CPU time it
+ * used.
+ */
+void Benchmark(const std::string &name, int iterations,
+               const std::function<void()> &frame) {
+  LatencyHistogram latency;
+  std::clock_t cpu_start = std::clock();
+  for (int i = 0; i < iterations; ++i) {
+    int64_t start = NanoTimer::Now();
+    frame();
+    latency.Record(static_cast<uint64_t>(NanoTimer::Now() - start));
+  }
+  double cpu_us = static_cast<double>(std::clock() - cpu_start) * 1000000. /
+                  CLOCKS_PER_SEC / iterations;
+  auto snapshot = latency.Snapshot();
+  std::cout << "[ BENCHMARK] " << name << ": mean "
+            << snapshot.MeanNs() / 1000. << "us, p99 < "
+            << snapshot.PercentileNs(99.) / 1000. << "us, cpu " << cpu_us
+            << "us per frame" << std::endl;
+}
+
+}  // namespace
+
+// The cost per VGA frame of publishing an image and receiving it, through
+// cv_bridge and through the recycled messages.
+int main() {
+  const int kIterations = 200;
+  cv::Mat image(480, 640, CV_8UC3);
+  cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+
+  // The previous path: a new message and a new image for every frame.
+  Benchmark("cv_bridge publish + toCvCopy", kIterations, [&image]() {
+    sensor_msgs::ImagePtr message =
+        cv_bridge::CvImage(std_msgs::Header(), enc::BGR8, image).toImageMsg();
+    cv::Mat received = cv_bridge::toCvCopy(message, enc::BGR8)->image;
+  });
+
+  // A recycled message, and the received image shared with the message.
+  auto message = boost::make_shared<sensor_msgs::Image>();
+  Benchmark("recycled publish + shared receive", kIterations,
+            [&image, &message]() {
+              FillImageMessage(image, *message);
+              sensor_msgs::ImageConstPtr received_message = message;
+              cv::Mat received = cv_bridge::toCvShare(received_message)->image;
+            });
+
+  // A recycled message, converted into a recycled buffer.
+  cv::Mat buffer;
+  Benchmark("recycled publish + pooled receive", kIterations,
+            [&image, &message, &buffer]() {
+              FillImageMessage(image, *message);
+              ConvertImageMessage(message, buffer);
+            });
+  return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * \file	instrumented_lock_benchmark.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <lib_atlas/sys/instrumented_lock.h>
+#include <lib_atlas/sys/timer.h>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace atlas;
+
+namespace {
+
+const int kThreadCount = 4;
+const int kIterations = 100000;
+
+// Increment a counter that is protected by the lock from several threads.
+// Returns the time in nanoseconds per lock/unlock pair.
+double Hammer(InstrumentedLock &lock, int thread_count, int64_t &counter) {
+  std::vector<std::thread> threads;
+  NanoTimer timer;
+  timer.Start();
+  for (int t = 0; t < thread_count; ++t) {
+    threads.emplace_back([&lock, &counter] {
+      for (int i = 0; i < kIterations; ++i) {
+        lock.Lock();
+        ++counter;
+        lock.Unlock();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return static_cast<double>(timer.NanoSeconds()) /
+         (thread_count * kIterations);
+}
+
+}  // namespace
+
+// The cost of a lock/unlock pair of every policy, without and with
+// contention.
+int main() {
+  const char *names[] = {"mutex", "spin-then-park", "none"};
+  for (auto policy :
+       {LockPolicy::kMutex, LockPolicy::kSpinThenPark, LockPolicy::kNone}) {
+    for (int threads : {1, kThreadCount}) {
+      if (policy == LockPolicy::kNone && threads != 1) {
+        continue;
+      }
+      InstrumentedLock lock(policy);
+      int64_t counter = 0;
+      double ns = Hammer(lock, threads, counter);
+      LockStats stats = lock.GetStats();
+      std::cout << "[ BENCHMARK] " << names[static_cast<int>(policy)] << ", "
+                << threads << " thread(s): " << ns << "ns per lock, "
+                << stats.contentions << " contentions" << std::endl;
+    }
+  }
+  return 0;
+}
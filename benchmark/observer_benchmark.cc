@@ -0,0 +1,90 @@
+/**
+ * \file	observer_benchmark.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <lib_atlas/pattern/observer.h>
+#include <lib_atlas/pattern/subject.h>
+#include <lib_atlas/sys/latency_histogram.h>
+#include <lib_atlas/sys/timer.h>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class CountingObserver : public atlas::Observer<int> {
+ public:
+  std::atomic<int> count_ = {0};
+
+ protected:
+  auto OnSubjectNotify(atlas::Subject<int> &subject,
+                       int nb) ATLAS_NOEXCEPT -> void override {
+    count_.fetch_add(nb);
+  }
+};
+
+}  // namespace
+
+// The latency of Notify while another thread keeps attaching and detaching
+// an observer.
+int main() {
+  const int kNotifications = 20000;
+  for (size_t observer_count = 1; observer_count <= 64; observer_count *= 2) {
+    atlas::Subject<int> subject;
+    std::vector<std::unique_ptr<CountingObserver>> observers;
+    for (size_t i = 0; i < observer_count; ++i) {
+      observers.emplace_back(new CountingObserver);
+      subject.Attach(*observers.back());
+    }
+
+    std::atomic<bool> done = {false};
+    std::atomic<uint64_t> changes = {0};
+    std::thread churn([&subject, &done, &changes]() {
+      CountingObserver transient;
+      while (!done) {
+        subject.Attach(transient);
+        subject.Detach(transient);
+        changes += 2;
+      }
+    });
+
+    atlas::LatencyHistogram latency;
+    for (int i = 0; i < kNotifications; ++i) {
+      int64_t start = atlas::NanoTimer::Now();
+      subject.Notify(1);
+      latency.Record(static_cast<uint64_t>(atlas::NanoTimer::Now() - start));
+    }
+    done = true;
+    churn.join();
+
+    auto snapshot = latency.Snapshot();
+    std::cout << "[ BENCHMARK] notify " << observer_count << " observers, "
+              << changes << " attach/detach: mean " << snapshot.MeanNs()
+              << "ns, p50 < " << snapshot.PercentileNs(50.) << "ns, p99 < "
+              << snapshot.PercentileNs(99.) << "ns" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * \file	serial_benchmark.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <lib_atlas/io/serial.h>
+#include <lib_atlas/sys/timer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#if defined(OS_LINUX)
+#include <pty.h>
+#else
+#include <util.h>
+#endif
+
+using namespace atlas;
+
+namespace {
+
+// NMEA sentences written by another thread and read line by line.
+void BenchmarkReadLine(Serial &serial, int master_fd) {
+  const size_t kLineCount = 2000;
+  const std::string sentence =
+      "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+  serial.EnableStats();
+  serial.ResetStats();
+  std::thread writer([&] {
+    for (size_t i = 0; i < kLineCount; ++i) {
+      write(master_fd, sentence.data(), sentence.length());
+    }
+  });
+
+  std::string line;
+  size_t lines_read = 0;
+  MicroTimer timer;
+  timer.Start();
+  while (lines_read < kLineCount) {
+    line.clear();
+    if (serial.ReadLine(line, 65536, "\r\n") == 0) {
+      break;
+    }
+    ++lines_read;
+  }
+  int64_t elapsed = timer.MicroSeconds();
+  writer.join();
+
+  SerialStatsSnapshot stats = serial.GetStats();
+  std::cout << "[ BENCHMARK] " << lines_read << " lines in " << elapsed
+            << "us, " << static_cast<double>(stats.syscalls) / lines_read
+            << " syscalls per line" << std::endl;
+}
+
+// Single bytes written 50us apart and read as soon as they arrive, with the
+// default and the low latency mode.
+void BenchmarkLowLatency(Serial &serial, int master_fd) {
+  const int kIterations = 2000;
+  for (bool low_latency : {false, true}) {
+    serial.SetLowLatency(low_latency ? LowLatency() : LowLatency::None());
+    serial.EnableStats();
+    serial.ResetStats();
+    std::thread sender([master_fd] {
+      for (int i = 0; i < kIterations; ++i) {
+        MicroTimer::Sleep(50);
+        write(master_fd, "x", 1);
+      }
+    });
+    NanoTimer timer;
+    timer.Start();
+    int received = 0;
+    while (received < kIterations && serial.Read(1).size() == 1) {
+      ++received;
+    }
+    sender.join();
+    SerialStatsSnapshot stats = serial.GetStats();
+    std::cout << "[ BENCHMARK] " << (low_latency ? "low latency" : "default")
+              << ": " << timer.NanoSeconds() / kIterations / 1000.
+              << "us per byte, "
+              << static_cast<double>(stats.syscalls) / kIterations
+              << " syscalls per read, read latency "
+              << stats.read_latency.MeanNs() / 1000. << "us" << std::endl;
+  }
+}
+
+}  // namespace
+
+int main() {
+  int master_fd;
+  int slave_fd;
+  char name[100];
+  if (openpty(&master_fd, &slave_fd, name, NULL, NULL) == -1) {
+    perror("openpty");
+    return 1;
+  }
+  Serial serial(std::string(name), 115200, Timeout::SimpleTimeout(250));
+  BenchmarkReadLine(serial, master_fd);
+  BenchmarkLowLatency(serial, master_fd);
+  serial.Close();
+  close(slave_fd);
+  close(master_fd);
+  return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * \file	serial_replay_benchmark.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <lib_atlas/io/serial.h>
+#include <lib_atlas/io/serial_recorder.h>
+#include <lib_atlas/io/serial_replayer.h>
+#include <lib_atlas/sys/timer.h>
+#include <stdio.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace atlas;
+
+namespace {
+
+const char *kLogPath = "/tmp/serial_replay_benchmark.log";
+
+}  // namespace
+
+// The throughput of the framing path alone, then of the whole Serial and
+// framing path through a pseudo terminal, replaying a log of frames of 32
+// bytes received in reads of 256 bytes.
+int main() {
+  const int kFrameCount = 50000;
+  std::string stream;
+  for (int i = 0; i < kFrameCount; ++i) {
+    char frame[33];
+    snprintf(frame, sizeof(frame), "$GPFRM,%08d,0123456789ABCDE\n", i);
+    stream += frame;
+  }
+  {
+    SerialRecorder recorder(kLogPath);
+    int64_t time_ns = NanoTimer::Now();
+    for (size_t i = 0; i < stream.size(); i += 256) {
+      std::string record = stream.substr(i, 256);
+      time_ns += 20000000;
+      recorder.Record(time_ns,
+                      reinterpret_cast<const uint8_t *>(record.data()),
+                      record.size());
+    }
+  }
+
+  SerialReplayer memory_replayer(kLogPath, SerialReplayer::Speed::kMaximum);
+  DelimiterFramer framer("\n");
+  std::string pending;
+  int memory_frames = 0;
+  NanoTimer timer;
+  timer.Start();
+  memory_replayer.Replay([&](const uint8_t *data, size_t size) {
+    pending.append(reinterpret_cast<const char *>(data), size);
+    size_t offset = 0;
+    FrameView frame;
+    while (size_t consumed = framer.Extract(
+               reinterpret_cast<uint8_t *>(&pending[offset]),
+               pending.size() - offset, frame)) {
+      offset += consumed;
+      memory_frames += frame.data != nullptr ? 1 : 0;
+    }
+    pending.erase(0, offset);
+  });
+  double memory_mb_s = stream.size() * 1000. / timer.NanoSeconds();
+
+  SerialReplayer pty_replayer(kLogPath, SerialReplayer::Speed::kMaximum);
+  Serial serial(pty_replayer.OpenPty(), 115200, Timeout::SimpleTimeout(250));
+  int pty_frames = 0;
+  timer.Start();
+  pty_replayer.Start();
+  FrameView frame;
+  while (pty_frames < kFrameCount && serial.ReadFrame(framer, frame)) {
+    ++pty_frames;
+  }
+  double pty_mb_s = stream.size() * 1000. / timer.NanoSeconds();
+  pty_replayer.Stop();
+
+  std::cout << "[ BENCHMARK] " << stream.size() << " bytes, in memory: "
+            << memory_mb_s << "MB/s (" << memory_frames
+            << " frames), through a pty: " << pty_mb_s << "MB/s ("
+            << pty_frames << " frames)" << std::endl;
+  return memory_frames == kFrameCount && pty_frames == kFrameCount ? 0 : 1;
+}
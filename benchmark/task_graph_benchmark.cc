@@ -0,0 +1,75 @@
+/**
+ * \file	task_graph_benchmark.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <lib_atlas/pattern/task_future.h>
+#include <lib_atlas/pattern/task_graph.h>
+#include <lib_atlas/sys/timer.h>
+#include <atomic>
+#include <iostream>
+#include <vector>
+
+using namespace atlas;
+
+// A four stages pipeline per frame, as the perception graph, run by a
+// TaskGraph and by chained TaskFutures.
+int main() {
+  const int kFrames = 64;
+  const int kRuns = 200;
+  for (size_t threads : {1, 2, 4}) {
+    ThreadPool pool(threads, ThreadPool::Scheduling::kWorkStealing);
+    TaskGraph graph(pool);
+    std::atomic<int> work(0);
+    auto stage = [&work] { work.fetch_add(1, std::memory_order_relaxed); };
+    for (int frame = 0; frame < kFrames; ++frame) {
+      auto undistort = graph.Add(stage);
+      auto threshold = graph.Add(stage, {undistort});
+      auto contours = graph.Add(stage, {threshold});
+      graph.Add(stage, {contours});
+    }
+    NanoTimer timer;
+    timer.Start();
+    for (int run = 0; run < kRuns; ++run) {
+      graph.Run().Get();
+    }
+    double graph_ns = static_cast<double>(timer.NanoSeconds());
+
+    timer.Start();
+    for (int run = 0; run < kRuns; ++run) {
+      std::vector<TaskFuture<void>> frames;
+      for (int frame = 0; frame < kFrames; ++frame) {
+        frames.push_back(
+            Async(pool, stage).Then(stage).Then(stage).Then(stage));
+      }
+      WhenAll(frames).Get();
+    }
+    double then_ns = static_cast<double>(timer.NanoSeconds());
+
+    std::cout << "[ BENCHMARK] " << threads << " thread(s): TaskGraph "
+              << graph_ns / (kRuns * kFrames * 4) << "ns per task, Then "
+              << then_ns / (kRuns * kFrames * 4) << "ns per task"
+              << std::endl;
+  }
+  return 0;
+}
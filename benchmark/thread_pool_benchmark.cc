@@ -0,0 +1,270 @@
+/**
+ * \file	thread_pool_benchmark.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <lib_atlas/pattern/thread_pool.h>
+#include <lib_atlas/sys/latency_histogram.h>
+#include <lib_atlas/sys/timer.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "../test/allocation_counter.h"
+
+using namespace atlas;
+
+namespace {
+
+const ThreadPool::Scheduling kSchedulings[] = {
+    ThreadPool::Scheduling::kSharedQueue,
+    ThreadPool::Scheduling::kWorkStealing};
+
+const char *kSchedulingNames[] = {"shared queue", "work stealing"};
+
+const ThreadPool::Partition kPartitions[] = {ThreadPool::Partition::kStatic,
+                                             ThreadPool::Partition::kDynamic,
+                                             ThreadPool::Partition::kGuided};
+
+const char *kPartitionNames[] = {"static", "dynamic", "guided"};
+
+void WaitFor(const std::atomic<int> &counter, int value) {
+  while (counter.load() < value) {
+    std::this_thread::yield();
+  }
+}
+
+// Post tasks that each post children from the worker, as a recursive image
+// split would. Returns the number of tasks executed per second.
+double FanOut(ThreadPool &pool, int roots, int children) {
+  std::atomic<int> done(0);
+  NanoTimer timer;
+  timer.Start();
+  for (int i = 0; i < roots; ++i) {
+    pool.Post([&pool, &done, children] {
+      for (int j = 0; j < children; ++j) {
+        pool.Post([&done] { done.fetch_add(1); });
+      }
+      done.fetch_add(1);
+    });
+  }
+  WaitFor(done, roots * (children + 1));
+  return roots * (children + 1) * 1e9 / timer.NanoSeconds();
+}
+
+// Post every task from the calling thread. Returns the number of tasks
+// executed per second.
+double External(ThreadPool &pool, int tasks) {
+  std::atomic<int> done(0);
+  NanoTimer timer;
+  timer.Start();
+  for (int i = 0; i < tasks; ++i) {
+    pool.Post([&done] { done.fetch_add(1); });
+  }
+  WaitFor(done, tasks);
+  return tasks * 1e9 / timer.NanoSeconds();
+}
+
+// Enqueue every task from the calling thread and wait for their futures, as
+// the users of the pool did before Post and the work-stealing scheduling.
+// Returns the number of tasks executed per second.
+double EnqueueAndWait(ThreadPool &pool, int tasks) {
+  std::vector<std::future<void>> futures;
+  futures.reserve(tasks);
+  NanoTimer timer;
+  timer.Start();
+  for (int i = 0; i < tasks; ++i) {
+    futures.push_back(pool.Enqueue([] {}));
+  }
+  for (auto &future : futures) {
+    future.get();
+  }
+  return tasks * 1e9 / timer.NanoSeconds();
+}
+
+// A loop split in chunks by hand with Enqueue, then with ParallelFor.
+void BenchmarkParallelFor() {
+  const size_t kCount = 1 << 22;
+  const size_t kGrain = 1 << 14;
+  std::vector<float> values(kCount, 1.f);
+  ThreadPool pool(4, ThreadPool::Scheduling::kWorkStealing);
+  auto work = [&values](size_t i) { values[i] = values[i] * 0.5f + 1.f; };
+
+  NanoTimer timer;
+  timer.Start();
+  size_t allocations = g_allocations.load();
+  std::vector<std::future<void>> futures;
+  for (size_t first = 0; first < kCount; first += kGrain) {
+    futures.push_back(pool.Enqueue([&work, first, kGrain] {
+      for (size_t i = first; i < first + kGrain; ++i) {
+        work(i);
+      }
+    }));
+  }
+  for (auto &future : futures) {
+    future.get();
+  }
+  double ms = timer.NanoSeconds() / 1e6;
+  allocations = g_allocations.load() - allocations;
+  std::cout << "[ BENCHMARK] " << kCount / kGrain
+            << " Enqueue and futures: " << ms << "ms, " << allocations
+            << " allocations" << std::endl;
+
+  for (auto partition : kPartitions) {
+    timer.Start();
+    allocations = g_allocations.load();
+    pool.ParallelFor(size_t(0), kCount, kGrain, work, partition);
+    ms = timer.NanoSeconds() / 1e6;
+    allocations = g_allocations.load() - allocations;
+    std::cout << "[ BENCHMARK] ParallelFor, "
+              << kPartitionNames[static_cast<int>(partition)] << ": " << ms
+              << "ms, " << allocations << " allocations" << std::endl;
+  }
+}
+
+// The throughput of the tasks submitted from outside the pool and from its
+// workers, against the baseline of Enqueue and futures on the shared queue.
+void BenchmarkThroughput() {
+  for (size_t threads : {1, 2, 4, 8, 16, 32}) {
+    {
+      ThreadPool pool(threads, ThreadPool::Scheduling::kSharedQueue);
+      double baseline = EnqueueAndWait(pool, 50000);
+      std::cout << "[ BENCHMARK] baseline, Enqueue and futures, shared queue, "
+                << threads << " thread(s): " << baseline / 1e6
+                << "M tasks/s external" << std::endl;
+    }
+    for (auto scheduling : kSchedulings) {
+      ThreadPool pool(threads, scheduling);
+      double external = External(pool, 50000);
+      double fan_out = FanOut(pool, 50, 1000);
+      std::cout << "[ BENCHMARK] "
+                << "Post, " << kSchedulingNames[static_cast<int>(scheduling)]
+                << ", " << threads << " thread(s): " << external / 1e6
+                << "M tasks/s external, " << fan_out / 1e6
+                << "M tasks/s nested, " << pool.GetStealCount() << " steals"
+                << std::endl;
+    }
+  }
+}
+
+// The wait of the realtime tasks while the workers drain a flood of
+// background tasks.
+void BenchmarkPriorities() {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(4, scheduling);
+    pool.EnableStats();
+    const int kBackground = 50000;
+    const int kRealtime = 1000;
+    std::atomic<int> done(0);
+    for (int i = 0; i < kBackground; ++i) {
+      if (i % (kBackground / kRealtime) == 0) {
+        pool.Post(ThreadPool::Priority::kRealtime,
+                  [&done] { done.fetch_add(1); });
+      }
+      pool.Post(ThreadPool::Priority::kBackground,
+                [&done] { done.fetch_add(1); });
+    }
+    WaitFor(done, kBackground + kRealtime);
+    for (auto priority :
+         {ThreadPool::Priority::kRealtime, ThreadPool::Priority::kBackground}) {
+      auto wait = pool.GetPriorityStats(priority).wait;
+      std::cout << "[ BENCHMARK] "
+                << kSchedulingNames[static_cast<int>(scheduling)] << ", "
+                << (priority == ThreadPool::Priority::kRealtime ? "realtime"
+                                                                : "background")
+                << " wait: p50 < " << wait.PercentileNs(50.) / 1000.
+                << "us, p99 < " << wait.PercentileNs(99.) / 1000. << "us"
+                << std::endl;
+    }
+  }
+}
+
+// The latency between the submission of a task and its start when the
+// workers are idle, with and without spinning.
+void BenchmarkWakeUp() {
+  for (size_t spin_count : {size_t(0), size_t(20000)}) {
+    ThreadPool::Sizing sizing;
+    sizing.min_threads = 4;
+    sizing.max_threads = 4;
+    sizing.spin_count = spin_count;
+    ThreadPool pool(sizing);
+    LatencyHistogram latency;
+    for (int i = 0; i < 200; ++i) {
+      std::atomic<int> done(0);
+      int64_t submit = NanoTimer::Now();
+      pool.Post([&done, &latency, submit] {
+        latency.Record(static_cast<uint64_t>(NanoTimer::Now() - submit));
+        done.fetch_add(1);
+      });
+      WaitFor(done, 1);
+      // Let the workers go idle between two frames.
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    auto snapshot = latency.Snapshot();
+    std::cout << "[ BENCHMARK] wake-up, spin " << spin_count << ": p50 < "
+              << snapshot.PercentileNs(50.) / 1000. << "us, p99 < "
+              << snapshot.PercentileNs(99.) / 1000. << "us" << std::endl;
+  }
+}
+
+// A burst of tasks grows the queue, so part of the tasks allocate a node.
+void BenchmarkBurst() {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(4, scheduling);
+    for (bool post : {false, true}) {
+      const int kTasks = 20000;
+      std::atomic<int> done(0);
+      size_t allocations = g_allocations.load();
+      NanoTimer timer;
+      timer.Start();
+      for (int i = 0; i < kTasks; ++i) {
+        if (post) {
+          pool.Post([&done] { done.fetch_add(1); });
+        } else {
+          pool.Enqueue([&done] { done.fetch_add(1); });
+        }
+      }
+      WaitFor(done, kTasks);
+      std::cout << "[ BENCHMARK] "
+                << kSchedulingNames[static_cast<int>(scheduling)] << ", "
+                << (post ? "Post" : "Enqueue") << ": "
+                << kTasks * 1e3 / timer.NanoSeconds() << "M tasks/s, "
+                << static_cast<double>(g_allocations.load() - allocations) /
+                       kTasks
+                << " allocations per task" << std::endl;
+    }
+  }
+}
+
+}  // namespace
+
+int main() {
+  BenchmarkParallelFor();
+  BenchmarkThroughput();
+  BenchmarkPriorities();
+  BenchmarkWakeUp();
+  BenchmarkBurst();
+  return 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * \file	triple_buffer_benchmark.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <lib_atlas/pattern/triple_buffer.h>
+#include <lib_atlas/sys/timer.h>
+#include <stdint.h>
+#include <iostream>
+
+using namespace atlas;
+
+namespace {
+
+struct Sample {
+  uint64_t sequence = {0};
+
+  uint64_t checksum = {0};
+};
+
+}  // namespace
+
+// The cost of a publication followed by its reception, on a single thread.
+int main() {
+  const int kIterations = 1000000;
+  TripleBuffer<Sample> buffer;
+  int64_t start = NanoTimer::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    buffer.GetWriteBuffer().sequence = static_cast<uint64_t>(i);
+    buffer.Publish();
+    buffer.Update();
+  }
+  int64_t elapsed = NanoTimer::Now() - start;
+  std::cout << "[ BENCHMARK] publish + update: "
+            << static_cast<double>(elapsed) / kIterations << "ns, last "
+            << buffer.GetReadBuffer().sequence << std::endl;
+  return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * \file	async_writer.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_DETAILS_ASYNC_WRITER_H_
+#define LIB_ATLAS_IO_DETAILS_ASYNC_WRITER_H_
+
+#include <lib_atlas/io/details/spsc_byte_queue.h>
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/runnable.h>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * The drain thread of the asynchronous write mode of a Serial port.
+ *
+ * The writers copy their bytes in a lock-free queue and return right away,
+ * the thread empties the queue into the file descriptor with the synchronous
+ * write path of the port. The writers are serialized by the write lock of
+ * the port, so the queue only has a single producer.
+ */
+class Serial::AsyncWriter : public Runnable {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  AsyncWriter(SerialImpl &serial, size_t capacity, AsyncWritePolicy policy,
+              const Timeout &timeout);
+
+  ~AsyncWriter() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Queue the bytes of the buffers. Must be called with the write lock.
+   *
+   * \return The number of bytes that were queued.
+   * \throw The exception that stopped the drain thread, if any.
+   */
+  size_t Push(const iovec *buffers, size_t count);
+
+  /**
+   * \return A future that becomes ready once the bytes queued so far have
+   *         been written to the device.
+   */
+  std::future<void> Flush();
+
+  /**
+   * Set the write timeout used by the drain thread from its next write on.
+   */
+  void SetTimeout(const Timeout &timeout);
+
+  AsyncWriteStats GetStats() const ATLAS_NOEXCEPT;
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  void Run() override;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Fulfill the flush requests up to the given read position of the queue, or
+   * fail all of them if an error is given.
+   */
+  void CompleteFlushes(size_t position, std::exception_ptr error);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  /** Maximum time the drain thread sleeps before checking MustStop(). */
+  static const int kPollPeriodMs = 100;
+
+  /** Maximum number of bytes given to a single ::write. */
+  static const size_t kChunkSize = 4096;
+
+  SerialImpl &serial_;
+
+  AsyncWritePolicy policy_;
+
+  details::SpscByteQueue queue_;
+
+  std::vector<uint8_t> chunk_;
+
+  /** Copy of the buffers of the write in progress, see SyncWrite(). */
+  std::vector<iovec> write_buffers_;
+
+  std::atomic<size_t> high_water_mark_;
+
+  std::atomic<uint64_t> dropped_bytes_;
+
+  /** True while the drain thread waits for bytes to be queued. */
+  std::atomic<bool> sleeping_;
+
+  std::atomic<bool> failed_;
+
+  /** Set under the mutex when the writer is destroyed. */
+  bool stopping_;
+
+  mutable std::mutex mutex_;
+
+  std::condition_variable condition_;
+
+  /** Pending flushes, with the write position they wait for. */
+  std::vector<std::pair<size_t, std::promise<void>>> flushes_;
+
+  /** Read position of the queue below which every byte was written. */
+  size_t flushed_position_;
+
+  std::exception_ptr error_;
+
+  /** Write timeout of the port, copied by the drain thread under the mutex. */
+  Timeout timeout_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/details/async_writer_inl.h>
+
+#endif  // LIB_ATLAS_IO_DETAILS_ASYNC_WRITER_H_
@@ -0,0 +1,227 @@
+/**
+ * \file	async_writer_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_DETAILS_ASYNC_WRITER_H_
+#error This file may only be included from async_writer.h
+#endif
+
+#include <algorithm>
+#include <chrono>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Serial::AsyncWriter::AsyncWriter(SerialImpl &serial,
+                                              size_t capacity,
+                                              AsyncWritePolicy policy,
+                                              const Timeout &timeout)
+    : Runnable(),
+      serial_(serial),
+      policy_(policy),
+      queue_(capacity),
+      chunk_(kChunkSize),
+      write_buffers_(),
+      high_water_mark_(0),
+      dropped_bytes_(0),
+      sleeping_(false),
+      failed_(false),
+      stopping_(false),
+      mutex_(),
+      condition_(),
+      flushes_(),
+      flushed_position_(0),
+      error_(),
+      timeout_(timeout) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Serial::AsyncWriter::~AsyncWriter() ATLAS_NOEXCEPT {
+  if (IsRunning()) {
+    // Wake the drain thread up so Stop() does not wait for a poll period.
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+      condition_.notify_one();
+    }
+    Stop();
+  }
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::AsyncWriter::Push(const iovec *buffers,
+                                              size_t count) {
+  if (failed_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::rethrow_exception(error_);
+  }
+  size_t length = 0;
+  for (size_t i = 0; i < count; ++i) {
+    length += buffers[i].iov_len;
+  }
+  if (length == 0) {
+    return 0;
+  }
+
+  size_t queued = length;
+  if (policy_ == AsyncWritePolicy::kDropNewest) {
+    if (!queue_.TryPush(buffers, count)) {
+      dropped_bytes_.fetch_add(length, std::memory_order_relaxed);
+      queued = 0;
+    }
+  } else {
+    queued = queue_.PushPartial(buffers, count);
+    dropped_bytes_.fetch_add(length - queued, std::memory_order_relaxed);
+  }
+
+  // There is a single producer, so the maximum does not need a CAS loop.
+  size_t size = queue_.Size();
+  if (size > high_water_mark_.load(std::memory_order_relaxed)) {
+    high_water_mark_.store(size, std::memory_order_relaxed);
+  }
+
+  // Pairs with the fence of the drain thread, so either it sees the new bytes
+  // before going to sleep, or we see that it sleeps.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping_.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    condition_.notify_one();
+  }
+  return queued;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::future<void> Serial::AsyncWriter::Flush() {
+  std::promise<void> promise;
+  std::future<void> future = promise.get_future();
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t position = queue_.WritePosition();
+  if (error_) {
+    promise.set_exception(error_);
+  } else if (flushed_position_ >= position) {
+    promise.set_value();
+  } else {
+    flushes_.emplace_back(position, std::move(promise));
+  }
+  return future;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::AsyncWriter::SetTimeout(const Timeout &timeout) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  timeout_ = timeout;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE AsyncWriteStats Serial::AsyncWriter::GetStats() const
+    ATLAS_NOEXCEPT {
+  AsyncWriteStats stats;
+  stats.queued_bytes = queue_.Size();
+  stats.high_water_mark = high_water_mark_.load(std::memory_order_relaxed);
+  stats.dropped_bytes = dropped_bytes_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::AsyncWriter::Run() {
+  while (!MustStop()) {
+    size_t length = queue_.Pop(chunk_.data(), chunk_.size());
+    if (length == 0) {
+      CompleteFlushes(queue_.ReadPosition(), nullptr);
+      std::unique_lock<std::mutex> lock(mutex_);
+      sleeping_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      std::chrono::milliseconds period(static_cast<int>(kPollPeriodMs));
+      condition_.wait_for(lock, period, [this] {
+        return queue_.Size() != 0 || stopping_ || MustStop();
+      });
+      sleeping_.store(false, std::memory_order_relaxed);
+      continue;
+    }
+
+    Timeout timeout;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      timeout = timeout_;
+    }
+    try {
+      // A write that times out is retried, the queued bytes are never
+      // discarded.
+      size_t written = 0;
+      while (written < length && !MustStop()) {
+        iovec buffer = {chunk_.data() + written, length - written};
+        size_t written_now =
+            serial_.SyncWrite(&buffer, 1, timeout, write_buffers_);
+        if (written_now == 0) {
+          serial_.WaitWritable(kPollPeriodMs);
+        }
+        written += written_now;
+      }
+    } catch (const std::exception &) {
+      failed_.store(true, std::memory_order_release);
+      CompleteFlushes(0, std::current_exception());
+      return;
+    }
+    CompleteFlushes(queue_.ReadPosition(), nullptr);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::AsyncWriter::CompleteFlushes(
+    size_t position, std::exception_ptr error) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (error) {
+    error_ = error;
+    for (auto &flush : flushes_) {
+      flush.second.set_exception(error);
+    }
+    flushes_.clear();
+    return;
+  }
+  flushed_position_ = position;
+  auto completed = std::partition(
+      flushes_.begin(), flushes_.end(),
+      [position](const std::pair<size_t, std::promise<void>> &flush) {
+        return flush.first > position;
+      });
+  for (auto it = completed; it != flushes_.end(); ++it) {
+    it->second.set_value();
+  }
+  flushes_.erase(completed, flushes_.end());
+}
+
+}  // namespace atlas
@@ -39,8 +39,16 @@
 #define LIB_ATLAS_IO_DETAILS_SERIAL_IMPL_H_
 
 #include <lib_atlas/exceptions.h>
+#include <lib_atlas/io/serial_recorder.h>
+#include <lib_atlas/io/serial_stats.h>
+#include <lib_atlas/sys/instrumented_lock.h>
 #include <pthread.h>
+#include <future>
+#include <sys/uio.h>
+#include <exception>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace atlas {
 
@@ -58,7 +66,8 @@ class Serial::SerialImpl {
 
   SerialImpl(const std::string &port, unsigned long baudrate,
              bytesize_t bytesize, parity_t parity, stopbits_t stopbits,
-             flowcontrol_t flowcontrol);
+             flowcontrol_t flowcontrol,
+             LockPolicy lock_policy = LockPolicy::kMutex);
 
   virtual ~SerialImpl();
 
@@ -75,12 +84,66 @@ class Serial::SerialImpl {
 
   bool WaitReadable(uint32_t timeout);
 
+  /**
+   * Wait until the output queue of the device can take more bytes.
+   *
+   * \return False if the timeout expired.
+   */
+  bool WaitWritable(uint32_t timeout);
+
   void WaitByteTimes(size_t count);
 
-  size_t Read(uint8_t *buf, size_t size = 1);
+  /**
+   * \param receive_ns If not null and a byte was read, set to the time the
+   *        first byte was received, see ReceiveTime().
+   */
+  size_t Read(uint8_t *buf, size_t size = 1, int64_t *receive_ns = nullptr);
+
+  size_t ReadLine(std::string &buffer, size_t size, const std::string &eol,
+                  int64_t *receive_ns = nullptr);
+
+  size_t TryReadLine(std::string &buffer, size_t size, const std::string &eol);
+
+  bool ReadFrame(Framer &framer, FrameView &frame,
+                 int64_t *receive_ns = nullptr);
+
+  bool TryReadFrame(Framer &framer, FrameView &frame);
+
+  std::vector<std::string> ReadLines(size_t size, const std::string &eol);
 
   size_t Write(const uint8_t *data, size_t length);
 
+  size_t Write(const iovec *buffers, size_t count);
+
+  /**
+   * Write the buffers on the descriptor, even if the asynchronous write mode
+   * is enabled. This is the write path of the drain thread, which gives its
+   * own copy of the write timeout and of the buffers, so it does not share
+   * them with the writers.
+   *
+   * \param buffers_copy Storage reused for the partially written buffers.
+   */
+  size_t SyncWrite(const iovec *buffers, size_t count, const Timeout &timeout,
+                   std::vector<iovec> &buffers_copy);
+
+  void EnableAsyncWrite(size_t capacity, AsyncWritePolicy policy);
+
+  void DisableAsyncWrite();
+
+  bool IsAsyncWriteEnabled() const;
+
+  std::future<void> FlushAsync();
+
+  AsyncWriteStats GetAsyncWriteStats() const;
+
+  void SetLowLatency(const LowLatency &low_latency);
+
+  LowLatency GetLowLatency() const;
+
+  void SetRecorder(SerialRecorder::Ptr recorder);
+
+  std::exception_ptr GetRecorderError() const;
+
   void Flush();
 
   void FlushInput();
@@ -133,6 +196,8 @@ class Serial::SerialImpl {
 
   flowcontrol_t GetFlowcontrol() const;
 
+  int GetFileDescriptor() const;
+
   void ReadLock();
 
   void ReadUnlock();
@@ -141,18 +206,151 @@ class Serial::SerialImpl {
 
   void WriteUnlock();
 
+  LockStats GetReadLockStats() const;
+
+  LockStats GetWriteLockStats() const;
+
+  void ResetLockStats();
+
+  void EnableStats(bool enable);
+
+  bool IsStatsEnabled() const;
+
+  SerialStatsSnapshot GetStats() const;
+
+  void ResetStats();
+
  protected:
   //============================================================================
   // P R O T E C T E D   M E T H O D S
 
   void ReconfigurePort();
 
+  /**
+   * Apply the kernel flag of the low latency mode and open or close the
+   * blocking read descriptor.
+   */
+  void ApplyLowLatency();
+
+  /**
+   * Set a baudrate that has no Bxxx constant.
+   */
+  void SetCustomBaudrate();
+
+  /**
+   * \return The VTIME of the blocking reads, in tenths of a second. The read
+   *         timeout is rounded down, so a ::read never waits past it.
+   */
+  uint8_t ReadTimeoutDeciseconds() const;
+
+  /**
+   * Wait until a blocking ::read on the read descriptor can be issued
+   * without waiting past the timeout: right away if VTIME fits in the
+   * timeout, otherwise once poll reports data within the exact timeout.
+   *
+   * \return False if the timeout elapsed or the poll was interrupted.
+   */
+  bool WaitBlockingRead(uint32_t timeout);
+
  private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Wait for the device and read everything it has ready into the internal
+   * read buffer, which is grown so it can hold at least capacity bytes.
+   *
+   * \return False if timeout_ms expired before any byte was received.
+   */
+  bool FillReadBuffer(size_t capacity, uint32_t timeout_ms);
+
+  /**
+   * Move the pending bytes to the front of the read buffer and grow it so it
+   * can hold at least capacity bytes.
+   *
+   * \return The number of bytes that can still be received in the buffer.
+   */
+  size_t ReserveReadBuffer(size_t capacity);
+
+  /**
+   * Drain the device into the free space of the read buffer with a single
+   * non blocking ::read.
+   *
+   * \return The value returned by ::read.
+   */
+  ssize_t ReadIntoBuffer(int fd);
+
+  /**
+   * A non blocking ::read of the device that is retried when interrupted and
+   * accounted for in the statistics.
+   *
+   * \return The value returned by ::read.
+   */
+  ssize_t ReadDevice(int fd, uint8_t *buf, size_t size);
+
+  /**
+   * Move up to size bytes that are pending in the read buffer into buf.
+   *
+   * \return The number of bytes moved out of the read buffer.
+   */
+  size_t ConsumeReadBuffer(uint8_t *buf, size_t size);
+
+  /**
+   * Append exactly size pending bytes of the read buffer to buffer.
+   *
+   * \return The number of bytes moved out of the read buffer.
+   */
+  size_t ConsumeReadBuffer(std::string &buffer, size_t size);
+
+  /**
+   * Drop count pending bytes of the read buffer.
+   */
+  void SkipReadBuffer(size_t count);
+
+  /**
+   * Estimate when a byte started to arrive from the time of the ::read that
+   * returned it. The bytes are assumed to have arrived back to back just
+   * before the ::read, so the time is moved backwards by the transmission
+   * time of the byte and of the ones that followed it in the same ::read.
+   *
+   * \param bytes_after The number of bytes returned by the same ::read after
+   *        the byte.
+   * \return A NanoTimer::Now() time.
+   */
+  int64_t ReceiveTime(int64_t read_ns, size_t bytes_after) const;
+
+  /**
+   * \return The receive time of the first byte pending in the read buffer.
+   */
+  int64_t PendingReceiveTime() const;
+
+  /**
+   * Search the first size bytes pending in the read buffer for eol, skipping
+   * the first offset bytes that were already searched.
+   *
+   * \return The length of the line including eol, or 0 if eol was not found.
+   */
+  size_t FindEol(size_t size, size_t offset, const std::string &eol) const;
+
+  /**
+   * Give the pending bytes to the framer until it extracts a frame, dropping
+   * the bytes it consumes.
+   *
+   * \param receive_ns If not null, set to the receive time of the first
+   *        byte of the extracted frame.
+   * \return True if a frame was extracted.
+   */
+  bool ExtractFrame(Framer &framer, FrameView &frame,
+                    int64_t *receive_ns = nullptr);
+
   //============================================================================
   // P R I V A T E   M E M B E R S
 
   std::string port_;  // Path to the file descriptor
   int fd_;            // The current file descriptor
+  // Blocking descriptor of the low latency reads, -1 when they are disabled.
+  // The port stays non blocking for the writes and the Try* reads.
+  int read_fd_;
 
   bool is_open_;
   bool xonxoff_;
@@ -166,12 +364,50 @@ class Serial::SerialImpl {
   bytesize_t bytesize_;        // Size of the bytes
   stopbits_t stopbits_;        // Stop Bits
   flowcontrol_t flowcontrol_;  // Flow Control
-
-  // TODO: Use the mutex from mutex.h
-  // Mutex used to lock the read functions
-  pthread_mutex_t read_mutex;
-  // Mutex used to lock the write functions
-  pthread_mutex_t write_mutex;
+  LowLatency low_latency_;
+
+  // Bytes received from the device but not yet returned to the caller.
+  // Pending data lives in [read_begin_, read_end_) and is kept contiguous so
+  // delimiters can be searched with memchr/memmem.
+  std::vector<uint8_t> read_buffer_;
+  size_t read_begin_;
+  size_t read_end_;
+
+  // A ::read that filled the read buffer: the position in the received
+  // stream right after its last byte, and the time it returned.
+  struct ReceivedChunk {
+    uint64_t end;
+    int64_t read_ns;
+  };
+  // Position in the received stream of the first pending byte, and a ring
+  // of the chunks that still hold pending bytes, oldest first. The ring has a
+  // fixed size so that reading never allocates: when it is full, a new chunk
+  // is merged into the newest one.
+  enum { kReceivedChunks = 64 };
+  uint64_t read_offset_;
+  ReceivedChunk received_chunks_[kReceivedChunks];
+  size_t chunks_head_;
+  size_t chunks_size_;
+
+  // Copy of the buffers given to a vectored write, reused between the writes.
+  std::vector<iovec> write_buffers_;
+
+  // Drain thread of the asynchronous write mode, null when it is disabled.
+  std::unique_ptr<AsyncWriter> async_writer_;
+
+  // Lock of the read functions
+  InstrumentedLock read_lock_;
+  // Lock of the write functions
+  InstrumentedLock write_lock_;
+
+  // Counters of the port, shared with the drain thread of the async writes.
+  SerialStats stats_;
+
+  // Log of the received bytes, null when they are not recorded.
+  SerialRecorder::Ptr recorder_;
+
+  // The error that stopped the recording, if any.
+  std::exception_ptr recorder_error_;
 };
 
 }  // namespace atlas
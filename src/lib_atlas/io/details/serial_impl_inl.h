@@ -35,17 +35,23 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <lib_atlas/exceptions.h>
 #include <paths.h>
+#include <poll.h>
 #include <pthread.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/ioctl.h>
 #include <sys/param.h>
 #include <sys/signal.h>
+#include <sys/uio.h>
 #include <sysexits.h>
 #include <termios.h>
 #include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <sstream>
 
 #if defined(__linux__)
@@ -61,6 +67,7 @@
 #include <mach/mach.h>
 #endif
 
+#include <lib_atlas/io/details/async_writer.h>
 #include <lib_atlas/sys/timer.h>
 
 #ifndef TIOCINQ
@@ -76,8 +83,39 @@
 #include <IOKit/serial/ioss.h>
 #endif
 
+// The architectures that use the generic termios2 of the kernel.
+#if defined(__linux__) &&                                             \
+    (defined(__x86_64__) || defined(__i386__) || defined(__arm__) || \
+     defined(__aarch64__) || defined(__riscv))
+#define ATLAS_HAS_TERMIOS2
+#endif
+
 namespace atlas {
 
+namespace details {
+
+#if defined(ATLAS_HAS_TERMIOS2)
+// The struct termios2 of <asm/termbits.h>, which cannot be included along
+// with <termios.h>.
+struct Termios2 {
+  uint32_t c_iflag;
+  uint32_t c_oflag;
+  uint32_t c_cflag;
+  uint32_t c_lflag;
+  uint8_t c_line;
+  uint8_t c_cc[19];
+  uint32_t c_ispeed;
+  uint32_t c_ospeed;
+};
+
+const unsigned long kTcGets2 = _IOR('T', 0x2A, Termios2);
+const unsigned long kTcSets2 = _IOW('T', 0x2B, Termios2);
+const uint32_t kCBaud = 0010017;
+const uint32_t kBOther = 0010000;
+#endif
+
+}  // namespace details
+
 //==============================================================================
 // C / D T O R S   S E C T I O N
 
@@ -85,9 +123,11 @@ namespace atlas {
 //
 ATLAS_INLINE Serial::SerialImpl::SerialImpl(
     const std::string &port, unsigned long baudrate, bytesize_t bytesize,
-    parity_t parity, stopbits_t stopbits, flowcontrol_t flowcontrol)
+    parity_t parity, stopbits_t stopbits, flowcontrol_t flowcontrol,
+    LockPolicy lock_policy)
     : port_(port),
       fd_(-1),
+      read_fd_(-1),
       is_open_(false),
       xonxoff_(false),
       rtscts_(false),
@@ -95,9 +135,22 @@ ATLAS_INLINE Serial::SerialImpl::SerialImpl(
       parity_(parity),
       bytesize_(bytesize),
       stopbits_(stopbits),
-      flowcontrol_(flowcontrol) {
-  pthread_mutex_init(&read_mutex, NULL);
-  pthread_mutex_init(&write_mutex, NULL);
+      flowcontrol_(flowcontrol),
+      low_latency_(LowLatency::None()),
+      read_buffer_(4096),
+      read_begin_(0),
+      read_end_(0),
+      read_offset_(0),
+      received_chunks_(),
+      chunks_head_(0),
+      chunks_size_(0),
+      write_buffers_(),
+      async_writer_(),
+      read_lock_(lock_policy),
+      write_lock_(lock_policy),
+      stats_(),
+      recorder_(),
+      recorder_error_() {
   if (port_.empty() == false) {
     Open();
   }
@@ -107,8 +160,6 @@ ATLAS_INLINE Serial::SerialImpl::SerialImpl(
 //
 ATLAS_INLINE Serial::SerialImpl::~SerialImpl() {
   Close();
-  pthread_mutex_destroy(&read_mutex);
-  pthread_mutex_destroy(&write_mutex);
 }
 
 //==============================================================================
@@ -141,6 +192,7 @@ ATLAS_INLINE void Serial::SerialImpl::Open() {
   }
 
   ReconfigurePort();
+  ApplyLowLatency();
   is_open_ = true;
 }
 
@@ -380,22 +432,8 @@ ATLAS_INLINE void Serial::SerialImpl::ReconfigurePort() {
         ATLAS_THROW(IOException, errno);
       }
 // Linux Support
-#elif defined(__linux__) && defined(TIOCSSERIAL)
-      struct serial_struct ser;
-
-      if (-1 == ioctl(fd_, TIOCGSERIAL, &ser)) {
-        ATLAS_THROW(IOException, errno);
-      }
-
-      // set custom divisor
-      ser.custom_divisor = ser.baud_base / static_cast<int>(baudrate_);
-      // update flags
-      ser.flags &= ~ASYNC_SPD_MASK;
-      ser.flags |= ASYNC_SPD_CUST;
-
-      if (-1 == ioctl(fd_, TIOCSSERIAL, &ser)) {
-        ATLAS_THROW(IOException, errno);
-      }
+#elif defined(__linux__)
+// The baudrate is set once the other settings are active, see below.
 #else
       throw invalid_argument("OS does not currently support custom bauds");
 #endif
@@ -503,10 +541,23 @@ ATLAS_INLINE void Serial::SerialImpl::ReconfigurePort() {
   // to read before each call, so we should never needlessly poll
   options.c_cc[VMIN] = 0;
   options.c_cc[VTIME] = 0;
+  // In the low latency mode, a blocking read returns as soon as a byte is
+  // received or after VTIME, which replaces the select for the waits of at
+  // least VTIME -- see WaitBlockingRead(). The non blocking descriptor
+  // ignores these settings.
+  if (low_latency_.blocking_reads) {
+    options.c_cc[VTIME] = ReadTimeoutDeciseconds();
+  }
 
   // activate settings
   ::tcsetattr(fd_, TCSANOW, &options);
 
+#if defined(__linux__)
+  if (custom_baud) {
+    SetCustomBaudrate();
+  }
+#endif
+
   // Update byte_time_ based on the new settings.
   uint32_t bit_time_ns = 1e9 / baudrate_;
   byte_time_ns_ = bit_time_ns * (1 + bytesize_ + parity_ + stopbits_);
@@ -518,15 +569,124 @@ ATLAS_INLINE void Serial::SerialImpl::ReconfigurePort() {
   }
 }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SerialImpl::ApplyLowLatency() {
+#if defined(__linux__) && defined(TIOCSSERIAL)
+  if (low_latency_.kernel_flag) {
+    struct serial_struct ser;
+    // Only the drivers of real serial ports support TIOCGSERIAL.
+    if (ioctl(fd_, TIOCGSERIAL, &ser) == 0 &&
+        (ser.flags & ASYNC_LOW_LATENCY) == 0) {
+      ser.flags |= ASYNC_LOW_LATENCY;
+      if (-1 == ioctl(fd_, TIOCSSERIAL, &ser)) {
+        ATLAS_THROW(IOException, errno);
+      }
+    }
+  }
+#endif
+  if (low_latency_.blocking_reads && read_fd_ == -1) {
+    read_fd_ = ::open(port_.c_str(), O_RDONLY | O_NOCTTY);
+    if (read_fd_ == -1) {
+      ATLAS_THROW(IOException, errno);
+    }
+  } else if (!low_latency_.blocking_reads && read_fd_ != -1) {
+    ::close(read_fd_);
+    read_fd_ = -1;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SerialImpl::SetCustomBaudrate() {
+#if defined(ATLAS_HAS_TERMIOS2)
+  // BOTHER lets the driver compute the divisor of any integer baudrate,
+  // which the USB adapters support unlike the custom divisor below.
+  details::Termios2 options;
+  if (ioctl(fd_, details::kTcGets2, &options) == 0) {
+    options.c_cflag &= ~details::kCBaud;
+    options.c_cflag |= details::kBOther;
+    options.c_ispeed = static_cast<uint32_t>(baudrate_);
+    options.c_ospeed = static_cast<uint32_t>(baudrate_);
+    if (-1 == ioctl(fd_, details::kTcSets2, &options)) {
+      ATLAS_THROW(IOException, errno);
+    }
+    return;
+  }
+#endif
+#if defined(__linux__) && defined(TIOCSSERIAL)
+  struct serial_struct ser;
+
+  if (-1 == ioctl(fd_, TIOCGSERIAL, &ser)) {
+    ATLAS_THROW(IOException, errno);
+  }
+
+  // set custom divisor
+  ser.custom_divisor = ser.baud_base / static_cast<int>(baudrate_);
+  // update flags
+  ser.flags &= ~ASYNC_SPD_MASK;
+  ser.flags |= ASYNC_SPD_CUST;
+
+  if (-1 == ioctl(fd_, TIOCSSERIAL, &ser)) {
+    ATLAS_THROW(IOException, errno);
+  }
+#else
+  throw std::invalid_argument("OS does not currently support custom bauds");
+#endif
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint8_t Serial::SerialImpl::ReadTimeoutDeciseconds() const {
+  uint32_t timeout_ms =
+      std::min(timeout_.read_timeout_constant, timeout_.inter_byte_timeout);
+  return static_cast<uint8_t>(std::min<uint32_t>(timeout_ms / 100, 255));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::SerialImpl::WaitBlockingRead(uint32_t timeout) {
+  // A timeout under VTIME, including any timeout when VTIME is 0 and the
+  // ::read would not wait at all, is waited for with poll.
+  uint32_t vtime_ms = static_cast<uint32_t>(ReadTimeoutDeciseconds()) * 100;
+  if (vtime_ms != 0 && timeout >= vtime_ms) {
+    return true;
+  }
+  pollfd descriptor = {read_fd_, POLLIN, 0};
+  stats_.AddSyscall();
+  int r = ::poll(&descriptor, 1, static_cast<int>(timeout));
+  if (r < 0) {
+    // The caller checks its timeout and waits again.
+    if (errno == EINTR) {
+      stats_.AddEintrRetry();
+      return false;
+    }
+    ATLAS_THROW(IOException, errno);
+  }
+  if (r > 0 && (descriptor.revents & POLLIN) == 0) {
+    throw SerialException(
+        "device reports a hang up or an error (device disconnected?)");
+  }
+  return r > 0;
+}
+
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE void Serial::SerialImpl::Close() {
+  // The drain thread must not write on a closed descriptor.
+  async_writer_.reset();
   if (is_open_ == true) {
+    if (read_fd_ != -1) {
+      ::close(read_fd_);
+      read_fd_ = -1;
+    }
     if (fd_ != -1) {
       int ret;
       ret = ::close(fd_);
       if (ret == 0) {
         fd_ = -1;
+        SkipReadBuffer(read_end_ - read_begin_);
+        read_begin_ = read_end_ = 0;
       } else {
         ATLAS_THROW(IOException, errno);
       }
@@ -549,7 +709,7 @@ ATLAS_INLINE size_t Serial::SerialImpl::Available() {
   if (-1 == ioctl(fd_, TIOCINQ, &count)) {
     ATLAS_THROW(IOException, errno);
   } else {
-    return static_cast<size_t>(count);
+    return static_cast<size_t>(count) + (read_end_ - read_begin_);
   }
 }
 
@@ -561,11 +721,13 @@ ATLAS_INLINE bool Serial::SerialImpl::WaitReadable(uint32_t timeout) {
   FD_ZERO(&readfds);
   FD_SET(fd_, &readfds);
   timespec timeout_ts(MilliTimer::TimeSpecFromMs(timeout));
+  stats_.AddSyscall();
   int r = pselect(fd_ + 1, &readfds, NULL, NULL, &timeout_ts, NULL);
 
   if (r < 0) {
     // Select was interrupted
     if (errno == EINTR) {
+      stats_.AddEintrRetry();
       return false;
     }
     // Otherwise there was some error
@@ -585,6 +747,36 @@ ATLAS_INLINE bool Serial::SerialImpl::WaitReadable(uint32_t timeout) {
   return true;
 }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::SerialImpl::WaitWritable(uint32_t timeout) {
+  fd_set writefds;
+  FD_ZERO(&writefds);
+  FD_SET(fd_, &writefds);
+  timespec timeout_ts(MilliTimer::TimeSpecFromMs(timeout));
+  stats_.AddSyscall();
+  int r = pselect(fd_ + 1, NULL, &writefds, NULL, &timeout_ts, NULL);
+
+  if (r < 0) {
+    // Select was interrupted, the caller checks its timeout and tries again
+    if (errno == EINTR) {
+      stats_.AddEintrRetry();
+      return true;
+    }
+    ATLAS_THROW(IOException, errno);
+  }
+  // Timeout occurred
+  if (r == 0) {
+    return false;
+  }
+  if (!FD_ISSET(fd_, &writefds)) {
+    ATLAS_THROW(IOException,
+                "select reports ready to write, but our fd isn't"
+                " in the list, this shouldn't happen!");
+  }
+  return true;
+}
+
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE void Serial::SerialImpl::WaitByteTimes(size_t count) {
@@ -594,12 +786,23 @@ ATLAS_INLINE void Serial::SerialImpl::WaitByteTimes(size_t count) {
 
 //------------------------------------------------------------------------------
 //
-ATLAS_INLINE size_t Serial::SerialImpl::Read(uint8_t *buf, size_t size) {
+ATLAS_INLINE size_t Serial::SerialImpl::Read(uint8_t *buf, size_t size,
+                                             int64_t *receive_ns) {
   // If the port is not open, throw
   if (!is_open_) {
     throw PortNotOpenedException("Serial::read");
   }
-  size_t bytes_read = 0;
+  SerialStats::LatencyScope latency(
+      stats_, SerialStats::LatencyScope::Operation::kRead);
+  // Serve what a previous ReadLine left in the read buffer first.
+  if (receive_ns != nullptr && read_end_ != read_begin_) {
+    *receive_ns = PendingReceiveTime();
+    receive_ns = nullptr;
+  }
+  size_t bytes_read = ConsumeReadBuffer(buf, size);
+  if (bytes_read == size) {
+    return bytes_read;
+  }
 
   // Calculate total timeout in milliseconds t_c + (t_m * N)
   long total_timeout_ms = timeout_.read_timeout_constant;
@@ -609,9 +812,15 @@ ATLAS_INLINE size_t Serial::SerialImpl::Read(uint8_t *buf, size_t size) {
 
   // Pre-fill buffer with available bytes
   {
-    ssize_t bytes_read_now = ::read(fd_, buf, size);
+    ssize_t bytes_read_now = ReadDevice(read_fd_ != -1 ? read_fd_ : fd_,
+                                        buf + bytes_read, size - bytes_read);
     if (bytes_read_now > 0) {
-      bytes_read = bytes_read_now;
+      if (receive_ns != nullptr) {
+        *receive_ns = ReceiveTime(NanoTimer::Now(),
+                                  static_cast<size_t>(bytes_read_now - 1));
+        receive_ns = nullptr;
+      }
+      bytes_read += static_cast<size_t>(bytes_read_now);
     }
   }
 
@@ -621,6 +830,26 @@ ATLAS_INLINE size_t Serial::SerialImpl::Read(uint8_t *buf, size_t size) {
       // Timed out
       break;
     }
+    if (read_fd_ != -1) {
+      uint32_t timeout = std::min(static_cast<uint32_t>(timeout_remaining_ms),
+                                  timeout_.inter_byte_timeout);
+      if (!WaitBlockingRead(timeout)) {
+        continue;
+      }
+      // The ::read waits for the data itself, for up to VTIME.
+      ssize_t bytes_read_now =
+          ReadDevice(read_fd_, buf + bytes_read, size - bytes_read);
+      if (bytes_read_now < 0) {
+        ATLAS_THROW(IOException, errno);
+      }
+      if (bytes_read_now > 0 && receive_ns != nullptr) {
+        *receive_ns = ReceiveTime(NanoTimer::Now(),
+                                  static_cast<size_t>(bytes_read_now - 1));
+        receive_ns = nullptr;
+      }
+      bytes_read += static_cast<size_t>(bytes_read_now);
+      continue;
+    }
     // Timeout for the next select is whichever is less of the remaining
     // total read timeout and the inter-byte timeout.
     uint32_t timeout = std::min(static_cast<uint32_t>(timeout_remaining_ms),
@@ -638,7 +867,8 @@ ATLAS_INLINE size_t Serial::SerialImpl::Read(uint8_t *buf, size_t size) {
       }
       // This should be non-blocking returning only what is available now
       //  Then returning so that select can block again.
-      ssize_t bytes_read_now = ::read(fd_, buf + bytes_read, size - bytes_read);
+      ssize_t bytes_read_now =
+          ReadDevice(fd_, buf + bytes_read, size - bytes_read);
       // read should always return some data as select reported it was
       // ready to read when we get to this point.
       if (bytes_read_now < 1) {
@@ -649,6 +879,11 @@ ATLAS_INLINE size_t Serial::SerialImpl::Read(uint8_t *buf, size_t size) {
             "device reports readiness to read but "
             "returned no data (device disconnected?)");
       }
+      if (receive_ns != nullptr) {
+        *receive_ns = ReceiveTime(NanoTimer::Now(),
+                                  static_cast<size_t>(bytes_read_now - 1));
+        receive_ns = nullptr;
+      }
       // Update bytes_read
       bytes_read += static_cast<size_t>(bytes_read_now);
       // If bytes_read == size then we have read everything we need
@@ -668,98 +903,523 @@ ATLAS_INLINE size_t Serial::SerialImpl::Read(uint8_t *buf, size_t size) {
       }
     }
   }
+  if (bytes_read < size) {
+    stats_.AddReadTimeout();
+  }
   return bytes_read;
 }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::SerialImpl::ReadLine(std::string &buffer,
+                                                 size_t size,
+                                                 const std::string &eol,
+                                                 int64_t *receive_ns) {
+  if (!is_open_) {
+    throw PortNotOpenedException("Serial::readline");
+  }
+  if (size == 0) {
+    return 0;
+  }
+  SerialStats::LatencyScope latency(
+      stats_, SerialStats::LatencyScope::Operation::kRead);
+  size_t searched = 0;
+  while (true) {
+    size_t pending = std::min(read_end_ - read_begin_, size);
+    size_t line_length = FindEol(pending, searched, eol);
+    if (line_length == 0 && pending == size) {
+      // Reached the maximum read length
+      line_length = size;
+    }
+    if (line_length != 0) {
+      if (receive_ns != nullptr) {
+        *receive_ns = PendingReceiveTime();
+      }
+      return ConsumeReadBuffer(buffer, line_length);
+    }
+    // Only the tail that could hold the beginning of eol must be searched
+    // again once more data has been received.
+    searched = pending >= eol.length() ? pending - eol.length() + 1 : 0;
+    // The line functions historically read one byte at a time, so a missing
+    // byte times out like a single byte read would.
+    if (!FillReadBuffer(size, timeout_.read_timeout_constant +
+                                  timeout_.read_timeout_multiplier)) {
+      // Timeout occured, return the partial line
+      stats_.AddReadTimeout();
+      if (receive_ns != nullptr && pending != 0) {
+        *receive_ns = PendingReceiveTime();
+      }
+      return ConsumeReadBuffer(buffer, pending);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::SerialImpl::TryReadLine(std::string &buffer,
+                                                    size_t size,
+                                                    const std::string &eol) {
+  if (!is_open_) {
+    throw PortNotOpenedException("Serial::tryReadLine");
+  }
+  if (size == 0) {
+    return 0;
+  }
+  // Only drain the device when the pending bytes do not hold a line, so
+  // consecutive calls on a full buffer do not issue a syscall each.
+  size_t pending = std::min(read_end_ - read_begin_, size);
+  size_t line_length = FindEol(pending, 0, eol);
+  if (line_length == 0 && pending < size) {
+    size_t searched = pending >= eol.length() ? pending - eol.length() + 1 : 0;
+    if (ReserveReadBuffer(size) != 0) {
+      ReadIntoBuffer(fd_);
+    }
+    pending = std::min(read_end_ - read_begin_, size);
+    line_length = FindEol(pending, searched, eol);
+  }
+  if (line_length == 0 && pending == size) {
+    // Reached the maximum read length
+    line_length = size;
+  }
+  return ConsumeReadBuffer(buffer, line_length);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::SerialImpl::ReadFrame(Framer &framer,
+                                                FrameView &frame,
+                                                int64_t *receive_ns) {
+  if (!is_open_) {
+    throw PortNotOpenedException("Serial::readFrame");
+  }
+  SerialStats::LatencyScope latency(
+      stats_, SerialStats::LatencyScope::Operation::kRead);
+  MilliTimer total_timeout(timeout_.read_timeout_constant);
+  while (!ExtractFrame(framer, frame, receive_ns)) {
+    int64_t timeout_remaining_ms = total_timeout.Remaining();
+    if (timeout_remaining_ms <= 0 ||
+        !FillReadBuffer(framer.MaxFrameSize(),
+                        static_cast<uint32_t>(timeout_remaining_ms))) {
+      stats_.AddReadTimeout();
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::SerialImpl::TryReadFrame(Framer &framer,
+                                                   FrameView &frame) {
+  if (!is_open_) {
+    throw PortNotOpenedException("Serial::tryReadFrame");
+  }
+  if (ExtractFrame(framer, frame)) {
+    return true;
+  }
+  return ReserveReadBuffer(framer.MaxFrameSize()) != 0 &&
+         ReadIntoBuffer(fd_) > 0 && ExtractFrame(framer, frame);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::SerialImpl::ExtractFrame(Framer &framer,
+                                                   FrameView &frame,
+                                                   int64_t *receive_ns) {
+  while (read_end_ != read_begin_) {
+    size_t pending = read_end_ - read_begin_;
+    frame = FrameView();
+    size_t consumed =
+        framer.Extract(&read_buffer_[read_begin_], pending, frame);
+    if (consumed == 0) {
+      if (pending >= framer.MaxFrameSize()) {
+        // The framer cannot make progress with a full frame of data.
+        SkipReadBuffer(pending);
+      }
+      return false;
+    }
+    // The framers skip the garbage before a frame in separate calls, so the
+    // frame starts at the first byte given to the call that returned it.
+    if (receive_ns != nullptr && frame.data != nullptr) {
+      *receive_ns = PendingReceiveTime();
+    }
+    SkipReadBuffer(std::min(consumed, pending));
+    if (frame.data != nullptr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::vector<std::string> Serial::SerialImpl::ReadLines(
+    size_t size, const std::string &eol) {
+  std::vector<std::string> lines;
+  size_t read_so_far = 0;
+  while (read_so_far < size) {
+    std::string line;
+    size_t bytes_read = ReadLine(line, size - read_so_far, eol);
+    if (bytes_read == 0) {
+      break;  // Timeout occured without any data
+    }
+    read_so_far += bytes_read;
+    bool eol_found = line.length() >= eol.length() &&
+                     line.compare(line.length() - eol.length(), eol.length(),
+                                  eol) == 0;
+    lines.push_back(std::move(line));
+    if (!eol_found && read_so_far < size) {
+      break;  // Timeout occured in the middle of a line
+    }
+  }
+  return lines;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::SerialImpl::FillReadBuffer(size_t capacity,
+                                                     uint32_t timeout_ms) {
+  if (ReserveReadBuffer(capacity) == 0) {
+    return true;
+  }
+
+  MilliTimer total_timeout(timeout_ms);
+
+  // The blocking descriptor may wait for up to VTIME, which must fit in the
+  // timeout.
+  bool blocking = read_fd_ != -1 &&
+                  timeout_ms >= ReadTimeoutDeciseconds() * uint32_t(100);
+  ssize_t bytes_read_now = ReadIntoBuffer(blocking ? read_fd_ : fd_);
+  while (bytes_read_now < 1) {
+    int64_t timeout_remaining_ms = total_timeout.Remaining();
+    if (timeout_remaining_ms <= 0) {
+      // Timed out
+      return false;
+    }
+    if (read_fd_ != -1) {
+      uint32_t timeout = std::min(static_cast<uint32_t>(timeout_remaining_ms),
+                                  timeout_.inter_byte_timeout);
+      if (!WaitBlockingRead(timeout)) {
+        continue;
+      }
+      // The ::read waits for the data itself, for up to VTIME.
+      bytes_read_now = ReadIntoBuffer(read_fd_);
+      if (bytes_read_now < 0) {
+        ATLAS_THROW(IOException, errno);
+      }
+      continue;
+    }
+    uint32_t timeout = std::min(static_cast<uint32_t>(timeout_remaining_ms),
+                                timeout_.inter_byte_timeout);
+    if (!WaitReadable(timeout)) {
+      continue;
+    }
+    bytes_read_now = ReadIntoBuffer(fd_);
+    if (bytes_read_now < 1) {
+      // Disconnected devices, at least on Linux, show the
+      // behavior that they are always ready to read immediately
+      // but reading returns nothing.
+      throw SerialException(
+          "device reports readiness to read but "
+          "returned no data (device disconnected?)");
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::SerialImpl::ReserveReadBuffer(size_t capacity) {
+  // Keep the pending bytes at the front of the buffer so the free space is
+  // contiguous and a single ::read can drain the device.
+  if (read_begin_ != 0) {
+    std::memmove(&read_buffer_[0], &read_buffer_[read_begin_],
+                 read_end_ - read_begin_);
+    read_end_ -= read_begin_;
+    read_begin_ = 0;
+  }
+  if (read_buffer_.size() < capacity) {
+    read_buffer_.resize(capacity);
+  }
+  return read_buffer_.size() - read_end_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ssize_t Serial::SerialImpl::ReadIntoBuffer(int fd) {
+  ssize_t bytes_read_now = ReadDevice(fd, &read_buffer_[read_end_],
+                                      read_buffer_.size() - read_end_);
+  if (bytes_read_now > 0) {
+    read_end_ += static_cast<size_t>(bytes_read_now);
+    ReceivedChunk chunk = {read_offset_ + (read_end_ - read_begin_),
+                           NanoTimer::Now()};
+    // Merged into the newest chunk, the bytes of both are timestamped as if
+    // they had been received back to back before this read returned.
+    if (chunks_size_ == kReceivedChunks) {
+      --chunks_size_;
+    }
+    received_chunks_[(chunks_head_ + chunks_size_) % kReceivedChunks] = chunk;
+    ++chunks_size_;
+  }
+  return bytes_read_now;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ssize_t Serial::SerialImpl::ReadDevice(int fd, uint8_t *buf,
+                                                    size_t size) {
+  while (true) {
+    stats_.AddSyscall();
+    ssize_t bytes_read_now = ::read(fd, buf, size);
+    if (bytes_read_now < 0 && errno == EINTR) {
+      stats_.AddEintrRetry();
+      continue;
+    }
+    if (bytes_read_now > 0) {
+      stats_.AddBytesRead(static_cast<size_t>(bytes_read_now));
+      if (recorder_) {
+        // The bytes are read already: a failing log stops the recording,
+        // not the read.
+        try {
+          recorder_->Record(NanoTimer::Now(), buf,
+                            static_cast<size_t>(bytes_read_now));
+        } catch (const std::exception &) {
+          recorder_error_ = std::current_exception();
+          recorder_.reset();
+        }
+      }
+    }
+    return bytes_read_now;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::SerialImpl::ConsumeReadBuffer(uint8_t *buf,
+                                                          size_t size) {
+  size_t count = std::min(size, read_end_ - read_begin_);
+  if (count != 0) {
+    std::memcpy(buf, &read_buffer_[read_begin_], count);
+    SkipReadBuffer(count);
+  }
+  return count;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::SerialImpl::ConsumeReadBuffer(std::string &buffer,
+                                                          size_t size) {
+  if (size != 0) {
+    buffer.append(reinterpret_cast<const char *>(&read_buffer_[read_begin_]),
+                  size);
+    SkipReadBuffer(size);
+  }
+  return size;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SerialImpl::SkipReadBuffer(size_t count) {
+  read_begin_ += count;
+  read_offset_ += count;
+  while (chunks_size_ != 0 &&
+         received_chunks_[chunks_head_].end <= read_offset_) {
+    chunks_head_ = (chunks_head_ + 1) % kReceivedChunks;
+    --chunks_size_;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t Serial::SerialImpl::ReceiveTime(int64_t read_ns,
+                                                     size_t bytes_after) const {
+  return read_ns - static_cast<int64_t>(byte_time_ns_) *
+                       static_cast<int64_t>(bytes_after + 1);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t Serial::SerialImpl::PendingReceiveTime() const {
+  // SkipReadBuffer drops the chunks that were fully consumed, so the first
+  // one holds the first pending byte.
+  const ReceivedChunk &chunk = received_chunks_[chunks_head_];
+  return ReceiveTime(chunk.read_ns,
+                     static_cast<size_t>(chunk.end - read_offset_ - 1));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::SerialImpl::FindEol(size_t size, size_t offset,
+                                                const std::string &eol) const {
+  if (eol.empty()) {
+    return size != 0 ? 1 : 0;
+  }
+  if (offset >= size) {
+    return 0;
+  }
+  const uint8_t *begin = &read_buffer_[read_begin_];
+  const void *match = nullptr;
+  if (eol.length() == 1) {
+    match = memchr(begin + offset, eol[0], size - offset);
+  } else {
+    match = memmem(begin + offset, size - offset, eol.data(), eol.length());
+  }
+  if (match == nullptr) {
+    return 0;
+  }
+  return static_cast<const uint8_t *>(match) - begin + eol.length();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int Serial::SerialImpl::GetFileDescriptor() const { return fd_; }
+
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE size_t Serial::SerialImpl::Write(const uint8_t *data,
                                               size_t length) {
+  iovec buffer = {const_cast<uint8_t *>(data), length};
+  return Write(&buffer, 1);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::SerialImpl::Write(const iovec *buffers,
+                                              size_t count) {
   if (is_open_ == false) {
     throw PortNotOpenedException("Serial::write");
   }
-  fd_set writefds;
-  size_t bytes_written = 0;
+  SerialStats::LatencyScope latency(
+      stats_, SerialStats::LatencyScope::Operation::kWrite);
+  if (async_writer_) {
+    return async_writer_->Push(buffers, count);
+  }
+  return SyncWrite(buffers, count, timeout_, write_buffers_);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::SerialImpl::SyncWrite(
+    const iovec *buffers, size_t count, const Timeout &timeout,
+    std::vector<iovec> &buffers_copy) {
+  // The buffers are copied so the partially written ones can be advanced.
+  buffers_copy.assign(buffers, buffers + count);
+  size_t length = 0;
+  for (size_t i = 0; i < count; ++i) {
+    length += buffers[i].iov_len;
+  }
 
   // Calculate total timeout in milliseconds t_c + (t_m * N)
-  long total_timeout_ms = timeout_.write_timeout_constant;
+  long total_timeout_ms = timeout.write_timeout_constant;
   total_timeout_ms +=
-      timeout_.write_timeout_multiplier * static_cast<long>(length);
+      timeout.write_timeout_multiplier * static_cast<long>(length);
   MilliTimer total_timeout(total_timeout_ms);
 
+  size_t bytes_written = 0;
+  size_t first = 0;
   while (bytes_written < length) {
-    int64_t timeout_remaining_ms = total_timeout.Remaining();
-    if (timeout_remaining_ms <= 0) {
-      // Timed out
-      break;
+    while (buffers_copy[first].iov_len == 0) {
+      ++first;
     }
-    timespec timeout(MilliTimer::TimeSpecFromMs(timeout_remaining_ms));
-
-    FD_ZERO(&writefds);
-    FD_SET(fd_, &writefds);
-
-    // Do the select
-    int r = pselect(fd_ + 1, NULL, &writefds, NULL, &timeout, NULL);
-
-    // Figure out what happened by looking at select's response 'r'
-    /** Error **/
-    if (r < 0) {
-      // Select was interrupted, try again
-      if (errno == EINTR) {
-        continue;
+    int iov_count =
+        static_cast<int>(std::min<size_t>(count - first, IOV_MAX));
+    // The port is non blocking, so the device is only waited for once its
+    // output queue is full.
+    stats_.AddSyscall();
+    ssize_t bytes_written_now =
+        ::writev(fd_, &buffers_copy[first], iov_count);
+    if (bytes_written_now > 0) {
+      stats_.AddBytesWritten(static_cast<size_t>(bytes_written_now));
+      bytes_written += static_cast<size_t>(bytes_written_now);
+      size_t advance = static_cast<size_t>(bytes_written_now);
+      while (advance != 0) {
+        iovec &buffer = buffers_copy[first];
+        size_t skipped = std::min(advance, buffer.iov_len);
+        buffer.iov_base = static_cast<uint8_t *>(buffer.iov_base) + skipped;
+        buffer.iov_len -= skipped;
+        advance -= skipped;
+        if (buffer.iov_len == 0) {
+          ++first;
+        }
       }
-      // Otherwise there was some error
+      continue;
+    }
+    if (bytes_written_now == 0) {
+      // Disconnected devices, at least on Linux, show the
+      // behavior that they are always ready to write immediately
+      // but writing returns nothing.
+      throw SerialException(
+          "device reports readiness to write but "
+          "returned no data (device disconnected?)");
+    }
+    if (errno == EINTR) {
+      stats_.AddEintrRetry();
+      continue;
+    }
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
       ATLAS_THROW(IOException, errno);
     }
-    /** Timeout **/
-    if (r == 0) {
+    int64_t timeout_remaining_ms = total_timeout.Remaining();
+    if (timeout_remaining_ms <= 0 ||
+        !WaitWritable(static_cast<uint32_t>(timeout_remaining_ms))) {
+      // Timed out
+      stats_.AddWriteTimeout();
       break;
     }
-    /** Port ready to write **/
-    if (r > 0) {
-      // Make sure our file descriptor is in the ready to write list
-      if (FD_ISSET(fd_, &writefds)) {
-        // This will write some
-        ssize_t bytes_written_now =
-            ::write(fd_, data + bytes_written, length - bytes_written);
-        // write should always return some data as select reported it was
-        // ready to write when we get to this point.
-        if (bytes_written_now < 1) {
-          // Disconnected devices, at least on Linux, show the
-          // behavior that they are always ready to write immediately
-          // but writing returns nothing.
-          throw SerialException(
-              "device reports readiness to write but "
-              "returned no data (device disconnected?)");
-        }
-        // Update bytes_written
-        bytes_written += static_cast<size_t>(bytes_written_now);
-        // If bytes_written == size then we have written everything we need to
-        if (bytes_written == length) {
-          break;
-        }
-        // If bytes_written < size then we have more to write
-        if (bytes_written < length) {
-          continue;
-        }
-        // If bytes_written > size then we have over written, which shouldn't
-        // happen
-        if (bytes_written > length) {
-          throw SerialException(
-              "write over wrote, too many bytes where "
-              "written, this shouldn't happen, might be "
-              "a logical error!");
-        }
-      }
-      // This shouldn't happen, if r > 0 our fd has to be in the list!
-      ATLAS_THROW(IOException,
-                  "select reports ready to write, but our fd isn't"
-                  " in the list, this shouldn't happen!");
-    }
   }
   return bytes_written;
 }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SerialImpl::EnableAsyncWrite(
+    size_t capacity, AsyncWritePolicy policy) {
+  if (is_open_ == false) {
+    throw PortNotOpenedException("Serial::enableAsyncWrite");
+  }
+  DisableAsyncWrite();
+  async_writer_.reset(new AsyncWriter(*this, capacity, policy, timeout_));
+  async_writer_->Start();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SerialImpl::DisableAsyncWrite() {
+  if (!async_writer_) {
+    return;
+  }
+  // Give the queued bytes the time a synchronous write would have had.
+  std::future<void> flushed = async_writer_->Flush();
+  long queued = static_cast<long>(async_writer_->GetStats().queued_bytes);
+  long timeout_ms = timeout_.write_timeout_constant +
+                    timeout_.write_timeout_multiplier * queued;
+  flushed.wait_for(std::chrono::milliseconds(timeout_ms));
+  async_writer_.reset();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::SerialImpl::IsAsyncWriteEnabled() const {
+  return async_writer_ != nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::future<void> Serial::SerialImpl::FlushAsync() {
+  if (async_writer_) {
+    return async_writer_->Flush();
+  }
+  std::promise<void> flushed;
+  flushed.set_value();
+  return flushed.get_future();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE AsyncWriteStats Serial::SerialImpl::GetAsyncWriteStats() const {
+  return async_writer_ ? async_writer_->GetStats() : AsyncWriteStats();
+}
+
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE void Serial::SerialImpl::SetPort(const std::string &port) {
@@ -774,6 +1434,13 @@ ATLAS_INLINE std::string Serial::SerialImpl::GetPort() const { return port_; }
 //
 ATLAS_INLINE void Serial::SerialImpl::SetTimeout(const Timeout &timeout) {
   timeout_ = timeout;
+  if (async_writer_) {
+    async_writer_->SetTimeout(timeout);
+  }
+  // VTIME follows the read timeout.
+  if (is_open_ && low_latency_.blocking_reads) {
+    ReconfigurePort();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -859,6 +1526,8 @@ ATLAS_INLINE void Serial::SerialImpl::FlushInput() {
   if (is_open_ == false) {
     throw PortNotOpenedException("Serial::flushInput");
   }
+  SkipReadBuffer(read_end_ - read_begin_);
+  read_begin_ = read_end_ = 0;
   tcflush(fd_, TCIFLUSH);
 }
 
@@ -1070,38 +1739,90 @@ ATLAS_INLINE bool Serial::SerialImpl::GetCD() {
 
 //------------------------------------------------------------------------------
 //
-ATLAS_INLINE void Serial::SerialImpl::ReadLock() {
-  int result = pthread_mutex_lock(&read_mutex);
-  if (result) {
-    ATLAS_THROW(IOException, result);
+ATLAS_INLINE void Serial::SerialImpl::ReadLock() { read_lock_.Lock(); }
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SerialImpl::ReadUnlock() { read_lock_.Unlock(); }
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SerialImpl::WriteLock() { write_lock_.Lock(); }
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SerialImpl::WriteUnlock() { write_lock_.Unlock(); }
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SerialImpl::SetLowLatency(
+    const LowLatency &low_latency) {
+  low_latency_ = low_latency;
+  if (is_open_) {
+    ReconfigurePort();
+    ApplyLowLatency();
   }
 }
 
 //------------------------------------------------------------------------------
 //
-ATLAS_INLINE void Serial::SerialImpl::ReadUnlock() {
-  int result = pthread_mutex_unlock(&read_mutex);
-  if (result) {
-    ATLAS_THROW(IOException, result);
-  }
+ATLAS_INLINE LowLatency Serial::SerialImpl::GetLowLatency() const {
+  return low_latency_;
 }
 
 //------------------------------------------------------------------------------
 //
-ATLAS_INLINE void Serial::SerialImpl::WriteLock() {
-  int result = pthread_mutex_lock(&write_mutex);
-  if (result) {
-    ATLAS_THROW(IOException, result);
-  }
+ATLAS_INLINE void Serial::SerialImpl::SetRecorder(
+    SerialRecorder::Ptr recorder) {
+  recorder_ = std::move(recorder);
+  recorder_error_ = nullptr;
 }
 
 //------------------------------------------------------------------------------
 //
-ATLAS_INLINE void Serial::SerialImpl::WriteUnlock() {
-  int result = pthread_mutex_unlock(&write_mutex);
-  if (result) {
-    ATLAS_THROW(IOException, result);
-  }
+ATLAS_INLINE std::exception_ptr Serial::SerialImpl::GetRecorderError() const {
+  return recorder_error_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LockStats Serial::SerialImpl::GetReadLockStats() const {
+  return read_lock_.GetStats();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LockStats Serial::SerialImpl::GetWriteLockStats() const {
+  return write_lock_.GetStats();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SerialImpl::ResetLockStats() {
+  read_lock_.ResetStats();
+  write_lock_.ResetStats();
 }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SerialImpl::EnableStats(bool enable) {
+  stats_.SetEnabled(enable);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::SerialImpl::IsStatsEnabled() const {
+  return stats_.IsEnabled();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialStatsSnapshot Serial::SerialImpl::GetStats() const {
+  return stats_.Snapshot();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SerialImpl::ResetStats() { stats_.Reset(); }
+
 }  // namespace atlas
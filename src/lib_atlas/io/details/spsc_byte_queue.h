@@ -0,0 +1,141 @@
+/**
+ * \file	spsc_byte_queue.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_DETAILS_SPSC_BYTE_QUEUE_H_
+#define LIB_ATLAS_IO_DETAILS_SPSC_BYTE_QUEUE_H_
+
+#include <lib_atlas/macros.h>
+#include <stdint.h>
+#include <sys/uio.h>
+#include <atomic>
+#include <vector>
+
+namespace atlas {
+
+namespace details {
+
+/**
+ * A bounded lock-free byte queue for one producer and one consumer thread.
+ *
+ * The read and write positions grow monotonically and the storage is a power
+ * of two, so the amount of queued bytes is always tail - head.
+ *
+ * Only the consumer moves the read position and only the producer moves the
+ * write position. When the queue is full, the producer either gives up
+ * (TryPush) or queues the bytes that fit (PushPartial); the queued bytes are
+ * never discarded, since the consumer may be copying them out.
+ */
+class SpscByteQueue {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param capacity The minimum number of bytes the queue can hold. It is
+   *        rounded up to the next power of two.
+   */
+  explicit SpscByteQueue(size_t capacity);
+
+  SpscByteQueue(const SpscByteQueue &) = delete;
+
+  SpscByteQueue &operator=(const SpscByteQueue &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Queue all the bytes of the buffers, or none if they do not fit.
+   * Producer only.
+   *
+   * \return False if the queue has not enough free space.
+   */
+  bool TryPush(const iovec *buffers, size_t count);
+
+  /**
+   * Queue the first bytes of the buffers, as many as there is free space for.
+   * Producer only.
+   *
+   * \return The number of bytes that were queued.
+   */
+  size_t PushPartial(const iovec *buffers, size_t count);
+
+  /**
+   * Move up to size bytes out of the queue. Consumer only.
+   *
+   * \return The number of bytes copied in data.
+   */
+  size_t Pop(uint8_t *data, size_t size);
+
+  size_t Capacity() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of bytes queued. It is only a snapshot when called
+   *         while the other thread is using the queue.
+   */
+  size_t Size() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The total number of bytes that were consumed.
+   */
+  size_t ReadPosition() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The total number of bytes that were queued.
+   */
+  size_t WritePosition() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Copy the first length bytes of the buffers at the given write position.
+   */
+  void CopyIn(size_t position, const iovec *buffers, size_t count,
+              size_t length) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::vector<uint8_t> buffer_;
+
+  size_t mask_;
+
+  std::atomic<size_t> head_;
+
+  // Keeps the positions on different cache lines so the producer and the
+  // consumer do not invalidate each other's line on every operation.
+  char padding_[64];
+
+  std::atomic<size_t> tail_;
+};
+
+}  // namespace details
+
+}  // namespace atlas
+
+#include <lib_atlas/io/details/spsc_byte_queue_inl.h>
+
+#endif  // LIB_ATLAS_IO_DETAILS_SPSC_BYTE_QUEUE_H_
@@ -0,0 +1,155 @@
+/**
+ * \file	spsc_byte_queue_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_DETAILS_SPSC_BYTE_QUEUE_H_
+#error This file may only be included from spsc_byte_queue.h
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace atlas {
+
+namespace details {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SpscByteQueue::SpscByteQueue(size_t capacity)
+    : buffer_(), mask_(0), head_(0), padding_(), tail_(0) {
+  if (capacity == 0) {
+    throw std::invalid_argument("The capacity of the queue cannot be 0.");
+  }
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  buffer_.resize(size);
+  mask_ = size - 1;
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool SpscByteQueue::TryPush(const iovec *buffers, size_t count) {
+  size_t length = 0;
+  for (size_t i = 0; i < count; ++i) {
+    length += buffers[i].iov_len;
+  }
+  size_t tail = tail_.load(std::memory_order_relaxed);
+  size_t head = head_.load(std::memory_order_acquire);
+  if (length > Capacity() - (tail - head)) {
+    return false;
+  }
+  CopyIn(tail, buffers, count, length);
+  tail_.store(tail + length, std::memory_order_release);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SpscByteQueue::PushPartial(const iovec *buffers,
+                                               size_t count) {
+  size_t length = 0;
+  for (size_t i = 0; i < count; ++i) {
+    length += buffers[i].iov_len;
+  }
+  size_t tail = tail_.load(std::memory_order_relaxed);
+  size_t head = head_.load(std::memory_order_acquire);
+  length = std::min(length, Capacity() - (tail - head));
+  CopyIn(tail, buffers, count, length);
+  tail_.store(tail + length, std::memory_order_release);
+  return length;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SpscByteQueue::Pop(uint8_t *data, size_t size) {
+  size_t head = head_.load(std::memory_order_relaxed);
+  size_t tail = tail_.load(std::memory_order_acquire);
+  size_t length = std::min(size, tail - head);
+  if (length == 0) {
+    return 0;
+  }
+  size_t offset = head & mask_;
+  size_t first = std::min(length, buffer_.size() - offset);
+  std::memcpy(data, &buffer_[offset], first);
+  std::memcpy(data + first, &buffer_[0], length - first);
+  // Hands the bytes back to the producer once they are copied out.
+  head_.store(head + length, std::memory_order_release);
+  return length;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SpscByteQueue::Capacity() const ATLAS_NOEXCEPT {
+  return buffer_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SpscByteQueue::Size() const ATLAS_NOEXCEPT {
+  size_t head = head_.load(std::memory_order_acquire);
+  size_t tail = tail_.load(std::memory_order_acquire);
+  return tail >= head ? tail - head : 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SpscByteQueue::ReadPosition() const ATLAS_NOEXCEPT {
+  return head_.load(std::memory_order_acquire);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SpscByteQueue::WritePosition() const ATLAS_NOEXCEPT {
+  return tail_.load(std::memory_order_acquire);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SpscByteQueue::CopyIn(size_t position, const iovec *buffers,
+                                        size_t count,
+                                        size_t length) ATLAS_NOEXCEPT {
+  for (size_t i = 0; i < count && length != 0; ++i) {
+    const uint8_t *data = static_cast<const uint8_t *>(buffers[i].iov_base);
+    size_t copied = std::min(length, buffers[i].iov_len);
+    size_t offset = position & mask_;
+    size_t first = std::min(copied, buffer_.size() - offset);
+    std::memcpy(&buffer_[offset], data, first);
+    std::memcpy(&buffer_[0], data + first, copied - first);
+    position += copied;
+    length -= copied;
+  }
+}
+
+}  // namespace details
+
+}  // namespace atlas
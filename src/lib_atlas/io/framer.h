@@ -0,0 +1,279 @@
+/**
+ * \file	framer.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_FRAMER_H_
+#define LIB_ATLAS_IO_FRAMER_H_
+
+#include <lib_atlas/macros.h>
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * A non owning view on the payload of a frame.
+ *
+ * The bytes belong to the buffer the frame was extracted from. When returned
+ * by Serial::ReadFrame(), the view stays valid until the next read on the
+ * port.
+ */
+struct FrameView {
+  const uint8_t *data = {nullptr};
+
+  size_t size = {0};
+
+  const uint8_t *begin() const ATLAS_NOEXCEPT { return data; }
+
+  const uint8_t *end() const ATLAS_NOEXCEPT { return data + size; }
+
+  bool empty() const ATLAS_NOEXCEPT { return size == 0; }
+
+  std::string ToString() const {
+    return std::string(reinterpret_cast<const char *>(data), size);
+  }
+};
+
+/**
+ * A Framer extracts the frames of a protocol from a stream of bytes.
+ *
+ * The framers are given the bytes that were received but not consumed yet.
+ * They can decode the frame in place (e.g. to remove an escaping) since the
+ * bytes they consume are discarded afterward, which allows to extract frames
+ * without any copy or allocation.
+ *
+ * Implementing a new protocol only requires to implement Extract() and
+ * MaxFrameSize().
+ */
+class Framer {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<Framer>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  virtual ~Framer() ATLAS_NOEXCEPT = default;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Extract the first frame of the pending bytes.
+   *
+   * \param data The pending bytes, which may be modified in the range that is
+   *        consumed.
+   * \param size The number of pending bytes.
+   * \param frame Set to the payload of the frame if one was extracted. It
+   *        must point inside the consumed bytes.
+   *
+   * \return The number of bytes consumed. 0 means that more bytes are needed.
+   *         If bytes are consumed and frame.data is null, the bytes were
+   *         discarded (e.g. garbage before a sync word, or a corrupted frame).
+   */
+  virtual size_t Extract(uint8_t *data, size_t size, FrameView &frame) = 0;
+
+  /**
+   * \return The maximum number of bytes an encoded frame can span. The
+   *         reader must be able to buffer this amount of bytes.
+   */
+  virtual size_t MaxFrameSize() const ATLAS_NOEXCEPT = 0;
+};
+
+/**
+ * Frames terminated by a delimiter -- e.g. "\r\n" for NMEA sentences.
+ * The delimiter is not part of the payload. Frames longer than the maximum
+ * payload are discarded.
+ */
+class DelimiterFramer : public Framer {
+ public:
+  using Ptr = std::shared_ptr<DelimiterFramer>;
+
+  explicit DelimiterFramer(const std::string &delimiter = "\n",
+                           size_t max_payload = 65536);
+
+  size_t Extract(uint8_t *data, size_t size, FrameView &frame) override;
+
+  size_t MaxFrameSize() const ATLAS_NOEXCEPT override;
+
+ private:
+  std::string delimiter_;
+
+  size_t max_payload_;
+
+  /** True while the bytes of a frame that is too long are dropped. */
+  bool discarding_;
+};
+
+/**
+ * Frames starting with their payload length, encoded on 1, 2 or 4 bytes.
+ */
+class LengthPrefixFramer : public Framer {
+ public:
+  using Ptr = std::shared_ptr<LengthPrefixFramer>;
+
+  /**
+   * \param length_size The number of bytes of the length field (1, 2 or 4).
+   * \param big_endian The byte order of the length field.
+   * \param max_payload Frames announcing a bigger payload are considered as
+   *        corrupted and their first byte is discarded.
+   */
+  explicit LengthPrefixFramer(size_t length_size = 2, bool big_endian = true,
+                              size_t max_payload = 65535);
+
+  size_t Extract(uint8_t *data, size_t size, FrameView &frame) override;
+
+  size_t MaxFrameSize() const ATLAS_NOEXCEPT override;
+
+ private:
+  size_t length_size_;
+
+  bool big_endian_;
+
+  size_t max_payload_;
+};
+
+/**
+ * Consistent Overhead Byte Stuffing frames, terminated by a 0x00 byte.
+ * The frames are decoded in place. Malformed frames are discarded.
+ */
+class CobsFramer : public Framer {
+ public:
+  using Ptr = std::shared_ptr<CobsFramer>;
+
+  explicit CobsFramer(size_t max_payload = 65536);
+
+  size_t Extract(uint8_t *data, size_t size, FrameView &frame) override;
+
+  size_t MaxFrameSize() const ATLAS_NOEXCEPT override;
+
+ private:
+  size_t max_payload_;
+
+  /** True while the bytes of a frame that is too long are dropped. */
+  bool discarding_;
+};
+
+/**
+ * RFC 1055 SLIP frames, terminated by a 0xC0 byte.
+ * The frames are decoded in place. Malformed frames are discarded.
+ */
+class SlipFramer : public Framer {
+ public:
+  using Ptr = std::shared_ptr<SlipFramer>;
+
+  explicit SlipFramer(size_t max_payload = 65536);
+
+  size_t Extract(uint8_t *data, size_t size, FrameView &frame) override;
+
+  size_t MaxFrameSize() const ATLAS_NOEXCEPT override;
+
+ private:
+  size_t max_payload_;
+
+  /** True while the bytes of a frame that is too long are dropped. */
+  bool discarding_;
+};
+
+/**
+ * Binary frames laid out as: sync word | length | payload | CRC.
+ *
+ * The length field holds the size of the payload, and the CRC is computed on
+ * the length field and the payload. The bytes preceding the sync word are
+ * discarded, as well as the first byte of a frame with an invalid CRC so the
+ * framer can resynchronise on the next sync word.
+ */
+class SyncWordFramer : public Framer {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<SyncWordFramer>;
+
+  enum class Crc {
+    /** CRC-16/CCITT-FALSE: poly 0x1021, init 0xFFFF. */
+    kCrc16,
+    /** CRC-32 (IEEE 802.3): poly 0x04C11DB7 reflected, init 0xFFFFFFFF. */
+    kCrc32
+  };
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param sync_word The bytes starting every frame.
+   * \param crc The CRC appended after the payload.
+   * \param length_size The number of bytes of the length field (1, 2 or 4).
+   * \param big_endian The byte order of the length field and of the CRC.
+   * \param max_payload Frames announcing a bigger payload are discarded.
+   */
+  explicit SyncWordFramer(const std::vector<uint8_t> &sync_word,
+                          Crc crc = Crc::kCrc16, size_t length_size = 2,
+                          bool big_endian = true, size_t max_payload = 65535);
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  size_t Extract(uint8_t *data, size_t size, FrameView &frame) override;
+
+  size_t MaxFrameSize() const ATLAS_NOEXCEPT override;
+
+  /**
+   * \return The number of frames that were discarded because of a CRC error.
+   */
+  uint64_t GetCrcErrorCount() const ATLAS_NOEXCEPT;
+
+ private:
+  std::vector<uint8_t> sync_word_;
+
+  Crc crc_;
+
+  size_t length_size_;
+
+  bool big_endian_;
+
+  size_t max_payload_;
+
+  uint64_t crc_error_count_;
+};
+
+/**
+ * \return The CRC-16/CCITT-FALSE of the given bytes.
+ */
+uint16_t Crc16(const uint8_t *data, size_t size) ATLAS_NOEXCEPT;
+
+/**
+ * \return The CRC-32 (IEEE 802.3) of the given bytes.
+ */
+uint32_t Crc32(const uint8_t *data, size_t size) ATLAS_NOEXCEPT;
+
+}  // namespace atlas
+
+#include <lib_atlas/io/framer_inl.h>
+
+#endif  // LIB_ATLAS_IO_FRAMER_H_
@@ -0,0 +1,389 @@
+/**
+ * \file	framer_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_FRAMER_H_
+#error This file may only be included from framer.h
+#endif
+
+#include <string.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace atlas {
+
+namespace details {
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE uint32_t ReadUnsigned(const uint8_t *data, size_t size,
+                                          bool big_endian) ATLAS_NOEXCEPT {
+  uint32_t value = 0;
+  for (size_t i = 0; i < size; ++i) {
+    size_t index = big_endian ? i : size - 1 - i;
+    value = (value << 8) | data[index];
+  }
+  return value;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void CheckLengthSize(size_t length_size) {
+  if (length_size != 1 && length_size != 2 && length_size != 4) {
+    throw std::invalid_argument("The length field must be 1, 2 or 4 bytes.");
+  }
+}
+
+}  // namespace details
+
+//==============================================================================
+// C R C   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint16_t Crc16(const uint8_t *data, size_t size) ATLAS_NOEXCEPT {
+  static const std::vector<uint16_t> table = [] {
+    std::vector<uint16_t> t(256);
+    for (uint16_t i = 0; i < 256; ++i) {
+      uint16_t crc = static_cast<uint16_t>(i << 8);
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021)
+                             : static_cast<uint16_t>(crc << 1);
+      }
+      t[i] = crc;
+    }
+    return t;
+  }();
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < size; ++i) {
+    crc = static_cast<uint16_t>((crc << 8) ^
+                                table[((crc >> 8) ^ data[i]) & 0xFF]);
+  }
+  return crc;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint32_t Crc32(const uint8_t *data, size_t size) ATLAS_NOEXCEPT {
+  static const std::vector<uint32_t> table = [] {
+    std::vector<uint32_t> t(256);
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+      }
+      t[i] = crc;
+    }
+    return t;
+  }();
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < size; ++i) {
+    crc = (crc >> 8) ^ table[(crc ^ data[i]) & 0xFF];
+  }
+  return crc ^ 0xFFFFFFFF;
+}
+
+//==============================================================================
+// D E L I M I T E R   F R A M E R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE DelimiterFramer::DelimiterFramer(const std::string &delimiter,
+                                              size_t max_payload)
+    : delimiter_(delimiter), max_payload_(max_payload), discarding_(false) {
+  if (delimiter_.empty()) {
+    throw std::invalid_argument("The delimiter cannot be empty.");
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t DelimiterFramer::Extract(uint8_t *data, size_t size,
+                                             FrameView &frame) {
+  size_t limit = std::min(size, MaxFrameSize());
+  const void *match = nullptr;
+  if (delimiter_.length() == 1) {
+    match = memchr(data, delimiter_[0], limit);
+  } else {
+    match = memmem(data, limit, delimiter_.data(), delimiter_.length());
+  }
+  if (match != nullptr) {
+    size_t payload_size = static_cast<const uint8_t *>(match) - data;
+    if (!discarding_) {
+      frame.data = data;
+      frame.size = payload_size;
+    }
+    discarding_ = false;
+    return payload_size + delimiter_.length();
+  }
+  if (size >= MaxFrameSize()) {
+    // The frame is too long, drop it up to the next delimiter and keep only
+    // what could be a partial delimiter.
+    discarding_ = true;
+    return limit - (delimiter_.length() - 1);
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t DelimiterFramer::MaxFrameSize() const ATLAS_NOEXCEPT {
+  return max_payload_ + delimiter_.length();
+}
+
+//==============================================================================
+// L E N G T H   P R E F I X   F R A M E R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LengthPrefixFramer::LengthPrefixFramer(size_t length_size,
+                                                    bool big_endian,
+                                                    size_t max_payload)
+    : length_size_(length_size),
+      big_endian_(big_endian),
+      max_payload_(max_payload) {
+  details::CheckLengthSize(length_size_);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t LengthPrefixFramer::Extract(uint8_t *data, size_t size,
+                                                FrameView &frame) {
+  if (size < length_size_) {
+    return 0;
+  }
+  size_t length = details::ReadUnsigned(data, length_size_, big_endian_);
+  if (length > max_payload_) {
+    return 1;
+  }
+  if (size < length_size_ + length) {
+    return 0;
+  }
+  frame.data = data + length_size_;
+  frame.size = length;
+  return length_size_ + length;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t LengthPrefixFramer::MaxFrameSize() const ATLAS_NOEXCEPT {
+  return length_size_ + max_payload_;
+}
+
+//==============================================================================
+// C O B S   F R A M E R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE CobsFramer::CobsFramer(size_t max_payload)
+    : max_payload_(max_payload), discarding_(false) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t CobsFramer::Extract(uint8_t *data, size_t size,
+                                        FrameView &frame) {
+  size_t limit = std::min(size, MaxFrameSize());
+  const uint8_t *delimiter =
+      static_cast<const uint8_t *>(memchr(data, 0x00, limit));
+  if (delimiter == nullptr) {
+    // The frame is too long, drop it up to the next delimiter.
+    discarding_ = size >= MaxFrameSize();
+    return discarding_ ? limit : 0;
+  }
+  size_t encoded_size = delimiter - data;
+  size_t consumed = encoded_size + 1;
+  if (discarding_) {
+    discarding_ = false;
+    return consumed;
+  }
+
+  // The decoded bytes are always written before the ones being read.
+  size_t read = 0;
+  size_t written = 0;
+  while (read < encoded_size) {
+    size_t code = data[read++];
+    if (read + code - 1 > encoded_size) {
+      return consumed;  // Malformed frame
+    }
+    memmove(data + written, data + read, code - 1);
+    written += code - 1;
+    read += code - 1;
+    if (code != 0xFF && read < encoded_size) {
+      data[written++] = 0x00;
+    }
+  }
+  if (encoded_size != 0) {
+    frame.data = data;
+    frame.size = written;
+  }
+  return consumed;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t CobsFramer::MaxFrameSize() const ATLAS_NOEXCEPT {
+  // One overhead byte every 254 bytes, the first code and the delimiter.
+  return max_payload_ + max_payload_ / 254 + 2;
+}
+
+//==============================================================================
+// S L I P   F R A M E R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SlipFramer::SlipFramer(size_t max_payload)
+    : max_payload_(max_payload), discarding_(false) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SlipFramer::Extract(uint8_t *data, size_t size,
+                                        FrameView &frame) {
+  const uint8_t kEnd = 0xC0;
+  const uint8_t kEsc = 0xDB;
+  const uint8_t kEscEnd = 0xDC;
+  const uint8_t kEscEsc = 0xDD;
+
+  size_t limit = std::min(size, MaxFrameSize());
+  const uint8_t *end = static_cast<const uint8_t *>(memchr(data, kEnd, limit));
+  if (end == nullptr) {
+    // The frame is too long, drop it up to the next delimiter.
+    discarding_ = size >= MaxFrameSize();
+    return discarding_ ? limit : 0;
+  }
+  size_t encoded_size = end - data;
+  size_t consumed = encoded_size + 1;
+  if (discarding_) {
+    discarding_ = false;
+    return consumed;
+  }
+
+  size_t written = 0;
+  for (size_t read = 0; read < encoded_size; ++read) {
+    uint8_t byte = data[read];
+    if (byte == kEsc) {
+      if (++read == encoded_size) {
+        return consumed;  // Malformed frame
+      }
+      if (data[read] == kEscEnd) {
+        byte = kEnd;
+      } else if (data[read] == kEscEsc) {
+        byte = kEsc;
+      } else {
+        return consumed;  // Malformed frame
+      }
+    }
+    data[written++] = byte;
+  }
+  // Empty frames are sent by some devices to flush the line noise.
+  if (encoded_size != 0) {
+    frame.data = data;
+    frame.size = written;
+  }
+  return consumed;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SlipFramer::MaxFrameSize() const ATLAS_NOEXCEPT {
+  // Every byte may be escaped.
+  return 2 * max_payload_ + 1;
+}
+
+//==============================================================================
+// S Y N C   W O R D   F R A M E R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SyncWordFramer::SyncWordFramer(
+    const std::vector<uint8_t> &sync_word, Crc crc, size_t length_size,
+    bool big_endian, size_t max_payload)
+    : sync_word_(sync_word),
+      crc_(crc),
+      length_size_(length_size),
+      big_endian_(big_endian),
+      max_payload_(max_payload),
+      crc_error_count_(0) {
+  if (sync_word_.empty()) {
+    throw std::invalid_argument("The sync word cannot be empty.");
+  }
+  details::CheckLengthSize(length_size_);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SyncWordFramer::Extract(uint8_t *data, size_t size,
+                                            FrameView &frame) {
+  const uint8_t *sync = static_cast<const uint8_t *>(
+      memmem(data, size, sync_word_.data(), sync_word_.size()));
+  if (sync == nullptr) {
+    // Keep only what could be a partial sync word.
+    return size >= sync_word_.size() ? size - (sync_word_.size() - 1) : 0;
+  }
+  if (sync != data) {
+    return sync - data;
+  }
+
+  size_t header_size = sync_word_.size() + length_size_;
+  size_t crc_size = crc_ == Crc::kCrc16 ? 2 : 4;
+  if (size < header_size) {
+    return 0;
+  }
+  size_t length = details::ReadUnsigned(data + sync_word_.size(),
+                                        length_size_, big_endian_);
+  if (length > max_payload_) {
+    return 1;
+  }
+  size_t frame_size = header_size + length + crc_size;
+  if (size < frame_size) {
+    return 0;
+  }
+
+  const uint8_t *checked = data + sync_word_.size();
+  uint32_t expected = details::ReadUnsigned(data + header_size + length,
+                                            crc_size, big_endian_);
+  uint32_t actual = crc_ == Crc::kCrc16 ? Crc16(checked, length_size_ + length)
+                                        : Crc32(checked, length_size_ + length);
+  if (expected != actual) {
+    ++crc_error_count_;
+    return 1;
+  }
+  frame.data = data + header_size;
+  frame.size = length;
+  return frame_size;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SyncWordFramer::MaxFrameSize() const ATLAS_NOEXCEPT {
+  return sync_word_.size() + length_size_ + max_payload_ +
+         (crc_ == Crc::kCrc16 ? 2 : 4);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t SyncWordFramer::GetCrcErrorCount() const ATLAS_NOEXCEPT {
+  return crc_error_count_;
+}
+
+}  // namespace atlas
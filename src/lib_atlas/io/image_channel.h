@@ -0,0 +1,246 @@
+/**
+ * \file	image_channel.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_IMAGE_CHANNEL_H_
+#define LIB_ATLAS_IO_IMAGE_CHANNEL_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <opencv2/core/core.hpp>
+#include <string>
+
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/subject.h>
+
+namespace atlas {
+
+/**
+ * An image passed between the publishers and the subscribers of a process.
+ */
+struct ChannelImage {
+  /** Shared by every subscriber, it must not be modified once published. */
+  std::shared_ptr<const cv::Mat> image;
+
+  /** The time of the image, in nanoseconds since the epoch. */
+  int64_t stamp_ns = {0};
+};
+
+/**
+ * The intra-process channel of an image topic.
+ *
+ * The publisher and the subscribers of a topic living in the same process
+ * find the channel of the topic with Get. The images are then notified to
+ * the subscribers by pointer, without serialization and without locks:
+ * Notify iterates a snapshot of the subscribers -- see Subject.
+ *
+ * A single publisher, the one that claimed the channel, publishes in it, so
+ * that the subscribers receive the images of a single thread. The channel
+ * remembers the stamps of its latest images, so that the subscribers ignore
+ * the copies they also receive through the inter-process transport, and
+ * only those: the images of the other publishers come through the transport.
+ *
+ * A subscriber holds the channel while it is attached to it, as the channel
+ * of a topic is destroyed once nobody holds it.
+ */
+class ImageChannel : public Subject<const ChannelImage &> {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<ImageChannel>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  ImageChannel() ATLAS_NOEXCEPT;
+
+  ~ImageChannel() ATLAS_NOEXCEPT = default;
+
+  ImageChannel(const ImageChannel &) = delete;
+
+  ImageChannel &operator=(const ImageChannel &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * \return The channel of the topic, created if nobody holds it. The topic
+   *         should be a resolved name, so that every end finds the same
+   *         channel.
+   */
+  static Ptr Get(const std::string &topic);
+
+  /**
+   * Make the caller the publisher of the channel.
+   *
+   * \return False if the channel already has a publisher.
+   */
+  bool ClaimPublisher() ATLAS_NOEXCEPT;
+
+  /**
+   * Release the channel claimed with ClaimPublisher.
+   */
+  void ReleasePublisher() ATLAS_NOEXCEPT;
+
+  bool HasPublisher() const ATLAS_NOEXCEPT;
+
+  /**
+   * Remember the stamp of an image notified to the subscribers. Only called
+   * by the publisher of the channel, before notifying the image.
+   */
+  void RecordNotified(int64_t stamp_ns) ATLAS_NOEXCEPT;
+
+  /**
+   * \return True if the publisher of the channel notified an image of this
+   *         stamp among its latest kNotifiedStamps images.
+   */
+  bool WasNotified(int64_t stamp_ns) const ATLAS_NOEXCEPT;
+
+  /**
+   * Count a subscriber that is also subscribed to the topic through the
+   * inter-process transport, so that the transport is only used when it has
+   * other subscribers.
+   */
+  void AddTransportSubscriber() ATLAS_NOEXCEPT;
+
+  void RemoveTransportSubscriber() ATLAS_NOEXCEPT;
+
+  size_t GetTransportSubscriberCount() const ATLAS_NOEXCEPT;
+
+  /** Number of stamps remembered by the channel. */
+  static const size_t kNotifiedStamps = 16;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::atomic<bool> has_publisher_;
+
+  /** A ring of the latest stamps, written by the publisher only. */
+  std::atomic<int64_t> notified_stamps_[kNotifiedStamps];
+
+  size_t next_stamp_;
+
+  std::atomic<size_t> transport_subscribers_;
+};
+
+/**
+ * The inter-process transport of a topic, used when the subscribers are not
+ * all in the process.
+ */
+class RemoteImageTransport {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  virtual ~RemoteImageTransport() ATLAS_NOEXCEPT = default;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * \return The number of subscribers of the transport, including the
+   *         subscribers of the process that are subscribed through it --
+   *         see ImageChannel::AddTransportSubscriber().
+   */
+  virtual size_t GetSubscriberCount() const = 0;
+
+  virtual void Publish(const ChannelImage &image) = 0;
+};
+
+/**
+ * The counters of an ImageChannelPublisher.
+ */
+struct ImageChannelStats {
+  /** Images notified to the subscribers of the process. */
+  uint64_t intra_process = {0};
+
+  /** Images published through the remote transport. */
+  uint64_t remote = {0};
+};
+
+/**
+ * Publish the images of a topic in its intra-process channel, and through a
+ * remote transport only if it has subscribers outside of the process.
+ *
+ * If another publisher of the process already claimed the channel, every
+ * image goes through the remote transport.
+ */
+class ImageChannelPublisher {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  ImageChannelPublisher(const std::string &topic,
+                        RemoteImageTransport &transport);
+
+  ~ImageChannelPublisher() ATLAS_NOEXCEPT;
+
+  ImageChannelPublisher(const ImageChannelPublisher &) = delete;
+
+  ImageChannelPublisher &operator=(const ImageChannelPublisher &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * \param image The image shared with the subscribers, it must not be
+   *        modified once published.
+   */
+  void Publish(std::shared_ptr<const cv::Mat> image, int64_t stamp_ns);
+
+  /**
+   * \return True if this publisher claimed the intra-process channel.
+   */
+  bool IsIntraProcess() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return True if the images are notified to subscribers of the process.
+   */
+  bool HasIntraProcessSubscribers() const ATLAS_NOEXCEPT;
+
+  ImageChannelStats GetStats() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  ImageChannel::Ptr channel_;
+
+  RemoteImageTransport &transport_;
+
+  bool is_intra_process_;
+
+  std::atomic<uint64_t> intra_process_count_;
+
+  std::atomic<uint64_t> remote_count_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/image_channel_inl.h>
+
+#endif  // LIB_ATLAS_IO_IMAGE_CHANNEL_H_
@@ -0,0 +1,207 @@
+/**
+ * \file	image_channel_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_IMAGE_CHANNEL_H_
+#error This file may only be included from image_channel.h
+#endif
+
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace atlas {
+
+//==============================================================================
+// I M A G E   C H A N N E L   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImageChannel::ImageChannel() ATLAS_NOEXCEPT
+    : Subject<const ChannelImage &>(),
+      has_publisher_(false),
+      notified_stamps_(),
+      next_stamp_(0),
+      transport_subscribers_(0) {
+  for (auto &stamp : notified_stamps_) {
+    stamp.store(std::numeric_limits<int64_t>::min(),
+                std::memory_order_relaxed);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImageChannel::Ptr ImageChannel::Get(const std::string &topic) {
+  // Only taken when an end is created, never to publish.
+  static std::mutex registry_mutex;
+  static std::map<std::string, std::weak_ptr<ImageChannel>> registry;
+
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  Ptr channel = registry[topic].lock();
+  if (!channel) {
+    channel = std::make_shared<ImageChannel>();
+    registry[topic] = channel;
+  }
+  // Forget the topics whose channel was destroyed.
+  for (auto it = registry.begin(); it != registry.end();) {
+    if (it->second.expired()) {
+      it = registry.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return channel;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageChannel::ClaimPublisher() ATLAS_NOEXCEPT {
+  bool expected = false;
+  return has_publisher_.compare_exchange_strong(expected, true);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageChannel::ReleasePublisher() ATLAS_NOEXCEPT {
+  has_publisher_ = false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageChannel::HasPublisher() const ATLAS_NOEXCEPT {
+  return has_publisher_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageChannel::RecordNotified(int64_t stamp_ns)
+    ATLAS_NOEXCEPT {
+  notified_stamps_[next_stamp_].store(stamp_ns, std::memory_order_release);
+  next_stamp_ = (next_stamp_ + 1) % kNotifiedStamps;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageChannel::WasNotified(int64_t stamp_ns) const
+    ATLAS_NOEXCEPT {
+  for (const auto &stamp : notified_stamps_) {
+    if (stamp.load(std::memory_order_acquire) == stamp_ns) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageChannel::AddTransportSubscriber() ATLAS_NOEXCEPT {
+  transport_subscribers_.fetch_add(1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageChannel::RemoveTransportSubscriber() ATLAS_NOEXCEPT {
+  transport_subscribers_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t ImageChannel::GetTransportSubscriberCount() const
+    ATLAS_NOEXCEPT {
+  return transport_subscribers_.load(std::memory_order_relaxed);
+}
+
+//==============================================================================
+// I M A G E   C H A N N E L   P U B L I S H E R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImageChannelPublisher::ImageChannelPublisher(
+    const std::string &topic, RemoteImageTransport &transport)
+    : channel_(ImageChannel::Get(topic)),
+      transport_(transport),
+      is_intra_process_(channel_->ClaimPublisher()),
+      intra_process_count_(0),
+      remote_count_(0) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImageChannelPublisher::~ImageChannelPublisher() ATLAS_NOEXCEPT {
+  if (is_intra_process_) {
+    channel_->ReleasePublisher();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageChannelPublisher::Publish(
+    std::shared_ptr<const cv::Mat> image, int64_t stamp_ns) {
+  ChannelImage message;
+  message.image = std::move(image);
+  message.stamp_ns = stamp_ns;
+
+  size_t local_count = 0;
+  if (is_intra_process_) {
+    if (channel_->ObserverCount() > 0) {
+      channel_->RecordNotified(stamp_ns);
+      channel_->Notify(message);
+      intra_process_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    local_count = channel_->GetTransportSubscriberCount();
+  }
+  // The subscribers of the process that are also counted by the transport
+  // ignore the images of the channel it delivers, so it is only used if
+  // there are others.
+  if (transport_.GetSubscriberCount() > local_count) {
+    transport_.Publish(message);
+    remote_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageChannelPublisher::IsIntraProcess() const
+    ATLAS_NOEXCEPT {
+  return is_intra_process_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageChannelPublisher::HasIntraProcessSubscribers() const
+    ATLAS_NOEXCEPT {
+  return is_intra_process_ && channel_->ObserverCount() > 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImageChannelStats ImageChannelPublisher::GetStats() const
+    ATLAS_NOEXCEPT {
+  ImageChannelStats stats;
+  stats.intra_process = intra_process_count_.load(std::memory_order_relaxed);
+  stats.remote = remote_count_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace atlas
@@ -26,7 +26,9 @@
 #ifndef LIB_ATLAS_IO_IMAGE_SEQUENCE_CAPTURE_H_
 #define LIB_ATLAS_IO_IMAGE_SEQUENCE_CAPTURE_H_
 
+#include <lib_atlas/pattern/buffer_pool.h>
 #include <lib_atlas/pattern/subject.h>
+#include <lib_atlas/sys/frame_pacer.h>
 #include <lib_atlas/sys/timer.h>
 #include <atomic>
 #include <condition_variable>
@@ -37,6 +39,29 @@
 
 namespace atlas {
 
+/**
+ * A source of images that can either be polled with GetImage or stream its
+ * images to its observers.
+ *
+ * The streaming thread is created by Start. While the capture is not
+ * streaming, the thread sleeps on a condition variable. While it streams,
+ * a FramePacer releases the images at the max framerate.
+ *
+ * With EnableFramePool, the streamed images are taken from a pool of
+ * recycled buffers rather than allocated for every frame. The observers of
+ * GetFrameSubject receive a reference counted Frame they can keep, the
+ * buffer going back to the pool once every copy of the Frame is released.
+ * The synchronous cv::Mat observers receive a view of the same buffer,
+ * which is only valid during the notification.
+ *
+ * The images are notified to the queued cv::Mat observers -- see
+ * Observer::SetQueuedDelivery -- as a copy they can keep, made once per
+ * frame while such an observer is attached. The queued observers of
+ * GetFrameSubject hold the Frame itself, without any copy.
+ *
+ * A derived class must call Stop in its destructor, as the streaming thread
+ * calls GetNextImage.
+ */
 class ImageSequenceCapture : public Subject<cv::Mat> {
  public:
   //==========================================================================
@@ -44,6 +69,10 @@ class ImageSequenceCapture : public Subject<cv::Mat> {
 
   using Ptr = std::shared_ptr<ImageSequenceCapture>;
 
+  using FramePool = BufferPool<cv::Mat>;
+
+  using Frame = FramePool::Handle;
+
   //============================================================================
   // P U B L I C   C / D T O R S
 
@@ -67,7 +96,10 @@ class ImageSequenceCapture : public Subject<cv::Mat> {
    * When in streaming mode. If a max framerate have been set, the streaming
    * loop will wait the appropriate time in order to have the expected max
    * framerate (only if the framerate is higher that the one manually
-   * specified).
+   * specified). The framerate can be fractional -- e.g. 29.97 -- and 0
+   * removes the limit.
+   *
+   * \throw std::invalid_argument If the framerate is negative or not finite.
    */
   virtual void SetMaxFramerate(double framerate);
 
@@ -89,13 +121,50 @@ class ImageSequenceCapture : public Subject<cv::Mat> {
    */
   const cv::Mat &GetImage();
 
+  /**
+   * \return The statistics of the streaming loop: the number of frames
+   *         streamed, the frames released late and the jitter of the release
+   *         times.
+   */
+  FramePacerStats GetPacingStats() const;
+
+  /**
+   * Stream the images through a pool of count recycled buffers. The buffers
+   * are allocated on their first use and reallocated only if the size of
+   * the images changes. When every buffer is held by the observers, the
+   * frame is skipped rather than allocated.
+   *
+   * \throw std::logic_error If the capture is running.
+   */
+  void EnableFramePool(size_t count);
+
+  bool IsFramePoolEnabled() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The counters of the frame pool, all zero if it is not enabled.
+   */
+  BufferPoolStats GetFramePoolStats() const;
+
+  /**
+   * \return The subject notifying the pooled frames while streaming with a
+   *         frame pool.
+   */
+  Subject<const Frame &> &GetFrameSubject() ATLAS_NOEXCEPT;
+
   /**
    * Start the ImageSequenceProvider by Openning the media -- see Open().
+   *
+   * \throw std::system_error If the streaming thread cannot be created.
    */
-  void Start() ATLAS_NOEXCEPT;
+  void Start();
 
   /**
    * Stop the ImageSequenceProvider by closing the media -- see Close().
+   *
+   * This waits for the streaming thread to exit, unless it is called from
+   * the streaming thread itself -- e.g. by an observer. The thread then
+   * exits once the notification is over, and is joined by the next Start
+   * or by the destructor.
    */
   void Stop() ATLAS_NOEXCEPT;
 
@@ -131,6 +200,40 @@ class ImageSequenceCapture : public Subject<cv::Mat> {
 
   virtual const cv::Mat &GetNextImage() const = 0;
 
+  /**
+   * Return the next image in a pooled frame. By default, this copies
+   * GetNextImage into a buffer of the pool. A derived class can override it
+   * to decode directly into AcquireFrame().
+   *
+   * \return The next frame, or an empty frame to skip it.
+   */
+  virtual Frame GetNextFrame();
+
+  /**
+   * \return A free buffer of the frame pool, or an empty frame if the pool
+   *         is exhausted or not enabled.
+   */
+  Frame AcquireFrame();
+
+  /**
+   * Notify the next image while streaming. By default, this notifies
+   * GetNextFrame when the frame pool is enabled and GetNextImage otherwise.
+   * A derived class can override it to skip a frame or to notify an image
+   * it does not hold in a pooled frame.
+   */
+  virtual void StreamNextImage() ATLAS_NOEXCEPT;
+
+  /**
+   * Notify a pooled frame to both subjects and count it.
+   */
+  void NotifyFrame(const Frame &frame) ATLAS_NOEXCEPT;
+
+  /**
+   * Notify an image to the cv::Mat observers only and count it. The queued
+   * observers receive a copy of the image.
+   */
+  void NotifyImage(const cv::Mat &image) ATLAS_NOEXCEPT;
+
  private:
   //============================================================================
   // P R I V A T E   M E T H O D S
@@ -139,28 +242,51 @@ class ImageSequenceCapture : public Subject<cv::Mat> {
    * The thread function that is going to notify all the observer of this
    * Image Provider if we are in streaming mode.
    *
-   * This is going to wait for the running_ flag to be true, and the will start.
+   * This sleeps until the capture streams, then notifies the observers at
+   * the pace of the FramePacer until it stops streaming or running.
+   *
+   * \param generation The run of the capture the loop belongs to.
+   * \param previous The thread of the previous run, joined and deleted
+   *        before streaming, or null.
    */
-  void StreamingLoop() ATLAS_NOEXCEPT;
+  void StreamingLoop(uint64_t generation,
+                     std::thread *previous) ATLAS_NOEXCEPT;
 
   //============================================================================
   // P R I V A T E   M E M B E R S
 
-  double max_framerate_;
+  std::atomic<double> max_framerate_;
 
-  uint64_t frame_count_;
-
-  double total_streaming_time_;
+  std::atomic<uint64_t> frame_count_;
 
   std::atomic<bool> streaming_;
 
   std::atomic<bool> running_;
 
+  /**
+   * The streaming thread. After Stop, it is only kept if the capture was
+   * stopped by one of its observers, to be joined later.
+   */
   std::unique_ptr<std::thread> streaming_thread_;
 
-  std::condition_variable cv;
+  /** Incremented by Start, guarded by streaming_mutex_. */
+  uint64_t generation_;
+
+  /** Only used by the streaming thread, except for its statistics. */
+  FramePacer pacer_;
+
+  /** Null if the frames are not pooled. Only changed while not running. */
+  std::unique_ptr<FramePool> frame_pool_;
+
+  Subject<const Frame &> frame_subject_;
+
+  /**
+   * Signaled when running_ or streaming_ change, with streaming_mutex_ held
+   * so the streaming thread cannot miss it.
+   */
+  std::condition_variable streaming_condition_;
 
-  mutable std::mutex cv_mutex_;
+  mutable std::mutex streaming_mutex_;
 };
 
 }  // namespace atlas
@@ -28,7 +28,9 @@
 #endif
 
 #include <lib_atlas/sys/timer.h>
+#include <cmath>
 #include <functional>
+#include <stdexcept>
 
 namespace atlas {
 
@@ -40,17 +42,22 @@ namespace atlas {
 ATLAS_ALWAYS_INLINE ImageSequenceCapture::ImageSequenceCapture() ATLAS_NOEXCEPT
     : max_framerate_(0),
       frame_count_(0),
-      total_streaming_time_(0),
       streaming_(false),
       running_(false),
       streaming_thread_(),
-      cv(),
-      cv_mutex_() {}
+      generation_(0),
+      pacer_(),
+      frame_pool_(),
+      frame_subject_(),
+      streaming_condition_(),
+      streaming_mutex_() {}
 
 //------------------------------------------------------------------------------
 //
 ATLAS_ALWAYS_INLINE ImageSequenceCapture::~ImageSequenceCapture()
-    ATLAS_NOEXCEPT {}
+    ATLAS_NOEXCEPT {
+  Stop();
+}
 
 //==============================================================================
 // M E T H O D S   S E C T I O N
@@ -68,67 +75,245 @@ ATLAS_ALWAYS_INLINE const cv::Mat &ImageSequenceCapture::GetImage() {
 
 //------------------------------------------------------------------------------
 //
-void ImageSequenceCapture::Start() ATLAS_NOEXCEPT {
-  std::lock_guard<std::mutex> lock(cv_mutex_);
+ATLAS_INLINE void ImageSequenceCapture::Start() {
+  std::unique_lock<std::mutex> lock(streaming_mutex_);
+  if (running_) {
+    return;
+  }
+  // The thread of a previous run, if it was stopped by one of its
+  // observers. Its loop exits as soon as the notification is over.
+  std::unique_ptr<std::thread> previous = std::move(streaming_thread_);
+  if (previous && previous->get_id() != std::this_thread::get_id()) {
+    lock.unlock();
+    previous->join();
+    previous.reset();
+    lock.lock();
+    if (running_) {
+      return;
+    }
+  }
+
+  pacer_.Resume();
   running_ = true;
+  ++generation_;
+  try {
+    // Started by an observer: the new thread joins the previous one before
+    // streaming, so that a single thread calls GetNextImage.
+    streaming_thread_.reset(new std::thread(
+        &ImageSequenceCapture::StreamingLoop, this, generation_,
+        previous.get()));
+    previous.release();
+  } catch (...) {
+    running_ = false;
+    streaming_thread_ = std::move(previous);
+    throw;
+  }
 }
 
 //------------------------------------------------------------------------------
 //
-void ImageSequenceCapture::Stop() ATLAS_NOEXCEPT { running_ = false; }
+ATLAS_INLINE void ImageSequenceCapture::Stop() ATLAS_NOEXCEPT {
+  std::unique_ptr<std::thread> thread;
+  {
+    std::lock_guard<std::mutex> lock(streaming_mutex_);
+    running_ = false;
+    streaming_condition_.notify_all();
+    if (streaming_thread_ &&
+        streaming_thread_->get_id() == std::this_thread::get_id()) {
+      // Stopped by an observer: the thread cannot join itself, its handle
+      // is kept to be joined by the next Start or by the destructor.
+      pacer_.Interrupt();
+      return;
+    }
+    thread = std::move(streaming_thread_);
+  }
+  pacer_.Interrupt();
+  if (thread && thread->joinable()) {
+    thread->join();
+  }
+}
 
 //------------------------------------------------------------------------------
 //
-double ImageSequenceCapture::GetMaxFramerate() const ATLAS_NOEXCEPT {
+ATLAS_INLINE double ImageSequenceCapture::GetMaxFramerate() const
+    ATLAS_NOEXCEPT {
   return max_framerate_;
 }
 
 //------------------------------------------------------------------------------
 //
-void ImageSequenceCapture::SetMaxFramerate(double framerate) {
+ATLAS_INLINE void ImageSequenceCapture::SetMaxFramerate(double framerate) {
+  if (!std::isfinite(framerate) || framerate < 0) {
+    throw std::invalid_argument("the max framerate must be a positive number");
+  }
   max_framerate_ = framerate;
 }
 
 //------------------------------------------------------------------------------
 //
-uint64_t ImageSequenceCapture::GetFrameCount() const ATLAS_NOEXCEPT {
+ATLAS_INLINE uint64_t ImageSequenceCapture::GetFrameCount() const
+    ATLAS_NOEXCEPT {
   return frame_count_;
 }
 
 //------------------------------------------------------------------------------
 //
-void ImageSequenceCapture::SetStreamingMode(bool streaming) ATLAS_NOEXCEPT {
-  streaming_ = streaming;
+ATLAS_INLINE FramePacerStats ImageSequenceCapture::GetPacingStats() const {
+  return pacer_.GetStats();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageSequenceCapture::EnableFramePool(size_t count) {
+  std::lock_guard<std::mutex> lock(streaming_mutex_);
+  if (running_) {
+    throw std::logic_error(
+        "The frame pool cannot be changed while the capture is running.");
+  }
+  frame_pool_.reset(new FramePool(count));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageSequenceCapture::IsFramePoolEnabled() const
+    ATLAS_NOEXCEPT {
+  return frame_pool_ != nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE BufferPoolStats ImageSequenceCapture::GetFramePoolStats() const {
+  return frame_pool_ ? frame_pool_->GetStats() : BufferPoolStats();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Subject<const ImageSequenceCapture::Frame &>
+    &ImageSequenceCapture::GetFrameSubject() ATLAS_NOEXCEPT {
+  return frame_subject_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImageSequenceCapture::Frame
+ImageSequenceCapture::GetNextFrame() {
+  Frame frame = AcquireFrame();
+  if (frame) {
+    // copyTo reuses the buffer of the frame when the size does not change.
+    GetNextImage().copyTo(*frame);
+  }
+  return frame;
 }
 
 //------------------------------------------------------------------------------
 //
-bool ImageSequenceCapture::IsStreaming() const ATLAS_NOEXCEPT {
+ATLAS_INLINE ImageSequenceCapture::Frame ImageSequenceCapture::AcquireFrame() {
+  return frame_pool_ ? frame_pool_->TryAcquire() : Frame();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageSequenceCapture::SetStreamingMode(bool streaming)
+    ATLAS_NOEXCEPT {
+  {
+    std::lock_guard<std::mutex> lock(streaming_mutex_);
+    streaming_ = streaming;
+  }
+  streaming_condition_.notify_all();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageSequenceCapture::IsStreaming() const ATLAS_NOEXCEPT {
   return streaming_;
 }
 
 //------------------------------------------------------------------------------
 //
-bool ImageSequenceCapture::IsRunning() const ATLAS_NOEXCEPT { return running_; }
+ATLAS_INLINE bool ImageSequenceCapture::IsRunning() const ATLAS_NOEXCEPT {
+  return running_;
+}
 
 //------------------------------------------------------------------------------
 //
-ATLAS_ALWAYS_INLINE void ImageSequenceCapture::StreamingLoop() ATLAS_NOEXCEPT {
-  std::unique_lock<std::mutex> lock(cv_mutex_);
-  cv.wait(lock, [=] { return static_cast<bool>(running_); });
+ATLAS_ALWAYS_INLINE void ImageSequenceCapture::StreamingLoop(
+    uint64_t generation, std::thread *previous) ATLAS_NOEXCEPT {
+  if (previous) {
+    previous->join();
+    delete previous;
+  }
+
+  bool is_paused = true;
+  std::unique_lock<std::mutex> lock(streaming_mutex_);
+  while (true) {
+    // A loop stopped by an observer exits even if the capture was started
+    // again from the same notification.
+    auto is_stopped = [this, generation]() {
+      return !running_ || generation_ != generation;
+    };
+    // No CPU is used while the capture is not streaming.
+    streaming_condition_.wait(
+        lock, [this, &is_stopped]() { return is_stopped() || streaming_; });
+    if (is_stopped()) {
+      return;
+    }
+    lock.unlock();
+
+    double framerate = max_framerate_;
+    if (framerate != pacer_.GetRate()) {
+      pacer_.SetRate(framerate);
+    } else if (is_paused) {
+      pacer_.Reset();
+    }
+    is_paused = false;
+
+    // The streaming mode may have been disabled during the wait.
+    if (pacer_.WaitNextFrame() && streaming_) {
+      StreamNextImage();
+    }
 
-  MilliTimer timer;
-  timer.Start();
-  while (running_) {
-    if (streaming_) {
-      if (max_framerate_ != 0 && max_framerate_ < 1 / timer.Seconds()) {
-        cv.wait(lock, [&] { return max_framerate_ < 1 / timer.Seconds(); });
-      }
-      timer.Reset();
-      Notify(GetNextImage());
-      ++frame_count_;
+    lock.lock();
+    if (!streaming_) {
+      is_paused = true;
     }
   }
 }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageSequenceCapture::StreamNextImage() ATLAS_NOEXCEPT {
+  if (!frame_pool_) {
+    NotifyImage(GetNextImage());
+    return;
+  }
+  Frame frame = GetNextFrame();
+  // The frame is empty when every buffer is held by the observers.
+  if (frame) {
+    NotifyFrame(frame);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageSequenceCapture::NotifyFrame(const Frame &frame)
+    ATLAS_NOEXCEPT {
+  frame_subject_.Notify(frame);
+  NotifyImage(*frame);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageSequenceCapture::NotifyImage(const cv::Mat &image)
+    ATLAS_NOEXCEPT {
+  if (HasQueuedObservers()) {
+    // The image -- or the pooled buffer it views -- is overwritten by the
+    // next frames while the queued observers still hold it. They all share
+    // a single copy.
+    Notify(image.clone());
+  } else {
+    Notify(image);
+  }
+  ++frame_count_;
+}
+
 }  // namespace atlas
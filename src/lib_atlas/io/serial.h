@@ -37,10 +37,18 @@
 #define LIB_ATLAS_IO_SERIAL_H_
 
 #include <lib_atlas/exceptions.h>
+#include <lib_atlas/io/framer.h>
+#include <lib_atlas/io/serial_recorder.h>
+#include <lib_atlas/io/serial_stats.h>
+#include <lib_atlas/io/write_batch.h>
 #include <lib_atlas/macros.h>
+#include <lib_atlas/sys/instrumented_lock.h>
 #include <stdint.h>
+#include <sys/uio.h>
+#include <chrono>
 #include <cstring>
 #include <exception>
+#include <future>
 #include <limits>
 #include <memory>
 #include <sstream>
@@ -54,6 +62,8 @@
 
 namespace atlas {
 
+class SerialReactor;
+
 /**
  * Enumeration defines the possible bytesizes for the serial port.
  */
@@ -93,6 +103,62 @@ typedef enum {
   flowcontrol_hardware = 2
 } flowcontrol_t;
 
+/**
+ * Enumeration defines what an asynchronous write does when the write queue
+ * is full -- see Serial::EnableAsyncWrite().
+ */
+enum class AsyncWritePolicy {
+  /** The bytes of the write are discarded. */
+  kDropNewest,
+  /** The bytes of the write that fit are queued, the others are discarded. */
+  kTruncate
+};
+
+/**
+ * Statistics of the asynchronous write queue of a serial port.
+ */
+struct AsyncWriteStats {
+  /** Number of bytes waiting to be written. */
+  size_t queued_bytes = {0};
+
+  /** Maximum number of bytes that were waiting to be written. */
+  size_t high_water_mark = {0};
+
+  /** Number of bytes discarded because the queue was full. */
+  uint64_t dropped_bytes = {0};
+};
+
+/**
+ * Structure for setting the low latency mode of a serial port -- see
+ * Serial::SetLowLatency().
+ */
+struct LowLatency {
+  /**
+   * Set the ASYNC_LOW_LATENCY flag of the driver through TIOCSSERIAL. USB
+   * adapters such as the FTDI and CP210x otherwise hold the received bytes
+   * for up to 16 ms. The flag is left as is when this is false, and the
+   * drivers that do not have it (e.g. pseudo terminals) are ignored.
+   */
+  bool kernel_flag = {true};
+
+  /**
+   * Let a blocking ::read, configured with VMIN/VTIME, wait for the data
+   * instead of a pselect followed by a ::read. VTIME having a resolution of
+   * 100 ms, the read timeout is rounded down for it, and the rest of a wait,
+   * or a whole timeout under 100 ms, is waited for with a poll of the exact
+   * duration. The timeouts are thus kept as in the default mode.
+   */
+  bool blocking_reads = {true};
+
+  /** The default mode of a port, without any of the above. */
+  static LowLatency None() {
+    LowLatency low_latency;
+    low_latency.kernel_flag = false;
+    low_latency.blocking_reads = false;
+    return low_latency;
+  }
+};
+
 /**
  * Structure for setting the timeout of the serial port, times are
  * in milliseconds.
@@ -170,6 +236,9 @@ class Serial {
 
   using Ptr = std::shared_ptr<Serial>;
 
+  /** The time a byte was received by the port. */
+  using Timestamp = std::chrono::steady_clock::time_point;
+
   //============================================================================
   // P U B L I C   C / D T O R S
 
@@ -200,6 +269,11 @@ class Serial {
    * flowcontrol_none, possible values are: flowcontrol_none,
    * flowcontrol_software, flowcontrol_hardware
    *
+   * \param lock_policy Strategy of the locks serializing the reads and the
+   * writes, default is LockPolicy::kMutex. Use LockPolicy::kNone for a port
+   * that is only used by one thread, and LockPolicy::kSpinThenPark when the
+   * threads sharing the port mostly use short reads and writes.
+   *
    * \throw serial::PortNotOpenedException
    * \throw serial::IOException
    * \throw std::invalid_argument
@@ -207,7 +281,8 @@ class Serial {
   Serial(const std::string &port = "", uint32_t baudrate = 9600,
          Timeout timeout = Timeout(), bytesize_t bytesize = eightbits,
          parity_t parity = parity_none, stopbits_t stopbits = stopbits_one,
-         flowcontrol_t flowcontrol = flowcontrol_none);
+         flowcontrol_t flowcontrol = flowcontrol_none,
+         LockPolicy lock_policy = LockPolicy::kMutex);
 
   // Disable copy constructors
   Serial(const Serial &) = delete;
@@ -292,6 +367,27 @@ class Serial {
    */
   size_t Read(uint8_t *buffer, size_t size);
 
+  /** Read a given amount of bytes and tell when the first one was received.
+   *
+   * The timestamp is taken right after the ::read that returned the first
+   * byte, and moved backwards by the transmission time of the bytes that
+   * this ::read returned from the first one on. It thus estimates when the
+   * first byte started to arrive, assuming the bytes were received back to
+   * back, which lets the caller compensate for the time the data spent
+   * buffered.
+   *
+   * \param buffer An uint8_t array of at least the requested size.
+   * \param size A size_t defining how many bytes to be read.
+   * \param timestamp Set to the time the first byte was received. Left
+   *        untouched if no byte was read.
+   *
+   * \return A size_t representing the number of bytes read.
+   *
+   * \throw serial::PortNotOpenedException
+   * \throw serial::SerialException
+   */
+  size_t Read(uint8_t *buffer, size_t size, Timestamp &timestamp);
+
   /** Read a given amount of bytes from the serial port into a give buffer.
    *
    * \param buffer A reference to a std::vector of uint8_t.
@@ -360,6 +456,17 @@ class Serial {
    */
   std::string ReadLine(size_t size = 65536, std::string eol = "\n");
 
+  /** Reads in a line and tells when its first byte was received.
+   *
+   * \param timestamp Set to the time the first byte of the line was
+   *        received -- see Read(uint8_t *, size_t, Timestamp &). Left
+   *        untouched if no byte was read.
+   *
+   * \see ReadLine(std::string &, size_t, std::string)
+   */
+  size_t ReadLine(std::string &buffer, Timestamp &timestamp,
+                  size_t size = 65536, std::string eol = "\n");
+
   /** Reads in multiple lines until the serial port times out.
    *
    * This requires a timeout > 0 before it can be run. It will read until a
@@ -377,6 +484,60 @@ class Serial {
   std::vector<std::string> ReadLines(size_t size = 65536,
                                      std::string eol = "\n");
 
+  /** Reads in a line only if a complete one has been received.
+   *
+   * This never waits for the device: it drains what has already been
+   * received and returns a line if the delimiter (or the maximum length) was
+   * reached. Otherwise, the partial line stays buffered for the next call.
+   *
+   * \param buffer A std::string reference used to store the data.
+   * \param size A maximum length of a line, defaults to 65536 (2^16)
+   * \param eol A string to match against for the EOL.
+   *
+   * \return A size_t representing the number of bytes read, 0 if no complete
+   *         line was available.
+   *
+   * \throw serial::PortNotOpenedException
+   */
+  size_t TryReadLine(std::string &buffer, size_t size = 65536,
+                     std::string eol = "\n");
+
+  /** Reads in a frame of a protocol handled by the given framer.
+   *
+   * The frame is extracted from the internal read buffer without any copy:
+   * the returned view points in this buffer and stays valid until the next
+   * read on this port. The total read timeout applies to the whole frame.
+   *
+   * \param framer The framer that decodes the protocol -- see atlas::Framer.
+   * \param frame Set to the payload of the frame.
+   *
+   * \return True if a frame was read, false if a timeout occured.
+   *
+   * \throw serial::PortNotOpenedException
+   * \throw serial::SerialException
+   */
+  bool ReadFrame(Framer &framer, FrameView &frame);
+
+  /** Reads in a frame and tells when its first byte was received.
+   *
+   * \param timestamp Set to the time the first byte of the frame, header
+   *        included, was received -- see Read(uint8_t *, size_t, Timestamp &).
+   *        Left untouched if no frame was read.
+   *
+   * \see ReadFrame(Framer &, FrameView &)
+   */
+  bool ReadFrame(Framer &framer, FrameView &frame, Timestamp &timestamp);
+
+  /** Reads in a frame only if a complete one has been received.
+   *
+   * Same as ReadFrame, but never waits for the device.
+   *
+   * \return True if a frame was read.
+   *
+   * \throw serial::PortNotOpenedException
+   */
+  bool TryReadFrame(Framer &framer, FrameView &frame);
+
   /** Write a string to the serial port.
    *
    * \param data A const reference containing the data to be written
@@ -422,6 +583,129 @@ class Serial {
    */
   size_t Write(const std::string &data);
 
+  /** Write several buffers to the serial port with a single vectored write.
+   *
+   * The buffers are sent in order as if they were concatenated, without
+   * copying them. The device is only waited for when its output queue is
+   * full, and the write timeout applies to the total number of bytes.
+   *
+   * \param buffers The buffers to be written to the serial port.
+   *
+   * \param count The number of buffers.
+   *
+   * \return A size_t representing the number of bytes actually written to
+   * the serial port.
+   *
+   * \throw serial::PortNotOpenedException
+   * \throw serial::SerialException
+   * \throw serial::IOException
+   */
+  size_t Write(const iovec *buffers, size_t count);
+
+  /** Write the buffers of a batch to the serial port.
+   *
+   * \see Write(const iovec *, size_t)
+   */
+  size_t Write(const WriteBatch &batch);
+
+  /** Enables the asynchronous write mode.
+   *
+   * The write functions then copy the bytes in a bounded lock-free queue and
+   * return right away, and a background thread writes the queue to the
+   * device. The write timeout only applies to this thread, which retries
+   * until the bytes are written. The mode is disabled when the port is
+   * closed.
+   *
+   * \param capacity The minimum size of the queue in bytes.
+   *
+   * \param policy What a write does when the queue is full.
+   *
+   * \throw serial::PortNotOpenedException
+   */
+  void EnableAsyncWrite(
+      size_t capacity = 65536,
+      AsyncWritePolicy policy = AsyncWritePolicy::kDropNewest);
+
+  /** Disables the asynchronous write mode.
+   *
+   * The queued bytes are given the write timeout to be written before the
+   * background thread is stopped.
+   */
+  void DisableAsyncWrite();
+
+  bool IsAsyncWriteEnabled() const;
+
+  /** Returns a future that becomes ready once every byte written so far is
+   * out of the asynchronous write queue.
+   *
+   * The future holds the exception that stopped the background thread if a
+   * write failed. It is ready right away if the asynchronous write mode is
+   * disabled.
+   */
+  std::future<void> FlushAsync();
+
+  AsyncWriteStats GetAsyncWriteStats() const;
+
+  /** Sets the low latency mode of the port.
+   *
+   * The mode is kept when the port is closed and reopened. Pass
+   * LowLatency::None() to go back to the default mode.
+   *
+   * \throw serial::IOException
+   */
+  void SetLowLatency(const LowLatency &low_latency);
+
+  LowLatency GetLowLatency() const;
+
+  /** Sets the recorder that logs every byte received by the port.
+   *
+   * The bytes are logged as they are returned by the device, before any
+   * line or frame is extracted from them, so a SerialReplayer can feed the
+   * same reads to the parsers later.
+   *
+   * If the recorder fails to log some bytes, the read still returns them
+   * and the recording stops -- see GetRecorderError().
+   *
+   * \param recorder The recorder, or nullptr to stop recording.
+   */
+  void SetRecorder(SerialRecorder::Ptr recorder);
+
+  /** Returns the exception that stopped the recording, or nullptr if the
+   * recorder did not fail since it was set.
+   */
+  std::exception_ptr GetRecorderError() const;
+
+  /** Returns the time spent waiting for and holding the read lock.
+   *
+   * Contention on this lock means that several threads read the port at the
+   * same time.
+   */
+  LockStats GetReadLockStats() const;
+
+  /** Returns the time spent waiting for and holding the write lock. */
+  LockStats GetWriteLockStats() const;
+
+  void ResetLockStats();
+
+  /** Enables or disables the statistics of the port.
+   *
+   * When enabled, the port counts the bytes it transfers, its system calls,
+   * timeouts and EINTR retries, and records the duration of the reads and
+   * writes and the time between two receptions in logarithmic histograms.
+   * The counters are relaxed atomics, so they never take a lock, and a
+   * disabled port only pays for the load of a flag. They are disabled by
+   * default.
+   */
+  void EnableStats(bool enable = true);
+
+  bool IsStatsEnabled() const;
+
+  /** Returns a copy of the statistics, see SerialStatsSnapshot::ToString()
+   * to print them. */
+  SerialStatsSnapshot GetStats() const;
+
+  void ResetStats();
+
   /** Sets the serial port identifier.
    *
    * \param port A const std::string reference containing the address of the
@@ -640,12 +924,18 @@ class Serial {
   bool GetCD();
 
  private:
+  // The reactor multiplexes the file descriptor of the port it watches.
+  friend class SerialReactor;
+
   //============================================================================
   // P R I V A T E  I N N E R   C L A S S
 
   // Pimpl idiom, d_pointer
   class SerialImpl;
 
+  // Drain thread of the asynchronous write mode
+  class AsyncWriter;
+
   // Scoped Lock Classes
   class ScopedReadLock;
   class ScopedWriteLock;
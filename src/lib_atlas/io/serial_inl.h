@@ -36,12 +36,20 @@
 #include <lib_atlas/io/details/serial_impl.h>
 #include <algorithm>
 
-#if !defined(__OpenBSD__)
-#include <alloca.h>
-#endif
-
 namespace atlas {
 
+namespace details {
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Serial::Timestamp ToTimestamp(int64_t steady_ns) {
+  return Serial::Timestamp(
+      std::chrono::duration_cast<Serial::Timestamp::duration>(
+          std::chrono::nanoseconds(steady_ns)));
+}
+
+}  // namespace details
+
 //==============================================================================
 // I N N E R   C L A S S   S E C T I O N
 
@@ -82,9 +90,10 @@ class Serial::ScopedWriteLock {
 ATLAS_INLINE Serial::Serial(const std::string &port, uint32_t baudrate,
                             Timeout timeout, bytesize_t bytesize,
                             parity_t parity, stopbits_t stopbits,
-                            flowcontrol_t flowcontrol)
+                            flowcontrol_t flowcontrol,
+                            LockPolicy lock_policy)
     : pimpl_(new SerialImpl(port, baudrate, bytesize, parity, stopbits,
-                            flowcontrol)) {
+                            flowcontrol, lock_policy)) {
   pimpl_->SetTimeout(timeout);
 }
 
@@ -137,6 +146,19 @@ ATLAS_INLINE size_t Serial::Read(uint8_t *buffer, size_t size) {
   return pimpl_->Read(buffer, size);
 }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::Read(uint8_t *buffer, size_t size,
+                                 Timestamp &timestamp) {
+  ScopedReadLock lock(pimpl_);
+  int64_t receive_ns = 0;
+  size_t bytes_read = pimpl_->Read(buffer, size, &receive_ns);
+  if (bytes_read != 0) {
+    timestamp = details::ToTimestamp(receive_ns);
+  }
+  return bytes_read;
+}
+
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE size_t Serial::Read(std::vector<uint8_t> &buffer, size_t size) {
@@ -172,26 +194,7 @@ ATLAS_INLINE std::string Serial::Read(size_t size) {
 ATLAS_INLINE size_t Serial::ReadLine(std::string &buffer, size_t size,
                                      std::string eol) {
   ScopedReadLock lock(pimpl_);
-  size_t eol_len = eol.length();
-  uint8_t *buffer_ = static_cast<uint8_t *>(alloca(size * sizeof(uint8_t)));
-  size_t read_so_far = 0;
-  while (true) {
-    size_t bytes_read = read_(buffer_ + read_so_far, 1);
-    read_so_far += bytes_read;
-    if (bytes_read == 0) {
-      break;  // Timeout occured on reading 1 byte
-    }
-    if (std::string(
-            reinterpret_cast<const char *>(buffer_ + read_so_far - eol_len),
-            eol_len) == eol) {
-      break;  // EOL found
-    }
-    if (read_so_far == size) {
-      break;  // Reached the maximum read length
-    }
-  }
-  buffer.append(reinterpret_cast<const char *>(buffer_), read_so_far);
-  return read_so_far;
+  return pimpl_->ReadLine(buffer, size, eol);
 }
 
 //------------------------------------------------------------------------------
@@ -202,46 +205,60 @@ ATLAS_INLINE std::string Serial::ReadLine(size_t size, std::string eol) {
   return buffer;
 }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::ReadLine(std::string &buffer, Timestamp &timestamp,
+                                     size_t size, std::string eol) {
+  ScopedReadLock lock(pimpl_);
+  int64_t receive_ns = 0;
+  size_t bytes_read = pimpl_->ReadLine(buffer, size, eol, &receive_ns);
+  if (bytes_read != 0) {
+    timestamp = details::ToTimestamp(receive_ns);
+  }
+  return bytes_read;
+}
+
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE std::vector<std::string> Serial::ReadLines(size_t size,
                                                         std::string eol) {
   ScopedReadLock lock(pimpl_);
-  std::vector<std::string> lines;
-  size_t eol_len = eol.length();
-  uint8_t *buffer_ = static_cast<uint8_t *>(alloca(size * sizeof(uint8_t)));
-  size_t read_so_far = 0;
-  size_t start_of_line = 0;
-  while (read_so_far < size) {
-    size_t bytes_read = read_(buffer_ + read_so_far, 1);
-    read_so_far += bytes_read;
-    if (bytes_read == 0) {
-      if (start_of_line != read_so_far) {
-        lines.push_back(
-            std::string(reinterpret_cast<const char *>(buffer_ + start_of_line),
-                        read_so_far - start_of_line));
-      }
-      break;  // Timeout occured on reading 1 byte
-    }
-    if (std::string(
-            reinterpret_cast<const char *>(buffer_ + read_so_far - eol_len),
-            eol_len) == eol) {
-      // EOL found
-      lines.push_back(
-          std::string(reinterpret_cast<const char *>(buffer_ + start_of_line),
-                      read_so_far - start_of_line));
-      start_of_line = read_so_far;
-    }
-    if (read_so_far == size) {
-      if (start_of_line != read_so_far) {
-        lines.push_back(
-            std::string(reinterpret_cast<const char *>(buffer_ + start_of_line),
-                        read_so_far - start_of_line));
-      }
-      break;  // Reached the maximum read length
-    }
+  return pimpl_->ReadLines(size, eol);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::TryReadLine(std::string &buffer, size_t size,
+                                        std::string eol) {
+  ScopedReadLock lock(pimpl_);
+  return pimpl_->TryReadLine(buffer, size, eol);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::ReadFrame(Framer &framer, FrameView &frame) {
+  ScopedReadLock lock(pimpl_);
+  return pimpl_->ReadFrame(framer, frame);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::ReadFrame(Framer &framer, FrameView &frame,
+                                    Timestamp &timestamp) {
+  ScopedReadLock lock(pimpl_);
+  int64_t receive_ns = 0;
+  if (!pimpl_->ReadFrame(framer, frame, &receive_ns)) {
+    return false;
   }
-  return lines;
+  timestamp = details::ToTimestamp(receive_ns);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::TryReadFrame(Framer &framer, FrameView &frame) {
+  ScopedReadLock lock(pimpl_);
+  return pimpl_->TryReadFrame(framer, frame);
 }
 
 //------------------------------------------------------------------------------
@@ -265,6 +282,121 @@ ATLAS_INLINE size_t Serial::Write(const uint8_t *data, size_t size) {
   return write_(data, size);
 }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::Write(const iovec *buffers, size_t count) {
+  ScopedWriteLock lock(pimpl_);
+  return pimpl_->Write(buffers, count);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::Write(const WriteBatch &batch) {
+  return Write(batch.Data(), batch.Count());
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::EnableAsyncWrite(size_t capacity,
+                                           AsyncWritePolicy policy) {
+  ScopedWriteLock lock(pimpl_);
+  pimpl_->EnableAsyncWrite(capacity, policy);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::DisableAsyncWrite() {
+  ScopedWriteLock lock(pimpl_);
+  pimpl_->DisableAsyncWrite();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::IsAsyncWriteEnabled() const {
+  ScopedWriteLock lock(pimpl_);
+  return pimpl_->IsAsyncWriteEnabled();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::future<void> Serial::FlushAsync() {
+  ScopedWriteLock lock(pimpl_);
+  return pimpl_->FlushAsync();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE AsyncWriteStats Serial::GetAsyncWriteStats() const {
+  ScopedWriteLock lock(pimpl_);
+  return pimpl_->GetAsyncWriteStats();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SetLowLatency(const LowLatency &low_latency) {
+  // The reads must not use the descriptor that is being replaced.
+  ScopedReadLock lock(pimpl_);
+  pimpl_->SetLowLatency(low_latency);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LowLatency Serial::GetLowLatency() const {
+  return pimpl_->GetLowLatency();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SetRecorder(SerialRecorder::Ptr recorder) {
+  ScopedReadLock lock(pimpl_);
+  pimpl_->SetRecorder(std::move(recorder));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::exception_ptr Serial::GetRecorderError() const {
+  ScopedReadLock lock(pimpl_);
+  return pimpl_->GetRecorderError();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LockStats Serial::GetReadLockStats() const {
+  return pimpl_->GetReadLockStats();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LockStats Serial::GetWriteLockStats() const {
+  return pimpl_->GetWriteLockStats();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::ResetLockStats() { pimpl_->ResetLockStats(); }
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::EnableStats(bool enable) {
+  pimpl_->EnableStats(enable);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::IsStatsEnabled() const {
+  return pimpl_->IsStatsEnabled();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialStatsSnapshot Serial::GetStats() const {
+  return pimpl_->GetStats();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::ResetStats() { pimpl_->ResetStats(); }
+
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE size_t Serial::write_(const uint8_t *data, size_t length) {
@@ -293,6 +425,8 @@ ATLAS_INLINE std::string Serial::GetPort() const { return pimpl_->GetPort(); }
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE void Serial::SetTimeout(const Timeout &timeout) {
+  // The writers and the drain thread of the async writes use the timeout.
+  ScopedWriteLock lock(pimpl_);
   pimpl_->SetTimeout(timeout);
 }
 
@@ -0,0 +1,244 @@
+/**
+ * \file	serial_reactor.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_REACTOR_H_
+#define LIB_ATLAS_IO_SERIAL_REACTOR_H_
+
+#include <lib_atlas/io/serial.h>
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/runnable.h>
+#include <lib_atlas/pattern/thread_pool.h>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace atlas {
+
+/**
+ * Multiplexes several Serial ports on a single epoll set.
+ *
+ * Instead of blocking one thread per port in Serial::WaitReadable, the ports
+ * are registered to the reactor with the callbacks that must be called when
+ * they become readable or writable. The ports keep their own file descriptor
+ * and termios configuration, the reactor only watches them.
+ *
+ * The events can be dispatched by calling Poll() from any thread, or by
+ * starting the reactor (see Runnable::Start()) so it polls on its own thread.
+ * If a ThreadPool is given on construction, the callbacks are executed on the
+ * pool. A port is never dispatched twice concurrently.
+ *
+ * A port whose callback throws (e.g. because the device was disconnected) is
+ * unregistered and the exception is passed to its error callback.
+ *
+ * Sample usage:
+ *
+ * atlas::SerialReactor reactor;
+ * reactor.RegisterLineHandler(imu, [](atlas::Serial &, const std::string &l) {
+ *   ParseImuSentence(l);
+ * }, "\r\n");
+ * reactor.RegisterLineHandler(dvl, [](atlas::Serial &, const std::string &l) {
+ *   ParseDvlSentence(l);
+ * });
+ * reactor.Start();
+ */
+class SerialReactor : public Runnable {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<SerialReactor>;
+
+  using EventCallback = std::function<void(Serial &)>;
+
+  using LineCallback = std::function<void(Serial &, const std::string &)>;
+
+  using FrameCallback = std::function<void(Serial &, const FrameView &)>;
+
+  using ErrorCallback = std::function<void(Serial &, const std::exception &)>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param pool If not null, the callbacks will be executed on this pool
+   *        instead of the thread that polls the reactor.
+   */
+  explicit SerialReactor(ThreadPool *pool = nullptr);
+
+  virtual ~SerialReactor() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Start watching an opened port.
+   *
+   * The port must stay alive and opened until it is unregistered.
+   *
+   * \param port The port to watch.
+   * \param on_readable Called when the port has data to read.
+   * \param on_writable Called when the port can be written, only while the
+   *        writable events are enabled -- see SetWatchWritable().
+   * \param on_error Called with the exception thrown by a callback before the
+   *        port is unregistered.
+   *
+   * \throw std::invalid_argument If the port is already registered.
+   * \throw atlas::PortNotOpenedException
+   * \throw atlas::IOException
+   */
+  void Register(Serial &port, EventCallback on_readable,
+                EventCallback on_writable = EventCallback(),
+                ErrorCallback on_error = ErrorCallback());
+
+  /**
+   * Watch a port that sends lines of text.
+   *
+   * on_line is called once per complete line received (EOL included), the
+   * partial lines are kept in the port until they are completed.
+   */
+  void RegisterLineHandler(Serial &port, LineCallback on_line,
+                           const std::string &eol = "\n",
+                           ErrorCallback on_error = ErrorCallback());
+
+  /**
+   * Watch a port that sends the frames of a binary protocol.
+   *
+   * on_frame is called once per frame extracted by the framer. The frame
+   * is only valid during the call -- see Serial::ReadFrame().
+   */
+  void RegisterFrameHandler(Serial &port, Framer::Ptr framer,
+                            FrameCallback on_frame,
+                            ErrorCallback on_error = ErrorCallback());
+
+  /**
+   * Stop watching a port. Waits for the callbacks of the port that are being
+   * executed to return, unless it is called by one of them, so the port can
+   * be destroyed right after. A dispatch still queued on the ThreadPool is
+   * cancelled.
+   *
+   * \throw std::invalid_argument If the port is not registered.
+   */
+  void Unregister(Serial &port);
+
+  /**
+   * Enable or disable the writable events of a port. They are disabled by
+   * default, since a port is writable most of the time.
+   */
+  void SetWatchWritable(Serial &port, bool watch);
+
+  /**
+   * \return The number of ports currently registered.
+   */
+  size_t PortCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * Wait for events on the registered ports and dispatch them.
+   *
+   * \param timeout The maximum time to wait in milliseconds, -1 to block.
+   * \return The number of events that were dispatched.
+   */
+  size_t Poll(int timeout);
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  void Run() override;
+
+ private:
+  //============================================================================
+  // P R I V A T E   I N N E R   C L A S S
+
+  struct Handler {
+    Serial *port;
+    int fd;
+    EventCallback on_readable;
+    EventCallback on_writable;
+    ErrorCallback on_error;
+    bool watch_writable;
+    // True from the event until the dispatch of the handler is completed.
+    bool in_flight;
+    // The thread executing the callbacks of the handler, if any.
+    std::thread::id thread;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Dispatch the events of a handler on the calling thread, unless it was
+   * unregistered since, then Release() it.
+   */
+  void Execute(const std::shared_ptr<Handler> &handler, uint32_t events);
+
+  void Dispatch(const std::shared_ptr<Handler> &handler, uint32_t events);
+
+  /**
+   * Mark the end of the dispatch of a handler and re-enable its events if it
+   * is still registered.
+   */
+  void Release(const std::shared_ptr<Handler> &handler);
+
+  /**
+   * Update the events watched for a handler in the epoll set.
+   *
+   * \return False if the file descriptor is not in the epoll set anymore.
+   */
+  bool Arm(const Handler &handler, int operation);
+
+  void Remove(const std::shared_ptr<Handler> &handler);
+
+  std::map<int, std::shared_ptr<Handler>>::iterator Find(const Serial &port);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  /** Time between two checks of MustStop() in the reactor thread. */
+  static const int kPollPeriodMs = 100;
+
+  int epoll_fd_;
+
+  ThreadPool *pool_;
+
+  std::map<int, std::shared_ptr<Handler>> handlers_;
+
+  mutable std::mutex handlers_mutex_;
+
+  /** Number of dispatches started by Poll() and not completed. */
+  size_t in_flight_count_;
+
+  /** Notified whenever a dispatch is completed. */
+  std::condition_variable idle_condition_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/serial_reactor_inl.h>
+
+#endif  // LIB_ATLAS_IO_SERIAL_REACTOR_H_
@@ -0,0 +1,324 @@
+/**
+ * \file	serial_reactor_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_REACTOR_H_
+#error This file may only be included from serial_reactor.h
+#endif
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <stdexcept>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialReactor::SerialReactor(ThreadPool *pool)
+    : Runnable(),
+      epoll_fd_(epoll_create1(EPOLL_CLOEXEC)),
+      pool_(pool),
+      handlers_(),
+      handlers_mutex_(),
+      in_flight_count_(0),
+      idle_condition_() {
+  if (epoll_fd_ == -1) {
+    ATLAS_THROW(IOException, errno);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialReactor::~SerialReactor() ATLAS_NOEXCEPT {
+  if (IsRunning()) {
+    Stop();
+  }
+  {
+    std::unique_lock<std::mutex> lock(handlers_mutex_);
+    idle_condition_.wait(lock, [this] { return in_flight_count_ == 0; });
+  }
+  ::close(epoll_fd_);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::Register(Serial &port,
+                                          EventCallback on_readable,
+                                          EventCallback on_writable,
+                                          ErrorCallback on_error) {
+  if (!port.IsOpen()) {
+    throw PortNotOpenedException("SerialReactor::Register");
+  }
+  auto handler = std::make_shared<Handler>();
+  handler->port = &port;
+  handler->fd = port.pimpl_->GetFileDescriptor();
+  handler->on_readable = std::move(on_readable);
+  handler->on_writable = std::move(on_writable);
+  handler->on_error = std::move(on_error);
+  handler->watch_writable = false;
+  handler->in_flight = false;
+  handler->thread = std::thread::id();
+
+  std::lock_guard<std::mutex> lock(handlers_mutex_);
+  if (handlers_.count(handler->fd) != 0) {
+    throw std::invalid_argument("The port is already registered.");
+  }
+  if (!Arm(*handler, EPOLL_CTL_ADD)) {
+    ATLAS_THROW(IOException, errno);
+  }
+  handlers_[handler->fd] = handler;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::RegisterLineHandler(Serial &port,
+                                                     LineCallback on_line,
+                                                     const std::string &eol,
+                                                     ErrorCallback on_error) {
+  // The line is kept between calls so its storage is reused.
+  auto line = std::make_shared<std::string>();
+  Register(port,
+           [on_line, eol, line](Serial &serial) {
+             line->clear();
+             while (serial.TryReadLine(*line, 65536, eol) != 0) {
+               on_line(serial, *line);
+               line->clear();
+             }
+           },
+           EventCallback(), std::move(on_error));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::RegisterFrameHandler(Serial &port,
+                                                      Framer::Ptr framer,
+                                                      FrameCallback on_frame,
+                                                      ErrorCallback on_error) {
+  if (framer == nullptr) {
+    throw std::invalid_argument("The framer cannot be null.");
+  }
+  Register(port,
+           [framer, on_frame](Serial &serial) {
+             FrameView frame;
+             while (serial.TryReadFrame(*framer, frame)) {
+               on_frame(serial, frame);
+             }
+           },
+           EventCallback(), std::move(on_error));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::Unregister(Serial &port) {
+  std::unique_lock<std::mutex> lock(handlers_mutex_);
+  auto it = Find(port);
+  if (it == handlers_.end()) {
+    throw std::invalid_argument("The port is not registered.");
+  }
+  std::shared_ptr<Handler> handler = it->second;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, it->first, nullptr);
+  handlers_.erase(it);
+  // A dispatch that did not start yet is skipped by Execute(), waiting for
+  // it could deadlock a pool whose workers are all busy.
+  if (handler->thread != std::this_thread::get_id()) {
+    idle_condition_.wait(
+        lock, [&handler] { return handler->thread == std::thread::id(); });
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::SetWatchWritable(Serial &port, bool watch) {
+  std::lock_guard<std::mutex> lock(handlers_mutex_);
+  auto it = Find(port);
+  if (it == handlers_.end()) {
+    throw std::invalid_argument("The port is not registered.");
+  }
+  it->second->watch_writable = watch;
+  // A handler being dispatched is re-armed by Release().
+  if (!it->second->in_flight) {
+    Arm(*it->second, EPOLL_CTL_MOD);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SerialReactor::PortCount() const ATLAS_NOEXCEPT {
+  std::lock_guard<std::mutex> lock(handlers_mutex_);
+  return handlers_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SerialReactor::Poll(int timeout) {
+  epoll_event events[16];
+  int count = epoll_wait(epoll_fd_, events, 16, timeout);
+  if (count < 0) {
+    if (errno == EINTR) {
+      return 0;
+    }
+    ATLAS_THROW(IOException, errno);
+  }
+
+  size_t dispatched = 0;
+  for (int i = 0; i < count; ++i) {
+    std::shared_ptr<Handler> handler;
+    {
+      std::lock_guard<std::mutex> lock(handlers_mutex_);
+      auto it = handlers_.find(events[i].data.fd);
+      if (it == handlers_.end()) {
+        // Unregistered since epoll_wait returned.
+        continue;
+      }
+      handler = it->second;
+      handler->in_flight = true;
+      ++in_flight_count_;
+    }
+    uint32_t event = events[i].events;
+    if (pool_ != nullptr) {
+      pool_->Post([this, handler, event] { Execute(handler, event); });
+    } else {
+      Execute(handler, event);
+    }
+    ++dispatched;
+  }
+  return dispatched;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::Run() {
+  while (!MustStop()) {
+    Poll(kPollPeriodMs);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::Execute(
+    const std::shared_ptr<Handler> &handler, uint32_t events) {
+  bool registered = false;
+  {
+    std::lock_guard<std::mutex> lock(handlers_mutex_);
+    auto it = handlers_.find(handler->fd);
+    registered = it != handlers_.end() && it->second == handler;
+    if (registered) {
+      handler->thread = std::this_thread::get_id();
+    }
+  }
+  if (registered) {
+    Dispatch(handler, events);
+  }
+  Release(handler);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::Dispatch(
+    const std::shared_ptr<Handler> &handler, uint32_t events) {
+  try {
+    // Drain what was received before a hang up.
+    if ((events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && handler->on_readable) {
+      handler->on_readable(*handler->port);
+    }
+    if ((events & EPOLLOUT) && handler->on_writable) {
+      handler->on_writable(*handler->port);
+    }
+    if (events & (EPOLLHUP | EPOLLERR)) {
+      throw SerialException(
+          "device reports a hang up or an error (device disconnected?)");
+    }
+  } catch (const std::exception &e) {
+    Remove(handler);
+    if (handler->on_error) {
+      handler->on_error(*handler->port, e);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::Release(
+    const std::shared_ptr<Handler> &handler) {
+  std::lock_guard<std::mutex> lock(handlers_mutex_);
+  handler->in_flight = false;
+  handler->thread = std::thread::id();
+  auto it = handlers_.find(handler->fd);
+  if (it != handlers_.end() && it->second == handler) {
+    Arm(*handler, EPOLL_CTL_MOD);
+  }
+  --in_flight_count_;
+  // Unregister() waits for a given handler, the destructor for all of them.
+  idle_condition_.notify_all();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool SerialReactor::Arm(const Handler &handler, int operation) {
+  epoll_event event = {};
+  event.events = EPOLLIN;
+  if (handler.watch_writable) {
+    event.events |= EPOLLOUT;
+  }
+  // Disable the events of a port until the ThreadPool is done with it so it
+  // cannot be dispatched on two workers at the same time.
+  if (pool_ != nullptr) {
+    event.events |= EPOLLONESHOT;
+  }
+  event.data.fd = handler.fd;
+  return epoll_ctl(epoll_fd_, operation, handler.fd, &event) == 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::Remove(
+    const std::shared_ptr<Handler> &handler) {
+  std::lock_guard<std::mutex> lock(handlers_mutex_);
+  auto it = handlers_.find(handler->fd);
+  if (it != handlers_.end() && it->second == handler) {
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, handler->fd, nullptr);
+    handlers_.erase(it);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::map<int, std::shared_ptr<SerialReactor::Handler>>::iterator
+SerialReactor::Find(const Serial &port) {
+  for (auto it = handlers_.begin(); it != handlers_.end(); ++it) {
+    if (it->second->port == &port) {
+      return it;
+    }
+  }
+  return handlers_.end();
+}
+
+}  // namespace atlas
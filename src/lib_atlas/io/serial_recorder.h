@@ -0,0 +1,121 @@
+/**
+ * \file	serial_recorder.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_RECORDER_H_
+#define LIB_ATLAS_IO_SERIAL_RECORDER_H_
+
+#include <lib_atlas/macros.h>
+#include <stdint.h>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace atlas {
+
+/**
+ * Writes the bytes received by a serial port in a binary log, along with the
+ * time they were received, so they can be replayed later by a
+ * SerialReplayer -- see Serial::SetRecorder().
+ *
+ * Every ::read that returned data is a record of the log. The file starts
+ * with the Magic() signature, followed by the records, each made of the time
+ * elapsed since the previous record in nanoseconds (the first one counting
+ * from the creation of the recorder), the number of bytes and the bytes.
+ * The two integers are LEB128 varints, so a record of a few bytes takes a
+ * few bytes of overhead.
+ *
+ * A recorder must only be given to a single port.
+ */
+class SerialRecorder {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<SerialRecorder>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \throw IOException If the file cannot be created.
+   */
+  explicit SerialRecorder(const std::string &path);
+
+  ~SerialRecorder() ATLAS_NOEXCEPT;
+
+  SerialRecorder(const SerialRecorder &) = delete;
+
+  SerialRecorder &operator=(const SerialRecorder &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Append a record to the log.
+   *
+   * \param time_ns The NanoTimer::Now() time the bytes were received.
+   */
+  void Record(int64_t time_ns, const uint8_t *data, size_t size);
+
+  void Flush();
+
+  uint64_t GetRecordCount() const ATLAS_NOEXCEPT;
+
+  uint64_t GetByteCount() const ATLAS_NOEXCEPT;
+
+  /** The signature at the beginning of the log files, version included. */
+  static const std::string &Magic();
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::ofstream file_;
+
+  int64_t last_time_ns_;
+
+  uint64_t record_count_;
+
+  uint64_t byte_count_;
+};
+
+namespace details {
+
+void WriteVarint(std::ostream &stream, uint64_t value);
+
+/**
+ * \return False if the stream ended before the end of the varint.
+ */
+bool ReadVarint(std::istream &stream, uint64_t &value);
+
+}  // namespace details
+
+}  // namespace atlas
+
+#include <lib_atlas/io/serial_recorder_inl.h>
+
+#endif  // LIB_ATLAS_IO_SERIAL_RECORDER_H_
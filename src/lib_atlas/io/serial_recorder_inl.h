@@ -0,0 +1,138 @@
+/**
+ * \file	serial_recorder_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_RECORDER_H_
+#error This file may only be included from serial_recorder.h
+#endif
+
+#include <lib_atlas/exceptions.h>
+#include <lib_atlas/sys/timer.h>
+#include <algorithm>
+
+namespace atlas {
+
+namespace details {
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void WriteVarint(std::ostream &stream, uint64_t value) {
+  char bytes[10];
+  size_t size = 0;
+  do {
+    uint8_t byte = static_cast<uint8_t>(value & 0x7F);
+    value >>= 7;
+    bytes[size++] = static_cast<char>(value != 0 ? byte | 0x80 : byte);
+  } while (value != 0);
+  stream.write(bytes, size);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ReadVarint(std::istream &stream, uint64_t &value) {
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int byte = stream.get();
+    if (byte == std::char_traits<char>::eof()) {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace details
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialRecorder::SerialRecorder(const std::string &path)
+    : file_(path, std::ios::binary | std::ios::trunc),
+      last_time_ns_(NanoTimer::Now()),
+      record_count_(0),
+      byte_count_(0) {
+  if (!file_.is_open()) {
+    ATLAS_THROW(IOException, "Could not create the serial log " << path);
+  }
+  file_.write(Magic().data(), Magic().size());
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialRecorder::~SerialRecorder() ATLAS_NOEXCEPT {
+  file_.flush();
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialRecorder::Record(int64_t time_ns, const uint8_t *data,
+                                         size_t size) {
+  // The times are monotonic, but a record may be stamped before the
+  // previous one was written.
+  uint64_t delta_ns =
+      time_ns > last_time_ns_ ? static_cast<uint64_t>(time_ns - last_time_ns_)
+                              : 0;
+  last_time_ns_ = std::max(time_ns, last_time_ns_);
+  details::WriteVarint(file_, delta_ns);
+  details::WriteVarint(file_, size);
+  file_.write(reinterpret_cast<const char *>(data), size);
+  if (!file_) {
+    ATLAS_THROW(IOException, "Could not write the serial log");
+  }
+  ++record_count_;
+  byte_count_ += size;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialRecorder::Flush() { file_.flush(); }
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const std::string &SerialRecorder::Magic() {
+  static const std::string magic("ATLSREC1");
+  return magic;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t SerialRecorder::GetRecordCount() const ATLAS_NOEXCEPT {
+  return record_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t SerialRecorder::GetByteCount() const ATLAS_NOEXCEPT {
+  return byte_count_;
+}
+
+}  // namespace atlas
@@ -0,0 +1,179 @@
+/**
+ * \file	serial_replayer.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_REPLAYER_H_
+#define LIB_ATLAS_IO_SERIAL_REPLAYER_H_
+
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/runnable.h>
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * Replays a log written by a SerialRecorder, so the code that parses the
+ * data of a device can be run and benchmarked without the device.
+ *
+ * The log is either written in a pseudo terminal, from the thread of the
+ * replayer, which a Serial opens like the real port (see OpenPty()), or
+ * given directly to a callback with Replay(), which leaves the kernel out
+ * of a benchmark of the parsers. The records are delivered at the pace they
+ * were received, or as fast as possible.
+ *
+ * Sample usage:
+ *
+ * atlas::SerialReplayer replayer("imu.log");
+ * atlas::Serial serial(replayer.OpenPty(), 115200);
+ * replayer.Start();
+ * while (!replayer.IsFinished() || serial.Available()) { ... }
+ */
+class SerialReplayer : public Runnable {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<SerialReplayer>;
+
+  enum class Speed {
+    /** Keep the time between the records. */
+    kOriginal,
+    /** Deliver the records back to back. */
+    kMaximum
+  };
+
+  using Sink = std::function<void(const uint8_t *data, size_t size)>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * Load the whole log in memory.
+   *
+   * \throw IOException If the log cannot be read.
+   * \throw CorruptedDataException If the file is not a complete log.
+   */
+  explicit SerialReplayer(const std::string &path,
+                          Speed speed = Speed::kOriginal);
+
+  ~SerialReplayer() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Create the pseudo terminal the log is written into once the replayer is
+   * started.
+   *
+   * \return The path of the terminal to give to a Serial.
+   * \throw IOException
+   */
+  std::string OpenPty();
+
+  /**
+   * Start the thread writing the log in the pseudo terminal.
+   *
+   * \throw std::logic_error If OpenPty was not called.
+   */
+  void Start();
+
+  /**
+   * Give every record to the sink, from the calling thread.
+   */
+  void Replay(const Sink &sink);
+
+  /**
+   * \return True once the thread wrote the whole log in the pseudo terminal.
+   */
+  bool IsFinished() const ATLAS_NOEXCEPT;
+
+  size_t GetRecordCount() const ATLAS_NOEXCEPT;
+
+  size_t GetByteCount() const ATLAS_NOEXCEPT;
+
+  /** \return The time between the creation of the recorder and the last
+   *          record. */
+  int64_t GetDurationNs() const ATLAS_NOEXCEPT;
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  void Run() override;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  struct Record {
+    /** Time since the creation of the recorder. */
+    int64_t time_ns;
+    size_t offset;
+    size_t size;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Sleep until the time of the record with the kOriginal speed, or until
+   * the replayer is stopped.
+   */
+  void WaitFor(const Record &record,
+               std::chrono::steady_clock::time_point start) const;
+
+  void ClosePty() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  /** Maximum time the thread sleeps before checking MustStop(). */
+  static const int kPollPeriodMs = 100;
+
+  Speed speed_;
+
+  /** The bytes of all the records, back to back. */
+  std::vector<uint8_t> data_;
+
+  std::vector<Record> records_;
+
+  int master_fd_;
+
+  /** Kept open so the terminal is not hung up between two Serial. */
+  int slave_fd_;
+
+  std::atomic<bool> finished_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/serial_replayer_inl.h>
+
+#endif  // LIB_ATLAS_IO_SERIAL_REPLAYER_H_
@@ -0,0 +1,235 @@
+/**
+ * \file	serial_replayer_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_REPLAYER_H_
+#error This file may only be included from serial_replayer.h
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <lib_atlas/exceptions.h>
+#include <lib_atlas/io/serial_recorder.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialReplayer::SerialReplayer(const std::string &path,
+                                            Speed speed)
+    : Runnable(),
+      speed_(speed),
+      data_(),
+      records_(),
+      master_fd_(-1),
+      slave_fd_(-1),
+      finished_(false) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    ATLAS_THROW(IOException, "Could not open the serial log " << path);
+  }
+  std::string magic(SerialRecorder::Magic().size(), '\0');
+  file.read(&magic[0], magic.size());
+  if (!file || magic != SerialRecorder::Magic()) {
+    ATLAS_THROW(CorruptedDataException, "Reading the serial log " << path);
+  }
+
+  int64_t time_ns = 0;
+  uint64_t delta_ns = 0;
+  while (details::ReadVarint(file, delta_ns)) {
+    uint64_t size = 0;
+    if (!details::ReadVarint(file, size)) {
+      ATLAS_THROW(CorruptedDataException, "Reading the serial log " << path);
+    }
+    time_ns += static_cast<int64_t>(delta_ns);
+    Record record = {time_ns, data_.size(), static_cast<size_t>(size)};
+    data_.resize(data_.size() + record.size);
+    file.read(reinterpret_cast<char *>(&data_[record.offset]), record.size);
+    if (static_cast<size_t>(file.gcount()) != record.size) {
+      ATLAS_THROW(CorruptedDataException, "Reading the serial log " << path);
+    }
+    records_.push_back(record);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialReplayer::~SerialReplayer() ATLAS_NOEXCEPT {
+  if (IsRunning()) {
+    Stop();
+  }
+  ClosePty();
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::string SerialReplayer::OpenPty() {
+  ClosePty();
+  master_fd_ = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master_fd_ == -1 || grantpt(master_fd_) == -1 ||
+      unlockpt(master_fd_) == -1) {
+    int error = errno;
+    ClosePty();
+    ATLAS_THROW(IOException, error);
+  }
+  std::string name(ptsname(master_fd_));
+  slave_fd_ = ::open(name.c_str(), O_RDWR | O_NOCTTY);
+  if (slave_fd_ == -1) {
+    int error = errno;
+    ClosePty();
+    ATLAS_THROW(IOException, error);
+  }
+  // The bytes written before the Serial opens the terminal must not be
+  // echoed or edited by the line discipline.
+  termios options;
+  if (tcgetattr(slave_fd_, &options) == 0) {
+    cfmakeraw(&options);
+    tcsetattr(slave_fd_, TCSANOW, &options);
+  }
+  int flags = fcntl(master_fd_, F_GETFL);
+  fcntl(master_fd_, F_SETFL, flags | O_NONBLOCK);
+  return name;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReplayer::Replay(const Sink &sink) {
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &record : records_) {
+    WaitFor(record, start);
+    sink(&data_[record.offset], record.size);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReplayer::Start() {
+  // Checked here, as an exception thrown by Run would terminate the program.
+  if (master_fd_ == -1) {
+    throw std::logic_error("OpenPty must be called before Start.");
+  }
+  Runnable::Start();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReplayer::Run() {
+  if (master_fd_ == -1) {
+    // Started through the Runnable interface without a terminal.
+    finished_ = true;
+    return;
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &record : records_) {
+    WaitFor(record, start);
+    size_t written = 0;
+    while (written < record.size) {
+      if (MustStop()) {
+        return;
+      }
+      ssize_t result = ::write(master_fd_, &data_[record.offset + written],
+                               record.size - written);
+      if (result > 0) {
+        written += static_cast<size_t>(result);
+      } else if (result == -1 && errno != EINTR) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+          // The thread cannot report the error, the replay ends early.
+          finished_ = true;
+          return;
+        }
+        // The terminal is full until the port reads it.
+        pollfd fd = {master_fd_, POLLOUT, 0};
+        poll(&fd, 1, kPollPeriodMs);
+      }
+    }
+  }
+  finished_ = true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool SerialReplayer::IsFinished() const ATLAS_NOEXCEPT {
+  return finished_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SerialReplayer::GetRecordCount() const ATLAS_NOEXCEPT {
+  return records_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SerialReplayer::GetByteCount() const ATLAS_NOEXCEPT {
+  return data_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t SerialReplayer::GetDurationNs() const ATLAS_NOEXCEPT {
+  return records_.empty() ? 0 : records_.back().time_ns;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReplayer::WaitFor(
+    const Record &record, std::chrono::steady_clock::time_point start) const {
+  if (speed_ == Speed::kMaximum) {
+    return;
+  }
+  auto target = start + std::chrono::nanoseconds(record.time_ns);
+  auto period = std::chrono::milliseconds(static_cast<int>(kPollPeriodMs));
+  while (!MustStop() && std::chrono::steady_clock::now() < target) {
+    std::this_thread::sleep_until(
+        std::min(target, std::chrono::steady_clock::now() + period));
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReplayer::ClosePty() ATLAS_NOEXCEPT {
+  if (slave_fd_ != -1) {
+    ::close(slave_fd_);
+    slave_fd_ = -1;
+  }
+  if (master_fd_ != -1) {
+    ::close(master_fd_);
+    master_fd_ = -1;
+  }
+}
+
+}  // namespace atlas
@@ -0,0 +1,173 @@
+/**
+ * \file	serial_stats.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_STATS_H_
+#define LIB_ATLAS_IO_SERIAL_STATS_H_
+
+#include <lib_atlas/macros.h>
+#include <lib_atlas/sys/latency_histogram.h>
+#include <stdint.h>
+#include <atomic>
+#include <string>
+
+namespace atlas {
+
+/**
+ * A copy of the statistics of a Serial port -- see Serial::GetStats().
+ */
+struct SerialStatsSnapshot {
+  uint64_t bytes_read = {0};
+
+  uint64_t bytes_written = {0};
+
+  /** Number of read, write and select calls. */
+  uint64_t syscalls = {0};
+
+  uint64_t read_timeouts = {0};
+
+  uint64_t write_timeouts = {0};
+
+  /** Number of system calls that were interrupted by a signal. */
+  uint64_t eintr_retries = {0};
+
+  /** Duration of the Read, ReadLine and ReadFrame calls. */
+  LatencyHistogramSnapshot read_latency;
+
+  /** Duration of the Write calls. */
+  LatencyHistogramSnapshot write_latency;
+
+  /** Time between two reads that received data. */
+  LatencyHistogramSnapshot inter_byte_gap;
+
+  std::string ToString() const;
+};
+
+/**
+ * The statistics of a Serial port.
+ *
+ * Every counter is a relaxed atomic, so recording never takes a lock. When
+ * the statistics are disabled, recording only costs the load of a flag.
+ */
+class SerialStats {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  /**
+   * Records the duration of its scope in the read or the write histogram.
+   */
+  class LatencyScope;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  SerialStats() ATLAS_NOEXCEPT;
+
+  SerialStats(const SerialStats &) = delete;
+
+  SerialStats &operator=(const SerialStats &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  void SetEnabled(bool enabled) ATLAS_NOEXCEPT;
+
+  bool IsEnabled() const ATLAS_NOEXCEPT;
+
+  SerialStatsSnapshot Snapshot() const;
+
+  void Reset() ATLAS_NOEXCEPT;
+
+  void AddSyscall() ATLAS_NOEXCEPT;
+
+  void AddEintrRetry() ATLAS_NOEXCEPT;
+
+  void AddReadTimeout() ATLAS_NOEXCEPT;
+
+  void AddWriteTimeout() ATLAS_NOEXCEPT;
+
+  /**
+   * Count bytes received by the device and record the gap since the
+   * previous reception.
+   */
+  void AddBytesRead(size_t count) ATLAS_NOEXCEPT;
+
+  void AddBytesWritten(size_t count) ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Add a value to a counter if the statistics are enabled.
+   */
+  void Add(std::atomic<uint64_t> &counter, uint64_t value) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::atomic<bool> enabled_;
+
+  std::atomic<uint64_t> bytes_read_;
+  std::atomic<uint64_t> bytes_written_;
+  std::atomic<uint64_t> syscalls_;
+  std::atomic<uint64_t> read_timeouts_;
+  std::atomic<uint64_t> write_timeouts_;
+  std::atomic<uint64_t> eintr_retries_;
+
+  /** Time of the last reception, 0 if nothing was received yet. */
+  std::atomic<int64_t> last_receive_ns_;
+
+  LatencyHistogram read_latency_;
+  LatencyHistogram write_latency_;
+  LatencyHistogram inter_byte_gap_;
+};
+
+//------------------------------------------------------------------------------
+//
+class SerialStats::LatencyScope {
+ public:
+  enum class Operation { kRead, kWrite };
+
+  LatencyScope(SerialStats &stats, Operation operation) ATLAS_NOEXCEPT;
+
+  ~LatencyScope() ATLAS_NOEXCEPT;
+
+  LatencyScope(const LatencyScope &) = delete;
+
+  LatencyScope &operator=(const LatencyScope &) = delete;
+
+ private:
+  /** Null if the statistics are disabled. */
+  LatencyHistogram *histogram_;
+
+  int64_t start_ns_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/serial_stats_inl.h>
+
+#endif  // LIB_ATLAS_IO_SERIAL_STATS_H_
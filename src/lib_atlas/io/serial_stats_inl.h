@@ -0,0 +1,191 @@
+/**
+ * \file	serial_stats_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_STATS_H_
+#error This file may only be included from serial_stats.h
+#endif
+
+#include <lib_atlas/io/formatter.h>
+#include <lib_atlas/sys/timer.h>
+
+namespace atlas {
+
+//==============================================================================
+// S E R I A L   S T A T S   S N A P S H O T   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::string SerialStatsSnapshot::ToString() const {
+  return Format(
+             "bytes read: {0}, bytes written: {1}, syscalls: {2}\n"
+             "read timeouts: {3}, write timeouts: {4}, EINTR retries: {5}\n",
+             bytes_read, bytes_written, syscalls, read_timeouts,
+             write_timeouts, eintr_retries) +
+         "read latency: " + read_latency.ToString() + "write latency: " +
+         write_latency.ToString() + "inter-byte gap: " +
+         inter_byte_gap.ToString();
+}
+
+//==============================================================================
+// S E R I A L   S T A T S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialStats::SerialStats() ATLAS_NOEXCEPT
+    : enabled_(false),
+      bytes_read_(0),
+      bytes_written_(0),
+      syscalls_(0),
+      read_timeouts_(0),
+      write_timeouts_(0),
+      eintr_retries_(0),
+      last_receive_ns_(0),
+      read_latency_(),
+      write_latency_(),
+      inter_byte_gap_() {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialStats::SetEnabled(bool enabled) ATLAS_NOEXCEPT {
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool SerialStats::IsEnabled() const ATLAS_NOEXCEPT {
+  return enabled_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialStatsSnapshot SerialStats::Snapshot() const {
+  SerialStatsSnapshot snapshot;
+  snapshot.bytes_read = bytes_read_.load(std::memory_order_relaxed);
+  snapshot.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+  snapshot.syscalls = syscalls_.load(std::memory_order_relaxed);
+  snapshot.read_timeouts = read_timeouts_.load(std::memory_order_relaxed);
+  snapshot.write_timeouts = write_timeouts_.load(std::memory_order_relaxed);
+  snapshot.eintr_retries = eintr_retries_.load(std::memory_order_relaxed);
+  snapshot.read_latency = read_latency_.Snapshot();
+  snapshot.write_latency = write_latency_.Snapshot();
+  snapshot.inter_byte_gap = inter_byte_gap_.Snapshot();
+  return snapshot;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialStats::Reset() ATLAS_NOEXCEPT {
+  bytes_read_.store(0, std::memory_order_relaxed);
+  bytes_written_.store(0, std::memory_order_relaxed);
+  syscalls_.store(0, std::memory_order_relaxed);
+  read_timeouts_.store(0, std::memory_order_relaxed);
+  write_timeouts_.store(0, std::memory_order_relaxed);
+  eintr_retries_.store(0, std::memory_order_relaxed);
+  last_receive_ns_.store(0, std::memory_order_relaxed);
+  read_latency_.Reset();
+  write_latency_.Reset();
+  inter_byte_gap_.Reset();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialStats::AddSyscall() ATLAS_NOEXCEPT {
+  Add(syscalls_, 1);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialStats::AddEintrRetry() ATLAS_NOEXCEPT {
+  Add(eintr_retries_, 1);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialStats::AddReadTimeout() ATLAS_NOEXCEPT {
+  Add(read_timeouts_, 1);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialStats::AddWriteTimeout() ATLAS_NOEXCEPT {
+  Add(write_timeouts_, 1);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialStats::AddBytesRead(size_t count) ATLAS_NOEXCEPT {
+  if (!IsEnabled() || count == 0) {
+    return;
+  }
+  bytes_read_.fetch_add(count, std::memory_order_relaxed);
+  int64_t now = NanoTimer::Now();
+  int64_t last = last_receive_ns_.exchange(now, std::memory_order_relaxed);
+  if (last != 0 && now > last) {
+    inter_byte_gap_.Record(static_cast<uint64_t>(now - last));
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialStats::AddBytesWritten(size_t count) ATLAS_NOEXCEPT {
+  Add(bytes_written_, count);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void SerialStats::Add(std::atomic<uint64_t> &counter,
+                                          uint64_t value) ATLAS_NOEXCEPT {
+  if (IsEnabled()) {
+    counter.fetch_add(value, std::memory_order_relaxed);
+  }
+}
+
+//==============================================================================
+// L A T E N C Y   S C O P E   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialStats::LatencyScope::LatencyScope(
+    SerialStats &stats, Operation operation) ATLAS_NOEXCEPT
+    : histogram_(nullptr),
+      start_ns_(0) {
+  if (stats.IsEnabled()) {
+    histogram_ = operation == Operation::kRead ? &stats.read_latency_
+                                               : &stats.write_latency_;
+    start_ns_ = NanoTimer::Now();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialStats::LatencyScope::~LatencyScope() ATLAS_NOEXCEPT {
+  if (histogram_) {
+    int64_t duration_ns = NanoTimer::Now() - start_ns_;
+    histogram_->Record(duration_ns > 0 ? static_cast<uint64_t>(duration_ns)
+                                       : 0);
+  }
+}
+
+}  // namespace atlas
@@ -0,0 +1,109 @@
+/**
+ * \file	write_batch.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_WRITE_BATCH_H_
+#define LIB_ATLAS_IO_WRITE_BATCH_H_
+
+#include <lib_atlas/macros.h>
+#include <stdint.h>
+#include <sys/uio.h>
+#include <string>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * A list of buffers that are sent with a single vectored write -- see
+ * Serial::Write(const WriteBatch &).
+ *
+ * The batch only references the buffers, which must stay alive until it is
+ * written. A batch can be cleared and reused so the list of buffers is not
+ * reallocated for every message.
+ *
+ * Sample usage:
+ *
+ * atlas::WriteBatch batch;
+ * batch.Add(header, sizeof(header)).Add(payload).Add(&checksum, 1);
+ * serial.Write(batch);
+ */
+class WriteBatch {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  WriteBatch() ATLAS_NOEXCEPT;
+
+  explicit WriteBatch(size_t capacity);
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Append a buffer to the batch. Empty buffers are ignored.
+   *
+   * \return A reference to this batch so the calls can be chained.
+   */
+  WriteBatch &Add(const void *data, size_t size);
+
+  WriteBatch &Add(const std::vector<uint8_t> &data);
+
+  WriteBatch &Add(const std::string &data);
+
+  /**
+   * Remove all the buffers but keep the allocated storage.
+   */
+  void Clear() ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of buffers of the batch.
+   */
+  size_t Count() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The total number of bytes of the batch.
+   */
+  size_t Size() const ATLAS_NOEXCEPT;
+
+  bool Empty() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The buffers of the batch, as expected by writev.
+   */
+  const iovec *Data() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::vector<iovec> buffers_;
+
+  size_t size_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/write_batch_inl.h>
+
+#endif  // LIB_ATLAS_IO_WRITE_BATCH_H_
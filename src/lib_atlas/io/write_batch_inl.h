@@ -0,0 +1,100 @@
+/**
+ * \file	write_batch_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_WRITE_BATCH_H_
+#error This file may only be included from write_batch.h
+#endif
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE WriteBatch::WriteBatch() ATLAS_NOEXCEPT : buffers_(), size_(0) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE WriteBatch::WriteBatch(size_t capacity) : buffers_(), size_(0) {
+  buffers_.reserve(capacity);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE WriteBatch &WriteBatch::Add(const void *data, size_t size) {
+  if (size != 0) {
+    iovec buffer = {const_cast<void *>(data), size};
+    buffers_.push_back(buffer);
+    size_ += size;
+  }
+  return *this;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE WriteBatch &WriteBatch::Add(const std::vector<uint8_t> &data) {
+  return Add(data.data(), data.size());
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE WriteBatch &WriteBatch::Add(const std::string &data) {
+  return Add(data.data(), data.size());
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void WriteBatch::Clear() ATLAS_NOEXCEPT {
+  buffers_.clear();
+  size_ = 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t WriteBatch::Count() const ATLAS_NOEXCEPT {
+  return buffers_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t WriteBatch::Size() const ATLAS_NOEXCEPT { return size_; }
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool WriteBatch::Empty() const ATLAS_NOEXCEPT {
+  return buffers_.empty();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const iovec *WriteBatch::Data() const ATLAS_NOEXCEPT {
+  return buffers_.data();
+}
+
+}  // namespace atlas
@@ -0,0 +1,84 @@
+/**
+ * \file	parallel_stats.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_MATHS_PARALLEL_STATS_H_
+#define LIB_ATLAS_MATHS_PARALLEL_STATS_H_
+
+#include <lib_atlas/macros.h>
+#include <lib_atlas/maths/stats.h>
+#include <lib_atlas/pattern/thread_pool.h>
+
+namespace atlas {
+
+// The following overloads compute the same values as the ones of stats.h,
+// the data set being reduced in chunks on a ThreadPool -- see
+// ThreadPool::ParallelReduce. The data set must provide random access to its
+// elements. For floating point elements, the result can differ in the last
+// bits as the order of the additions is not specified.
+
+/**
+ * Returns the mean of the data set provided, computed on a thread pool.
+ */
+template <typename Tp_>
+double Mean(const Tp_ &v, ThreadPool &pool);
+
+/**
+ * Return the minimum value in v, computed on a thread pool.
+ */
+template <typename Tp_>
+typename Tp_::value_type Min(const Tp_ &v, ThreadPool &pool);
+
+/**
+ * Return the maximum value in v, computed on a thread pool.
+ */
+template <typename Tp_>
+typename Tp_::value_type Max(const Tp_ &v, ThreadPool &pool);
+
+/**
+ * Returns the euclidean distance between the two data sets, computed on a
+ * thread pool.
+ */
+template <typename Tp_, typename Up_>
+double Euclidean(const Tp_ &v1, const Up_ &v2, ThreadPool &pool);
+
+/**
+ * Returns the covariance of the two data set provided, computed on a thread
+ * pool.
+ */
+template <typename Tp_, typename Up_>
+double Covariance(const Tp_ &v1, const Up_ &v2, ThreadPool &pool);
+
+/**
+ * Returns the standard deviation of the provided set, computed on a thread
+ * pool.
+ */
+template <typename Tp_>
+double StdDeviation(const Tp_ &v, ThreadPool &pool);
+
+}  // namespace atlas
+
+#include <lib_atlas/maths/parallel_stats_inl.h>
+
+#endif  // LIB_ATLAS_MATHS_PARALLEL_STATS_H_
@@ -0,0 +1,166 @@
+/**
+ * \file	parallel_stats_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_MATHS_PARALLEL_STATS_H_
+#error This file may only be included from parallel_stats.h
+#endif
+
+#include <math.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace atlas {
+
+namespace details {
+
+// The number of elements below which a parallel reduction is not worth
+// splitting.
+const size_t kParallelGrain = 16384;
+
+}  // namespace details
+
+//------------------------------------------------------------------------------
+//
+template <typename Tp_>
+ATLAS_ALWAYS_INLINE double Mean(const Tp_ &v, ThreadPool &pool) {
+  static_assert(details::IsIterable<Tp_>::value,
+                "The data set must be iterable");
+  using value_type = typename Tp_::value_type;
+  value_type s = pool.ParallelReduce(
+      size_t(0), static_cast<size_t>(v.size()), details::kParallelGrain,
+      value_type(0),
+      [&v](size_t first, size_t last) {
+        value_type chunk = {0};
+        for (size_t i = first; i < last; ++i) {
+          chunk += v[i];
+        }
+        return chunk;
+      },
+      [](const value_type &a, const value_type &b) { return a + b; });
+  return static_cast<double>(s) / static_cast<double>(v.size());
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Tp_>
+ATLAS_ALWAYS_INLINE typename Tp_::value_type Min(const Tp_ &v,
+                                                 ThreadPool &pool) {
+  static_assert(details::IsIterable<Tp_>::value,
+                "The data set must be iterable");
+  using value_type = typename Tp_::value_type;
+  return pool.ParallelReduce(
+      size_t(0), static_cast<size_t>(v.size()), details::kParallelGrain,
+      v[0],
+      [&v](size_t first, size_t last) {
+        return *std::min_element(v.cbegin() + first, v.cbegin() + last);
+      },
+      [](const value_type &a, const value_type &b) { return std::min(a, b); });
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Tp_>
+ATLAS_ALWAYS_INLINE typename Tp_::value_type Max(const Tp_ &v,
+                                                 ThreadPool &pool) {
+  static_assert(details::IsIterable<Tp_>::value,
+                "The data set must be iterable");
+  using value_type = typename Tp_::value_type;
+  return pool.ParallelReduce(
+      size_t(0), static_cast<size_t>(v.size()), details::kParallelGrain,
+      v[0],
+      [&v](size_t first, size_t last) {
+        return *std::max_element(v.cbegin() + first, v.cbegin() + last);
+      },
+      [](const value_type &a, const value_type &b) { return std::max(a, b); });
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Tp_, typename Up_>
+ATLAS_ALWAYS_INLINE double Euclidean(const Tp_ &v1, const Up_ &v2,
+                                     ThreadPool &pool) {
+  static_assert(details::IsIterable<Tp_>::value,
+                "The data set must be iterable");
+  static_assert(details::IsIterable<Up_>::value,
+                "The data set must be iterable");
+  if (v1.size() != v2.size()) {
+    throw std::invalid_argument("The lengh of the data set is not the same");
+  }
+
+  using value_type = typename Tp_::value_type;
+  value_type s = pool.ParallelReduce(
+      size_t(0), static_cast<size_t>(v1.size()), details::kParallelGrain,
+      value_type(0),
+      [&v1, &v2](size_t first, size_t last) {
+        value_type chunk = {0};
+        for (size_t i = first; i < last; ++i) {
+          value_type diff = v1[i] - v2[i];
+          chunk += diff * diff;
+        }
+        return chunk;
+      },
+      [](const value_type &a, const value_type &b) { return a + b; });
+  return sqrt(static_cast<double>(s));
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Tp_, typename Up_>
+ATLAS_ALWAYS_INLINE double Covariance(const Tp_ &v1, const Up_ &v2,
+                                      ThreadPool &pool) {
+  static_assert(details::IsIterable<Tp_>::value,
+                "The data set must be iterable");
+  static_assert(details::IsIterable<Up_>::value,
+                "The data set must be iterable");
+  if (v1.size() != v2.size()) {
+    throw std::invalid_argument("The lengh of the data set is not the same");
+  }
+
+  double m1 = Mean(v1, pool);
+  double m2 = Mean(v2, pool);
+  double s = pool.ParallelReduce(
+      size_t(0), static_cast<size_t>(v1.size()), details::kParallelGrain, 0.,
+      [&v1, &v2, m1, m2](size_t first, size_t last) {
+        double chunk = 0.;
+        for (size_t i = first; i < last; ++i) {
+          chunk += (static_cast<double>(v1[i]) - m1) *
+                   (static_cast<double>(v2[i]) - m2);
+        }
+        return chunk;
+      },
+      [](double a, double b) { return a + b; });
+  return s / static_cast<double>(v1.size() - 1);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Tp_>
+ATLAS_ALWAYS_INLINE double StdDeviation(const Tp_ &v, ThreadPool &pool) {
+  static_assert(details::IsIterable<Tp_>::value,
+                "The data set must be iterable");
+  return sqrt(Covariance(v, v, pool));
+}
+
+}  // namespace atlas
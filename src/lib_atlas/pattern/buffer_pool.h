@@ -0,0 +1,250 @@
+/**
+ * \file	buffer_pool.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_BUFFER_POOL_H_
+#define LIB_ATLAS_PATTERN_BUFFER_POOL_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <lib_atlas/macros.h>
+
+namespace atlas {
+
+/**
+ * A copy of the counters of a BufferPool.
+ */
+struct BufferPoolStats {
+  size_t capacity = {0};
+
+  /** Number of buffers that are not held by any handle. */
+  size_t available = {0};
+
+  /** Number of successful acquisitions. */
+  uint64_t acquired = {0};
+
+  /** Number of TryAcquire that failed because every buffer was held. */
+  uint64_t exhausted = {0};
+};
+
+/**
+ * A fixed set of buffers that are recycled rather than reallocated.
+ *
+ * Acquiring a buffer returns a Handle. The handles are reference counted:
+ * copying one -- e.g. to keep a frame in the mailbox of a queued observer --
+ * only increments an atomic counter, and the buffer goes back to the pool
+ * when the last handle is released. Buffers keep their content and their
+ * allocations between uses, so a buffer of the same size is refilled without
+ * any allocation.
+ *
+ * The handles may outlive the pool: the buffers are then freed with the last
+ * handle.
+ *
+ * \template Buffer_ The type of the buffers -- e.g. cv::Mat.
+ */
+template <class Buffer_>
+class BufferPool {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  class Handle;
+
+  using Factory = std::function<Buffer_()>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * Create count buffers with their default constructor.
+   */
+  explicit BufferPool(size_t count);
+
+  /**
+   * Create count buffers with factory, to preallocate them.
+   */
+  BufferPool(size_t count, const Factory &factory);
+
+  ~BufferPool() ATLAS_NOEXCEPT;
+
+  BufferPool(const BufferPool &) = delete;
+
+  BufferPool &operator=(const BufferPool &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * \return A handle on a free buffer, or an empty handle if every buffer is
+   *         held.
+   */
+  Handle TryAcquire();
+
+  /**
+   * \return A handle on a free buffer, waiting until one is released.
+   */
+  Handle Acquire();
+
+  size_t GetCapacity() const ATLAS_NOEXCEPT;
+
+  BufferPoolStats GetStats() const;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  struct State;
+
+  /**
+   * A buffer and the number of handles on it.
+   */
+  struct Slot {
+    Buffer_ buffer;
+
+    std::atomic<uint32_t> references;
+
+    State *state;
+  };
+
+  /**
+   * The part of the pool shared with the handles. It is deleted once the
+   * pool is destroyed and every buffer is released.
+   */
+  struct State {
+    std::vector<std::unique_ptr<Slot>> slots;
+
+    std::vector<Slot *> free_slots;
+
+    /** 1 for the pool, plus the number of acquired buffers. */
+    std::atomic<size_t> users;
+
+    std::atomic<uint64_t> acquired;
+
+    std::atomic<uint64_t> exhausted;
+
+    std::mutex mutex;
+
+    std::condition_variable released;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Take the last free slot, with the lock held.
+   */
+  Handle Take();
+
+  static void Release(Slot *slot) ATLAS_NOEXCEPT;
+
+  static void Unuse(State *state) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  State *state_;
+};
+
+/**
+ * A reference counted handle on a buffer of a BufferPool.
+ *
+ * The buffer can be modified through any handle: once a buffer is shared,
+ * e.g. notified to observers, it should be treated as immutable.
+ */
+template <class Buffer_>
+class BufferPool<Buffer_>::Handle {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * Create an empty handle.
+   */
+  Handle() ATLAS_NOEXCEPT;
+
+  Handle(const Handle &rhs) ATLAS_NOEXCEPT;
+
+  Handle(Handle &&rhs) ATLAS_NOEXCEPT;
+
+  ~Handle() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  Handle &operator=(const Handle &rhs) ATLAS_NOEXCEPT;
+
+  Handle &operator=(Handle &&rhs) ATLAS_NOEXCEPT;
+
+  Buffer_ &operator*() const ATLAS_NOEXCEPT;
+
+  Buffer_ *operator->() const ATLAS_NOEXCEPT;
+
+  explicit operator bool() const ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * \throw std::logic_error If the handle is empty.
+   */
+  Buffer_ &Get() const;
+
+  /**
+   * \return The number of handles on the buffer, 0 if empty.
+   */
+  uint32_t UseCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * Release the buffer, leaving the handle empty.
+   */
+  void Reset() ATLAS_NOEXCEPT;
+
+ private:
+  friend class BufferPool<Buffer_>;
+
+  //============================================================================
+  // P R I V A T E   C / D T O R S
+
+  /**
+   * Take the first reference on an acquired slot.
+   */
+  explicit Handle(Slot *slot) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  Slot *slot_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/buffer_pool_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_BUFFER_POOL_H_
@@ -0,0 +1,276 @@
+/**
+ * \file	buffer_pool_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_BUFFER_POOL_H_
+#error This file may only be included from buffer_pool.h
+#endif
+
+#include <stdexcept>
+#include <utility>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_INLINE BufferPool<Buffer_>::BufferPool(size_t count)
+    : BufferPool(count, []() { return Buffer_(); }) {}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_INLINE BufferPool<Buffer_>::BufferPool(size_t count,
+                                             const Factory &factory)
+    : state_(nullptr) {
+  if (count == 0) {
+    throw std::invalid_argument("a buffer pool must hold at least a buffer");
+  }
+  std::unique_ptr<State> state(new State);
+  state->users.store(1, std::memory_order_relaxed);
+  state->acquired.store(0, std::memory_order_relaxed);
+  state->exhausted.store(0, std::memory_order_relaxed);
+  state->slots.reserve(count);
+  state->free_slots.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    std::unique_ptr<Slot> slot(new Slot);
+    slot->buffer = factory();
+    slot->references.store(0, std::memory_order_relaxed);
+    slot->state = state.get();
+    state->free_slots.push_back(slot.get());
+    state->slots.push_back(std::move(slot));
+  }
+  state_ = state.release();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_INLINE BufferPool<Buffer_>::~BufferPool() ATLAS_NOEXCEPT {
+  // The buffers still held are freed with their last handle.
+  Unuse(state_);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_INLINE typename BufferPool<Buffer_>::Handle
+BufferPool<Buffer_>::TryAcquire() {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  if (state_->free_slots.empty()) {
+    state_->exhausted.fetch_add(1, std::memory_order_relaxed);
+    return Handle();
+  }
+  return Take();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_INLINE typename BufferPool<Buffer_>::Handle
+BufferPool<Buffer_>::Acquire() {
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  state_->released.wait(lock,
+                        [this]() { return !state_->free_slots.empty(); });
+  return Take();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_INLINE size_t BufferPool<Buffer_>::GetCapacity() const ATLAS_NOEXCEPT {
+  return state_->slots.size();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_INLINE BufferPoolStats BufferPool<Buffer_>::GetStats() const {
+  BufferPoolStats stats;
+  stats.capacity = state_->slots.size();
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    stats.available = state_->free_slots.size();
+  }
+  stats.acquired = state_->acquired.load(std::memory_order_relaxed);
+  stats.exhausted = state_->exhausted.load(std::memory_order_relaxed);
+  return stats;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_INLINE typename BufferPool<Buffer_>::Handle BufferPool<Buffer_>::Take() {
+  Slot *slot = state_->free_slots.back();
+  state_->free_slots.pop_back();
+  state_->users.fetch_add(1, std::memory_order_relaxed);
+  state_->acquired.fetch_add(1, std::memory_order_relaxed);
+  return Handle(slot);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_INLINE void BufferPool<Buffer_>::Release(Slot *slot) ATLAS_NOEXCEPT {
+  State *state = slot->state;
+  {
+    // free_slots has the capacity of every slot, this does not allocate.
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->free_slots.push_back(slot);
+  }
+  state->released.notify_one();
+  Unuse(state);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_INLINE void BufferPool<Buffer_>::Unuse(State *state) ATLAS_NOEXCEPT {
+  if (state->users.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete state;
+  }
+}
+
+//==============================================================================
+// H A N D L E   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_ALWAYS_INLINE BufferPool<Buffer_>::Handle::Handle() ATLAS_NOEXCEPT
+    : slot_(nullptr) {}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_ALWAYS_INLINE BufferPool<Buffer_>::Handle::Handle(Slot *slot)
+    ATLAS_NOEXCEPT : slot_(slot) {
+  slot_->references.store(1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_ALWAYS_INLINE BufferPool<Buffer_>::Handle::Handle(const Handle &rhs)
+    ATLAS_NOEXCEPT : slot_(rhs.slot_) {
+  if (slot_) {
+    slot_->references.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_ALWAYS_INLINE BufferPool<Buffer_>::Handle::Handle(Handle &&rhs)
+    ATLAS_NOEXCEPT : slot_(rhs.slot_) {
+  rhs.slot_ = nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_ALWAYS_INLINE BufferPool<Buffer_>::Handle::~Handle() ATLAS_NOEXCEPT {
+  Reset();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_ALWAYS_INLINE typename BufferPool<Buffer_>::Handle &
+    BufferPool<Buffer_>::Handle::operator=(const Handle &rhs) ATLAS_NOEXCEPT {
+  Handle copy(rhs);
+  std::swap(slot_, copy.slot_);
+  return *this;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_ALWAYS_INLINE typename BufferPool<Buffer_>::Handle &
+    BufferPool<Buffer_>::Handle::operator=(Handle &&rhs) ATLAS_NOEXCEPT {
+  Handle moved(std::move(rhs));
+  std::swap(slot_, moved.slot_);
+  return *this;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_ALWAYS_INLINE Buffer_ &BufferPool<Buffer_>::Handle::operator*() const
+    ATLAS_NOEXCEPT {
+  return slot_->buffer;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_ALWAYS_INLINE Buffer_ *BufferPool<Buffer_>::Handle::operator->() const
+    ATLAS_NOEXCEPT {
+  return &slot_->buffer;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_ALWAYS_INLINE BufferPool<Buffer_>::Handle::operator bool() const
+    ATLAS_NOEXCEPT {
+  return slot_ != nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_ALWAYS_INLINE Buffer_ &BufferPool<Buffer_>::Handle::Get() const {
+  if (slot_ == nullptr) {
+    throw std::logic_error("the buffer handle is empty");
+  }
+  return slot_->buffer;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_ALWAYS_INLINE uint32_t BufferPool<Buffer_>::Handle::UseCount() const
+    ATLAS_NOEXCEPT {
+  return slot_ ? slot_->references.load(std::memory_order_relaxed) : 0;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Buffer_>
+ATLAS_ALWAYS_INLINE void BufferPool<Buffer_>::Handle::Reset() ATLAS_NOEXCEPT {
+  if (slot_ &&
+      slot_->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    BufferPool<Buffer_>::Release(slot_);
+  }
+  slot_ = nullptr;
+}
+
+}  // namespace atlas
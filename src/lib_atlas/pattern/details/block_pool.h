@@ -0,0 +1,161 @@
+/**
+ * \file	block_pool.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_DETAILS_BLOCK_POOL_H_
+#define LIB_ATLAS_PATTERN_DETAILS_BLOCK_POOL_H_
+
+#include <lib_atlas/macros.h>
+#include <cstddef>
+#include <mutex>
+
+namespace atlas {
+
+namespace details {
+
+/**
+ * A process wide pool of memory blocks of Size_ bytes.
+ *
+ * Every thread keeps a small cache of free blocks, so allocating and
+ * releasing a block is a couple of pointer moves. The caches exchange blocks
+ * in batches with a shared list protected by a mutex, which lets a block
+ * allocated by a thread be released by another one. The blocks are never
+ * given back to the system.
+ */
+template <size_t Size_>
+class BlockPool {
+ public:
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  static void *Allocate();
+
+  static void Deallocate(void *block) ATLAS_NOEXCEPT;
+
+  /** Maximum number of free blocks a thread keeps for itself. */
+  static const size_t kCacheSize = 64;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  struct FreeList {
+    void Push(FreeBlock *block) ATLAS_NOEXCEPT;
+
+    FreeBlock *Pop() ATLAS_NOEXCEPT;
+
+    /** Move up to count blocks to another list. */
+    void MoveTo(FreeList &list, size_t count) ATLAS_NOEXCEPT;
+
+    FreeBlock *head = {nullptr};
+
+    size_t count = {0};
+  };
+
+  struct Shared {
+    std::mutex mutex;
+
+    FreeList blocks;
+  };
+
+  /**
+   * The blocks of a thread, given back to the shared list when the thread
+   * exits.
+   */
+  struct Cache {
+    ~Cache();
+
+    FreeList blocks;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  static Shared &GetShared();
+
+  static Cache &GetCache();
+};
+
+/**
+ * A standard allocator serving single objects from a BlockPool, typically
+ * to give to the allocator aware constructors of the standard library.
+ */
+template <class Tp_>
+class PoolAllocator {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using value_type = Tp_;
+
+  template <class Up_>
+  struct rebind {
+    using other = PoolAllocator<Up_>;
+  };
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  PoolAllocator() ATLAS_NOEXCEPT = default;
+
+  template <class Up_>
+  PoolAllocator(const PoolAllocator<Up_> &) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  Tp_ *allocate(size_t count);
+
+  void deallocate(Tp_ *pointer, size_t count) ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * \return True if count objects can be served by the pool.
+   */
+  static bool IsPooled(size_t count) ATLAS_NOEXCEPT;
+
+  /** The size of the blocks, rounded up to limit the number of pools. */
+  static const size_t kBlockSize = (sizeof(Tp_) + 15) / 16 * 16;
+};
+
+template <class Tp_, class Up_>
+bool operator==(const PoolAllocator<Tp_> &, const PoolAllocator<Up_> &);
+
+template <class Tp_, class Up_>
+bool operator!=(const PoolAllocator<Tp_> &, const PoolAllocator<Up_> &);
+
+}  // namespace details
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/details/block_pool_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_DETAILS_BLOCK_POOL_H_
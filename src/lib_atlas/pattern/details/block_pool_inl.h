@@ -0,0 +1,190 @@
+/**
+ * \file	block_pool_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_DETAILS_BLOCK_POOL_H_
+#error This file may only be included from block_pool.h
+#endif
+
+#include <new>
+
+namespace atlas {
+
+namespace details {
+
+//==============================================================================
+// F R E E   L I S T   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <size_t Size_>
+ATLAS_INLINE void BlockPool<Size_>::FreeList::Push(FreeBlock *block)
+    ATLAS_NOEXCEPT {
+  block->next = head;
+  head = block;
+  ++count;
+}
+
+//------------------------------------------------------------------------------
+//
+template <size_t Size_>
+ATLAS_INLINE typename BlockPool<Size_>::FreeBlock *
+BlockPool<Size_>::FreeList::Pop() ATLAS_NOEXCEPT {
+  FreeBlock *block = head;
+  if (block != nullptr) {
+    head = block->next;
+    --count;
+  }
+  return block;
+}
+
+//------------------------------------------------------------------------------
+//
+template <size_t Size_>
+ATLAS_INLINE void BlockPool<Size_>::FreeList::MoveTo(FreeList &list,
+                                                     size_t count)
+    ATLAS_NOEXCEPT {
+  for (size_t i = 0; i < count && head != nullptr; ++i) {
+    list.Push(Pop());
+  }
+}
+
+//==============================================================================
+// B L O C K   P O O L   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <size_t Size_>
+ATLAS_INLINE BlockPool<Size_>::Cache::~Cache() {
+  Shared &shared = GetShared();
+  auto lock = std::unique_lock<std::mutex>{shared.mutex};
+  blocks.MoveTo(shared.blocks, blocks.count);
+}
+
+//------------------------------------------------------------------------------
+//
+template <size_t Size_>
+ATLAS_INLINE void *BlockPool<Size_>::Allocate() {
+  Cache &cache = GetCache();
+  if (cache.blocks.head == nullptr) {
+    Shared &shared = GetShared();
+    auto lock = std::unique_lock<std::mutex>{shared.mutex};
+    shared.blocks.MoveTo(cache.blocks, kCacheSize / 2);
+  }
+  FreeBlock *block = cache.blocks.Pop();
+  if (block != nullptr) {
+    return block;
+  }
+  return ::operator new(Size_);
+}
+
+//------------------------------------------------------------------------------
+//
+template <size_t Size_>
+ATLAS_INLINE void BlockPool<Size_>::Deallocate(void *block) ATLAS_NOEXCEPT {
+  Cache &cache = GetCache();
+  cache.blocks.Push(static_cast<FreeBlock *>(block));
+  if (cache.blocks.count > kCacheSize) {
+    Shared &shared = GetShared();
+    auto lock = std::unique_lock<std::mutex>{shared.mutex};
+    cache.blocks.MoveTo(shared.blocks, kCacheSize / 2);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <size_t Size_>
+ATLAS_INLINE typename BlockPool<Size_>::Shared &BlockPool<Size_>::GetShared() {
+  // Never destroyed, as blocks can be released by the destructors of other
+  // static objects.
+  static Shared *shared = new Shared();
+  return *shared;
+}
+
+//------------------------------------------------------------------------------
+//
+template <size_t Size_>
+ATLAS_INLINE typename BlockPool<Size_>::Cache &BlockPool<Size_>::GetCache() {
+  static thread_local Cache cache;
+  return cache;
+}
+
+//==============================================================================
+// P O O L   A L L O C A T O R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+template <class Up_>
+ATLAS_INLINE PoolAllocator<Tp_>::PoolAllocator(const PoolAllocator<Up_> &)
+    ATLAS_NOEXCEPT {}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE Tp_ *PoolAllocator<Tp_>::allocate(size_t count) {
+  if (IsPooled(count)) {
+    return static_cast<Tp_ *>(BlockPool<kBlockSize>::Allocate());
+  }
+  return static_cast<Tp_ *>(::operator new(count * sizeof(Tp_)));
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void PoolAllocator<Tp_>::deallocate(Tp_ *pointer, size_t count)
+    ATLAS_NOEXCEPT {
+  if (IsPooled(count)) {
+    BlockPool<kBlockSize>::Deallocate(pointer);
+  } else {
+    ::operator delete(pointer);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool PoolAllocator<Tp_>::IsPooled(size_t count) ATLAS_NOEXCEPT {
+  return count == 1 && alignof(Tp_) <= alignof(std::max_align_t);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_, class Up_>
+ATLAS_INLINE bool operator==(const PoolAllocator<Tp_> &,
+                             const PoolAllocator<Up_> &) {
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_, class Up_>
+ATLAS_INLINE bool operator!=(const PoolAllocator<Tp_> &,
+                             const PoolAllocator<Up_> &) {
+  return false;
+}
+
+}  // namespace details
+
+}  // namespace atlas
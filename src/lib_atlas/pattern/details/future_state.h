@@ -0,0 +1,178 @@
+/**
+ * \file	future_state.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_DETAILS_FUTURE_STATE_H_
+#define LIB_ATLAS_PATTERN_DETAILS_FUTURE_STATE_H_
+
+#include <lib_atlas/macros.h>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace atlas {
+
+class ThreadPool;
+
+namespace details {
+
+/**
+ * The part of the shared state of a TaskFuture that does not depend on the
+ * type of its value.
+ *
+ * The continuations are called by the thread that completes the state, so
+ * they must be cheap: they usually post a task on the pool or count down.
+ */
+class FutureStateBase {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param pool The pool the continuations are executed on, or nullptr to
+   *        execute them on the thread that completes the state.
+   */
+  explicit FutureStateBase(ThreadPool *pool) ATLAS_NOEXCEPT;
+
+  FutureStateBase(const FutureStateBase &) = delete;
+
+  FutureStateBase &operator=(const FutureStateBase &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  ThreadPool *GetPool() const ATLAS_NOEXCEPT;
+
+  bool IsReady() const ATLAS_NOEXCEPT;
+
+  void Wait() const;
+
+  /**
+   * Call fn once the state is ready, or right away if it already is. fn must
+   * not throw.
+   */
+  void AddContinuation(std::function<void()> fn);
+
+  /**
+   * \return The exception the state was completed with. Only valid once the
+   *         state is ready.
+   */
+  std::exception_ptr GetError() const ATLAS_NOEXCEPT;
+
+  void SetError(std::exception_ptr error);
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  void MarkReady(std::exception_ptr error);
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  ThreadPool *pool_;
+
+  std::atomic<bool> is_ready_;
+
+  std::exception_ptr error_;
+
+  std::vector<std::function<void()>> continuations_;
+
+  mutable std::mutex mutex_;
+
+  mutable std::condition_variable condition_;
+};
+
+/**
+ * The shared state of a TaskFuture holding a value.
+ */
+template <class Tp_>
+class FutureState : public FutureStateBase {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  explicit FutureState(ThreadPool *pool) ATLAS_NOEXCEPT;
+
+  ~FutureState() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  template <class Up_>
+  void SetValue(Up_ &&value);
+
+  /**
+   * \return The value of a ready state.
+   * \throw The exception the state was completed with.
+   */
+  const Tp_ &Get() const;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  typename std::aligned_storage<sizeof(Tp_), alignof(Tp_)>::type storage_;
+
+  bool has_value_;
+};
+
+/**
+ * The shared state of a TaskFuture that only signals a completion.
+ */
+template <>
+class FutureState<void> : public FutureStateBase {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  explicit FutureState(ThreadPool *pool) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  void SetValue();
+
+  void Get() const;
+};
+
+/**
+ * Complete a state with the result of call(), or with the exception it
+ * throws.
+ */
+template <class Tp_, class Call_>
+void Fulfill(FutureState<Tp_> &state, Call_ &&call) ATLAS_NOEXCEPT;
+
+}  // namespace details
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/details/future_state_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_DETAILS_FUTURE_STATE_H_
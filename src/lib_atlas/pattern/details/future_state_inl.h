@@ -0,0 +1,212 @@
+/**
+ * \file	future_state_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_DETAILS_FUTURE_STATE_H_
+#error This file may only be included from future_state.h
+#endif
+
+#include <new>
+#include <utility>
+
+namespace atlas {
+
+namespace details {
+
+//==============================================================================
+// F U T U R E   S T A T E   B A S E   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FutureStateBase::FutureStateBase(ThreadPool *pool) ATLAS_NOEXCEPT
+    : pool_(pool),
+      is_ready_(false),
+      error_(),
+      continuations_(),
+      mutex_(),
+      condition_() {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool *FutureStateBase::GetPool() const ATLAS_NOEXCEPT {
+  return pool_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool FutureStateBase::IsReady() const ATLAS_NOEXCEPT {
+  return is_ready_.load(std::memory_order_acquire);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FutureStateBase::Wait() const {
+  if (IsReady()) {
+    return;
+  }
+  auto lock = std::unique_lock<std::mutex>{mutex_};
+  condition_.wait(lock, [this] { return IsReady(); });
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FutureStateBase::AddContinuation(std::function<void()> fn) {
+  {
+    auto lock = std::unique_lock<std::mutex>{mutex_};
+    if (!IsReady()) {
+      continuations_.push_back(std::move(fn));
+      return;
+    }
+  }
+  fn();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::exception_ptr FutureStateBase::GetError() const
+    ATLAS_NOEXCEPT {
+  return error_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FutureStateBase::SetError(std::exception_ptr error) {
+  MarkReady(error);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FutureStateBase::MarkReady(std::exception_ptr error) {
+  std::vector<std::function<void()>> continuations;
+  {
+    auto lock = std::unique_lock<std::mutex>{mutex_};
+    error_ = error;
+    is_ready_.store(true, std::memory_order_release);
+    continuations.swap(continuations_);
+  }
+  condition_.notify_all();
+  // The continuations own a reference on this state, they are released here
+  // so a state does not keep itself alive.
+  for (auto &continuation : continuations) {
+    continuation();
+  }
+}
+
+//==============================================================================
+// F U T U R E   S T A T E   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+FutureState<Tp_>::FutureState(ThreadPool *pool) ATLAS_NOEXCEPT
+    : FutureStateBase(pool),
+      storage_(),
+      has_value_(false) {}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+FutureState<Tp_>::~FutureState() ATLAS_NOEXCEPT {
+  if (has_value_) {
+    reinterpret_cast<Tp_ *>(&storage_)->~Tp_();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+template <class Up_>
+void FutureState<Tp_>::SetValue(Up_ &&value) {
+  new (&storage_) Tp_(std::forward<Up_>(value));
+  has_value_ = true;
+  MarkReady(nullptr);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+const Tp_ &FutureState<Tp_>::Get() const {
+  if (GetError()) {
+    std::rethrow_exception(GetError());
+  }
+  return *reinterpret_cast<const Tp_ *>(&storage_);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FutureState<void>::FutureState(ThreadPool *pool) ATLAS_NOEXCEPT
+    : FutureStateBase(pool) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FutureState<void>::SetValue() { MarkReady(nullptr); }
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FutureState<void>::Get() const {
+  if (GetError()) {
+    std::rethrow_exception(GetError());
+  }
+}
+
+//==============================================================================
+// F U L F I L L   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+struct Fulfiller {
+  template <class Call_>
+  static void Run(FutureState<Tp_> &state, Call_ &call) {
+    state.SetValue(call());
+  }
+};
+
+//------------------------------------------------------------------------------
+//
+template <>
+struct Fulfiller<void> {
+  template <class Call_>
+  static void Run(FutureState<void> &state, Call_ &call) {
+    call();
+    state.SetValue();
+  }
+};
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_, class Call_>
+void Fulfill(FutureState<Tp_> &state, Call_ &&call) ATLAS_NOEXCEPT {
+  // The continuations do not throw, so an exception comes from call or from
+  // the construction of the value, before the state is ready.
+  try {
+    Fulfiller<Tp_>::Run(state, call);
+  } catch (...) {
+    state.SetError(std::current_exception());
+  }
+}
+
+}  // namespace details
+
+}  // namespace atlas
@@ -0,0 +1,55 @@
+/**
+ * \file	index_sequence.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_DETAILS_INDEX_SEQUENCE_H_
+#define LIB_ATLAS_PATTERN_DETAILS_INDEX_SEQUENCE_H_
+
+#include <cstddef>
+
+namespace atlas {
+
+namespace details {
+
+/**
+ * A compile time sequence of indices, used to expand a tuple into the
+ * arguments of a call -- the C++11 counterpart of std::index_sequence.
+ */
+template <size_t... Indices_>
+struct IndexSequence {};
+
+template <size_t Count_, size_t... Indices_>
+struct MakeIndexSequence
+    : MakeIndexSequence<Count_ - 1, Count_ - 1, Indices_...> {};
+
+template <size_t... Indices_>
+struct MakeIndexSequence<0, Indices_...> {
+  using Type = IndexSequence<Indices_...>;
+};
+
+}  // namespace details
+
+}  // namespace atlas
+
+#endif  // LIB_ATLAS_PATTERN_DETAILS_INDEX_SEQUENCE_H_
@@ -0,0 +1,89 @@
+/**
+ * \file	latch.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_DETAILS_LATCH_H_
+#define LIB_ATLAS_PATTERN_DETAILS_LATCH_H_
+
+#include <lib_atlas/macros.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace atlas {
+
+namespace details {
+
+/**
+ * A single use barrier: Wait returns once the counter reached 0.
+ *
+ * Counting down is a single atomic operation unless it releases the waiters.
+ * The waiters spin for a short while before blocking, as the last counts
+ * usually come shortly after they start waiting.
+ */
+class Latch {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  explicit Latch(int64_t count) ATLAS_NOEXCEPT;
+
+  Latch(const Latch &) = delete;
+
+  Latch &operator=(const Latch &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  void CountDown(int64_t count = 1);
+
+  /**
+   * \return True if the counter reached 0.
+   */
+  bool TryWait() const ATLAS_NOEXCEPT;
+
+  void Wait();
+
+  /** Number of checks of the counter before blocking in Wait. */
+  static const int kSpinCount = 1000;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::atomic<int64_t> count_;
+
+  std::mutex mutex_;
+
+  std::condition_variable condition_;
+};
+
+}  // namespace details
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/details/latch_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_DETAILS_LATCH_H_
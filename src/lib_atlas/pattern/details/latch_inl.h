@@ -0,0 +1,80 @@
+/**
+ * \file	latch_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_DETAILS_LATCH_H_
+#error This file may only be included from latch.h
+#endif
+
+#include <thread>
+
+namespace atlas {
+
+namespace details {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Latch::Latch(int64_t count) ATLAS_NOEXCEPT : count_(count),
+                                                         mutex_(),
+                                                         condition_() {}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Latch::CountDown(int64_t count) {
+  if (count_.fetch_sub(count, std::memory_order_acq_rel) == count) {
+    // Taking the mutex makes sure a waiter is either blocked on the
+    // condition or has not checked the counter yet.
+    auto lock = std::unique_lock<std::mutex>{mutex_};
+    condition_.notify_all();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Latch::TryWait() const ATLAS_NOEXCEPT {
+  return count_.load(std::memory_order_acquire) <= 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Latch::Wait() {
+  for (int i = 0; i < kSpinCount; ++i) {
+    if (TryWait()) {
+      return;
+    }
+    std::this_thread::yield();
+  }
+  auto lock = std::unique_lock<std::mutex>{mutex_};
+  condition_.wait(lock, [this] { return TryWait(); });
+}
+
+}  // namespace details
+
+}  // namespace atlas
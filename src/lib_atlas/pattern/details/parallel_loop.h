@@ -0,0 +1,193 @@
+/**
+ * \file	parallel_loop.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_DETAILS_PARALLEL_LOOP_H_
+#define LIB_ATLAS_PATTERN_DETAILS_PARALLEL_LOOP_H_
+
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/details/block_pool.h>
+#include <lib_atlas/pattern/details/latch.h>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <type_traits>
+
+namespace atlas {
+
+namespace details {
+
+/**
+ * The state shared by the threads executing a ThreadPool::ParallelFor or a
+ * ThreadPool::ParallelReduce.
+ *
+ * The participants claim chunks of the range until it is exhausted and count
+ * the iterations they executed down on a latch, on which the caller waits.
+ * The loop is reference counted, as a helper task can start after the caller
+ * returned. Such a late participant finds nothing to claim and never touches
+ * the context of the caller.
+ */
+template <class Index_>
+class ParallelLoop {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  static_assert(std::is_integral<Index_>::value,
+                "The index of a parallel loop must be an integer");
+
+  /**
+   * Claim and execute chunks, then complete the iterations.
+   */
+  using Participant = void (*)(ParallelLoop &loop);
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param chunk The size of the chunks, or their minimum size if guided.
+   * \param guided Claim chunks proportional to the remaining iterations.
+   * \param participants The number of participants, each of them holding a
+   *        reference on the loop until it calls Release.
+   */
+  static ParallelLoop *Create(Index_ begin, Index_ end, Index_ chunk,
+                              bool guided, size_t participants,
+                              Participant participant, void *context);
+
+  ParallelLoop(const ParallelLoop &) = delete;
+
+  ParallelLoop &operator=(const ParallelLoop &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  void Participate();
+
+  /**
+   * Drop references, the last one destroying the loop.
+   */
+  void Release(size_t count = 1) ATLAS_NOEXCEPT;
+
+  /**
+   * Claim the next chunk of the range.
+   *
+   * \return False if the whole range was claimed.
+   */
+  bool Claim(Index_ &first, Index_ &last) ATLAS_NOEXCEPT;
+
+  /**
+   * Mark iterations as executed.
+   */
+  void Complete(Index_ count);
+
+  /**
+   * Record the exception of a participant. The following chunks are claimed
+   * but not executed.
+   */
+  void Fail(std::exception_ptr error) ATLAS_NOEXCEPT;
+
+  bool IsCancelled() const ATLAS_NOEXCEPT;
+
+  /**
+   * Wait until every iteration is completed.
+   */
+  void Wait();
+
+  /**
+   * \return The first exception thrown by a participant. Only valid after
+   *         Wait.
+   */
+  std::exception_ptr GetError() const;
+
+  void *GetContext() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   C / D T O R S
+
+  ParallelLoop(Index_ begin, Index_ end, Index_ chunk, bool guided,
+               size_t participants, Participant participant, void *context);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::atomic<Index_> next_;
+
+  Index_ end_;
+
+  Index_ chunk_;
+
+  bool guided_;
+
+  size_t participants_;
+
+  Latch latch_;
+
+  std::atomic<size_t> references_;
+
+  std::atomic<bool> cancelled_;
+
+  std::exception_ptr error_;
+
+  Participant participant_;
+
+  void *context_;
+};
+
+/**
+ * The participant of a ParallelFor, whose context is the function.
+ */
+template <class Index_, class Fn_>
+void ParallelForParticipant(ParallelLoop<Index_> &loop);
+
+/**
+ * The context of a ParallelReduce, on the stack of the caller.
+ */
+template <class Tp_, class Map_, class Combine_>
+struct ReduceContext {
+  const Tp_ &identity;
+
+  Map_ &map;
+
+  Combine_ &combine;
+
+  Tp_ result;
+
+  std::mutex mutex;
+};
+
+/**
+ * The participant of a ParallelReduce. It reduces its chunks locally and
+ * combines its result with the one of the context once.
+ */
+template <class Index_, class Tp_, class Map_, class Combine_>
+void ParallelReduceParticipant(ParallelLoop<Index_> &loop);
+
+}  // namespace details
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/details/parallel_loop_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_DETAILS_PARALLEL_LOOP_H_
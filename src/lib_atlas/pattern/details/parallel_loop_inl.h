@@ -0,0 +1,224 @@
+/**
+ * \file	parallel_loop_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_DETAILS_PARALLEL_LOOP_H_
+#error This file may only be included from parallel_loop.h
+#endif
+
+#include <new>
+
+namespace atlas {
+
+namespace details {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Index_>
+ATLAS_INLINE ParallelLoop<Index_>::ParallelLoop(Index_ begin, Index_ end,
+                                                Index_ chunk, bool guided,
+                                                size_t participants,
+                                                Participant participant,
+                                                void *context)
+    : next_(begin),
+      end_(end),
+      chunk_(chunk),
+      guided_(guided),
+      participants_(participants),
+      latch_(static_cast<int64_t>(end - begin)),
+      references_(participants),
+      cancelled_(false),
+      error_(),
+      participant_(participant),
+      context_(context) {}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_>
+ATLAS_INLINE ParallelLoop<Index_> *ParallelLoop<Index_>::Create(
+    Index_ begin, Index_ end, Index_ chunk, bool guided, size_t participants,
+    Participant participant, void *context) {
+  PoolAllocator<ParallelLoop> allocator;
+  ParallelLoop *loop = allocator.allocate(1);
+  return new (loop) ParallelLoop(begin, end, chunk, guided, participants,
+                                 participant, context);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Index_>
+ATLAS_INLINE void ParallelLoop<Index_>::Participate() {
+  participant_(*this);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_>
+ATLAS_INLINE void ParallelLoop<Index_>::Release(size_t count) ATLAS_NOEXCEPT {
+  if (count > 0 &&
+      references_.fetch_sub(count, std::memory_order_acq_rel) == count) {
+    this->~ParallelLoop();
+    PoolAllocator<ParallelLoop>().deallocate(this, 1);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_>
+ATLAS_INLINE bool ParallelLoop<Index_>::Claim(Index_ &first,
+                                              Index_ &last) ATLAS_NOEXCEPT {
+  first = next_.load(std::memory_order_relaxed);
+  do {
+    if (first >= end_) {
+      return false;
+    }
+    Index_ remaining = end_ - first;
+    Index_ size = chunk_;
+    if (guided_) {
+      Index_ share = static_cast<Index_>(remaining / (2 * participants_));
+      size = share > size ? share : size;
+    }
+    last = size < remaining ? first + size : end_;
+  } while (!next_.compare_exchange_weak(first, last,
+                                        std::memory_order_relaxed));
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_>
+ATLAS_INLINE void ParallelLoop<Index_>::Complete(Index_ count) {
+  if (count > 0) {
+    latch_.CountDown(static_cast<int64_t>(count));
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_>
+ATLAS_INLINE void ParallelLoop<Index_>::Fail(std::exception_ptr error)
+    ATLAS_NOEXCEPT {
+  if (!cancelled_.exchange(true)) {
+    error_ = error;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_>
+ATLAS_INLINE bool ParallelLoop<Index_>::IsCancelled() const ATLAS_NOEXCEPT {
+  return cancelled_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_>
+ATLAS_INLINE void ParallelLoop<Index_>::Wait() {
+  latch_.Wait();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_>
+ATLAS_INLINE std::exception_ptr ParallelLoop<Index_>::GetError() const {
+  return error_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_>
+ATLAS_INLINE void *ParallelLoop<Index_>::GetContext() const ATLAS_NOEXCEPT {
+  return context_;
+}
+
+//==============================================================================
+// P A R T I C I P A N T S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Index_, class Fn_>
+ATLAS_INLINE void ParallelForParticipant(ParallelLoop<Index_> &loop) {
+  Index_ first, last;
+  Index_ executed = 0;
+  while (loop.Claim(first, last)) {
+    if (!loop.IsCancelled()) {
+      try {
+        Fn_ &fn = *static_cast<Fn_ *>(loop.GetContext());
+        for (Index_ i = first; i < last; ++i) {
+          fn(i);
+        }
+      } catch (...) {
+        loop.Fail(std::current_exception());
+      }
+    }
+    executed += last - first;
+  }
+  loop.Complete(executed);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_, class Tp_, class Map_, class Combine_>
+ATLAS_INLINE void ParallelReduceParticipant(ParallelLoop<Index_> &loop) {
+  Index_ first, last;
+  if (!loop.Claim(first, last)) {
+    return;
+  }
+
+  // The context lives as long as the claimed iterations are not completed.
+  using context_type = ReduceContext<Tp_, Map_, Combine_>;
+  context_type &context = *static_cast<context_type *>(loop.GetContext());
+  Index_ executed = last - first;
+  try {
+    Tp_ result = context.identity;
+    for (;;) {
+      if (!loop.IsCancelled()) {
+        result = context.combine(result, context.map(first, last));
+      }
+      if (!loop.Claim(first, last)) {
+        break;
+      }
+      executed += last - first;
+    }
+
+    auto lock = std::unique_lock<std::mutex>{context.mutex};
+    context.result = context.combine(context.result, result);
+  } catch (...) {
+    loop.Fail(std::current_exception());
+    while (loop.Claim(first, last)) {
+      executed += last - first;
+    }
+  }
+  loop.Complete(executed);
+}
+
+}  // namespace details
+
+}  // namespace atlas
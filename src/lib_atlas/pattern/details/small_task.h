@@ -0,0 +1,172 @@
+/**
+ * \file	small_task.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_DETAILS_SMALL_TASK_H_
+#define LIB_ATLAS_PATTERN_DETAILS_SMALL_TASK_H_
+
+#include <lib_atlas/macros.h>
+#include <cstddef>
+#include <future>
+#include <type_traits>
+#include <utility>
+
+namespace atlas {
+
+namespace details {
+
+/**
+ * A move only void() callable, like a std::function that could hold move
+ * only objects.
+ *
+ * The callables of at most kInlineSize bytes that can be moved without
+ * throwing are stored in the object itself, so wrapping them does not
+ * allocate. The larger ones are allocated on the heap.
+ */
+class SmallTask {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  SmallTask() ATLAS_NOEXCEPT;
+
+  template <class Fn_,
+            class = typename std::enable_if<!std::is_same<
+                typename std::decay<Fn_>::type, SmallTask>::value>::type>
+  SmallTask(Fn_ &&fn);
+
+  SmallTask(SmallTask &&task) ATLAS_NOEXCEPT;
+
+  ~SmallTask() ATLAS_NOEXCEPT;
+
+  SmallTask(const SmallTask &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  SmallTask &operator=(SmallTask &&task) ATLAS_NOEXCEPT;
+
+  SmallTask &operator=(const SmallTask &) = delete;
+
+  void operator()();
+
+  explicit operator bool() const ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * \return True if the callable is stored in the object itself.
+   */
+  bool IsInline() const ATLAS_NOEXCEPT;
+
+  /** Enough for a lambda capturing a few pointers and a std::promise. */
+  static const size_t kInlineSize = 48;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  /**
+   * The type erased operations on the stored callable.
+   */
+  struct Operations {
+    void (*invoke)(void *storage);
+
+    /** Move construct the callable in to and destroy it in from. */
+    void (*move)(void *from, void *to);
+
+    void (*destroy)(void *storage);
+
+    bool is_inline;
+  };
+
+  template <class Fn_>
+  struct InlineOperations;
+
+  template <class Fn_>
+  struct HeapOperations;
+
+  template <class Fn_>
+  struct FitsInline
+      : std::integral_constant<
+            bool, sizeof(Fn_) <= kInlineSize &&
+                      alignof(Fn_) <= alignof(std::max_align_t) &&
+                      std::is_nothrow_move_constructible<Fn_>::value> {};
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  template <class Fn_>
+  void Construct(Fn_ &&fn, std::true_type);
+
+  template <class Fn_>
+  void Construct(Fn_ &&fn, std::false_type);
+
+  void Reset() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  typename std::aligned_storage<kInlineSize, alignof(std::max_align_t)>::type
+      storage_;
+
+  const Operations *operations_;
+};
+
+/**
+ * Calls a function and sets its result, or the exception it throws, in a
+ * promise.
+ */
+template <class Rp_, class Fn_>
+class PromisedCall {
+ public:
+  PromisedCall(std::promise<Rp_> &&promise, Fn_ fn);
+
+  PromisedCall(PromisedCall &&) = default;
+
+  void operator()();
+
+ private:
+  /** Overload for the functions returning void. */
+  void SetValue(std::true_type);
+
+  void SetValue(std::false_type);
+
+  std::promise<Rp_> promise_;
+
+  Fn_ fn_;
+};
+
+template <class Rp_, class Fn_>
+PromisedCall<Rp_, typename std::decay<Fn_>::type> MakePromisedCall(
+    std::promise<Rp_> &&promise, Fn_ &&fn);
+
+}  // namespace details
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/details/small_task_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_DETAILS_SMALL_TASK_H_
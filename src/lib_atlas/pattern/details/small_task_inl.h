@@ -0,0 +1,228 @@
+/**
+ * \file	small_task_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_DETAILS_SMALL_TASK_H_
+#error This file may only be included from small_task.h
+#endif
+
+#include <new>
+
+namespace atlas {
+
+namespace details {
+
+//==============================================================================
+// O P E R A T I O N S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Fn_>
+struct SmallTask::InlineOperations {
+  static void Invoke(void *storage) { (*static_cast<Fn_ *>(storage))(); }
+
+  static void Move(void *from, void *to) {
+    new (to) Fn_(std::move(*static_cast<Fn_ *>(from)));
+    static_cast<Fn_ *>(from)->~Fn_();
+  }
+
+  static void Destroy(void *storage) { static_cast<Fn_ *>(storage)->~Fn_(); }
+
+  static const Operations *Get() {
+    static const Operations operations = {&Invoke, &Move, &Destroy, true};
+    return &operations;
+  }
+};
+
+//------------------------------------------------------------------------------
+//
+template <class Fn_>
+struct SmallTask::HeapOperations {
+  static Fn_ *&Pointer(void *storage) {
+    return *static_cast<Fn_ **>(storage);
+  }
+
+  static void Invoke(void *storage) { (*Pointer(storage))(); }
+
+  static void Move(void *from, void *to) {
+    new (to) Fn_ *(Pointer(from));
+  }
+
+  static void Destroy(void *storage) { delete Pointer(storage); }
+
+  static const Operations *Get() {
+    static const Operations operations = {&Invoke, &Move, &Destroy, false};
+    return &operations;
+  }
+};
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SmallTask::SmallTask() ATLAS_NOEXCEPT : storage_(),
+                                                     operations_(nullptr) {}
+
+//------------------------------------------------------------------------------
+//
+template <class Fn_, class>
+ATLAS_INLINE SmallTask::SmallTask(Fn_ &&fn)
+    : storage_(), operations_(nullptr) {
+  using function_type = typename std::decay<Fn_>::type;
+  Construct(std::forward<Fn_>(fn), FitsInline<function_type>());
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SmallTask::SmallTask(SmallTask &&task) ATLAS_NOEXCEPT
+    : storage_(),
+      operations_(task.operations_) {
+  if (operations_ != nullptr) {
+    operations_->move(&task.storage_, &storage_);
+    task.operations_ = nullptr;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SmallTask::~SmallTask() ATLAS_NOEXCEPT { Reset(); }
+
+//==============================================================================
+// O P E R A T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SmallTask &SmallTask::operator=(SmallTask &&task)
+    ATLAS_NOEXCEPT {
+  if (this != &task) {
+    Reset();
+    operations_ = task.operations_;
+    if (operations_ != nullptr) {
+      operations_->move(&task.storage_, &storage_);
+      task.operations_ = nullptr;
+    }
+  }
+  return *this;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SmallTask::operator()() {
+  if (operations_ == nullptr) {
+    throw std::bad_function_call();
+  }
+  operations_->invoke(&storage_);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SmallTask::operator bool() const ATLAS_NOEXCEPT {
+  return operations_ != nullptr;
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool SmallTask::IsInline() const ATLAS_NOEXCEPT {
+  return operations_ != nullptr && operations_->is_inline;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Fn_>
+ATLAS_INLINE void SmallTask::Construct(Fn_ &&fn, std::true_type) {
+  using function_type = typename std::decay<Fn_>::type;
+  new (&storage_) function_type(std::forward<Fn_>(fn));
+  operations_ = InlineOperations<function_type>::Get();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Fn_>
+ATLAS_INLINE void SmallTask::Construct(Fn_ &&fn, std::false_type) {
+  using function_type = typename std::decay<Fn_>::type;
+  new (&storage_) function_type *(new function_type(std::forward<Fn_>(fn)));
+  operations_ = HeapOperations<function_type>::Get();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SmallTask::Reset() ATLAS_NOEXCEPT {
+  if (operations_ != nullptr) {
+    operations_->destroy(&storage_);
+    operations_ = nullptr;
+  }
+}
+
+//==============================================================================
+// P R O M I S E D   C A L L   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Rp_, class Fn_>
+ATLAS_INLINE PromisedCall<Rp_, Fn_>::PromisedCall(std::promise<Rp_> &&promise,
+                                                  Fn_ fn)
+    : promise_(std::move(promise)), fn_(std::move(fn)) {}
+
+//------------------------------------------------------------------------------
+//
+template <class Rp_, class Fn_>
+ATLAS_INLINE void PromisedCall<Rp_, Fn_>::operator()() {
+  try {
+    SetValue(std::is_void<Rp_>());
+  } catch (...) {
+    promise_.set_exception(std::current_exception());
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Rp_, class Fn_>
+ATLAS_INLINE void PromisedCall<Rp_, Fn_>::SetValue(std::true_type) {
+  fn_();
+  promise_.set_value();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Rp_, class Fn_>
+ATLAS_INLINE void PromisedCall<Rp_, Fn_>::SetValue(std::false_type) {
+  promise_.set_value(fn_());
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Rp_, class Fn_>
+ATLAS_INLINE PromisedCall<Rp_, typename std::decay<Fn_>::type>
+MakePromisedCall(std::promise<Rp_> &&promise, Fn_ &&fn) {
+  return PromisedCall<Rp_, typename std::decay<Fn_>::type>(
+      std::move(promise), std::forward<Fn_>(fn));
+}
+
+}  // namespace details
+
+}  // namespace atlas
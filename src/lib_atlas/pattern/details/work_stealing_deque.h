@@ -0,0 +1,154 @@
+/**
+ * \file	work_stealing_deque.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_DETAILS_WORK_STEALING_DEQUE_H_
+#define LIB_ATLAS_PATTERN_DETAILS_WORK_STEALING_DEQUE_H_
+
+#include <lib_atlas/macros.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace atlas {
+
+namespace details {
+
+/**
+ * A Chase-Lev work-stealing deque of pointers.
+ *
+ * The owner thread pushes and takes at the bottom of the deque, as a stack,
+ * while any other thread can steal from the top, in FIFO order. Push and Take
+ * never lock, and only contend with thieves on the last element.
+ *
+ * The storage is a circular array that grows when it is full. The previous
+ * arrays are kept until the deque is destroyed, as a thief may still be
+ * reading from them.
+ *
+ * The memory orders follow "Correct and Efficient Work-Stealing for Weak
+ * Memory Models" (Le, Pop, Cohen and Zappa Nardelli, 2013).
+ */
+template <class Tp_>
+class WorkStealingDeque {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param capacity The initial capacity of the deque. It is rounded up to
+   *        the next power of two.
+   */
+  explicit WorkStealingDeque(size_t capacity = 256);
+
+  WorkStealingDeque(const WorkStealingDeque &) = delete;
+
+  WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Add an element at the bottom of the deque. Owner only.
+   */
+  void Push(Tp_ *element);
+
+  /**
+   * Remove the element at the bottom of the deque. Owner only.
+   *
+   * \return The most recently pushed element, or nullptr if the deque is
+   *         empty.
+   */
+  Tp_ *Take() ATLAS_NOEXCEPT;
+
+  /**
+   * Remove the element at the top of the deque. Any thread.
+   *
+   * \return The oldest element, or nullptr if the deque is empty or if
+   *         another thread took the element first.
+   */
+  Tp_ *Steal() ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of elements in the deque. It is only a snapshot when
+   *         called while other threads are using the deque.
+   */
+  size_t Size() const ATLAS_NOEXCEPT;
+
+  bool IsEmpty() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  /**
+   * A circular array whose slots are indexed by the ever growing positions of
+   * the deque.
+   */
+  class Array {
+   public:
+    explicit Array(size_t capacity);
+
+    size_t Capacity() const ATLAS_NOEXCEPT;
+
+    Tp_ *Get(int64_t index) const ATLAS_NOEXCEPT;
+
+    void Put(int64_t index, Tp_ *element) ATLAS_NOEXCEPT;
+
+    /**
+     * \return A new array twice as large holding the elements in [top,
+     *         bottom).
+     */
+    Array *Grow(int64_t top, int64_t bottom) const;
+
+   private:
+    size_t mask_;
+
+    std::unique_ptr<std::atomic<Tp_ *>[]> slots_;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::atomic<int64_t> top_;
+
+  // Keeps the positions on different cache lines so the thieves do not
+  // invalidate the line of the owner on every operation.
+  char padding_[64];
+
+  std::atomic<int64_t> bottom_;
+
+  std::atomic<Array *> array_;
+
+  /** Every array allocated by the owner, the current one being the last. */
+  std::vector<std::unique_ptr<Array>> arrays_;
+};
+
+}  // namespace details
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/details/work_stealing_deque_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_DETAILS_WORK_STEALING_DEQUE_H_
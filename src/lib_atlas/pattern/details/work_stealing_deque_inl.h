@@ -0,0 +1,184 @@
+/**
+ * \file	work_stealing_deque_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_DETAILS_WORK_STEALING_DEQUE_H_
+#error This file may only be included from work_stealing_deque.h
+#endif
+
+namespace atlas {
+
+namespace details {
+
+//==============================================================================
+// A R R A Y   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE WorkStealingDeque<Tp_>::Array::Array(size_t capacity)
+    : mask_(capacity - 1), slots_(new std::atomic<Tp_ *>[capacity]) {}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE size_t WorkStealingDeque<Tp_>::Array::Capacity() const
+    ATLAS_NOEXCEPT {
+  return mask_ + 1;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE Tp_ *WorkStealingDeque<Tp_>::Array::Get(int64_t index) const
+    ATLAS_NOEXCEPT {
+  return slots_[static_cast<size_t>(index) & mask_].load(
+      std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void WorkStealingDeque<Tp_>::Array::Put(int64_t index,
+                                                     Tp_ *element)
+    ATLAS_NOEXCEPT {
+  slots_[static_cast<size_t>(index) & mask_].store(element,
+                                                   std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE typename WorkStealingDeque<Tp_>::Array *
+WorkStealingDeque<Tp_>::Array::Grow(int64_t top, int64_t bottom) const {
+  Array *array = new Array(Capacity() * 2);
+  for (int64_t i = top; i < bottom; ++i) {
+    array->Put(i, Get(i));
+  }
+  return array;
+}
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE WorkStealingDeque<Tp_>::WorkStealingDeque(size_t capacity)
+    : top_(0), padding_(), bottom_(0), array_(nullptr), arrays_() {
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  arrays_.emplace_back(new Array(size));
+  array_.store(arrays_.back().get(), std::memory_order_relaxed);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void WorkStealingDeque<Tp_>::Push(Tp_ *element) {
+  int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  int64_t top = top_.load(std::memory_order_acquire);
+  Array *array = array_.load(std::memory_order_relaxed);
+  if (bottom - top > static_cast<int64_t>(array->Capacity()) - 1) {
+    arrays_.emplace_back(array->Grow(top, bottom));
+    array = arrays_.back().get();
+    array_.store(array, std::memory_order_release);
+  }
+  array->Put(bottom, element);
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom_.store(bottom + 1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE Tp_ *WorkStealingDeque<Tp_>::Take() ATLAS_NOEXCEPT {
+  int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+  Array *array = array_.load(std::memory_order_relaxed);
+  bottom_.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top = top_.load(std::memory_order_relaxed);
+
+  if (top > bottom) {
+    // The deque was empty.
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  Tp_ *element = array->Get(bottom);
+  if (top == bottom) {
+    // Last element, race against the thieves for it.
+    if (!top_.compare_exchange_strong(top, top + 1,
+                                      std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      element = nullptr;
+    }
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return element;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE Tp_ *WorkStealingDeque<Tp_>::Steal() ATLAS_NOEXCEPT {
+  int64_t top = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t bottom = bottom_.load(std::memory_order_acquire);
+  if (top >= bottom) {
+    return nullptr;
+  }
+
+  Tp_ *element = array_.load(std::memory_order_acquire)->Get(top);
+  if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return element;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE size_t WorkStealingDeque<Tp_>::Size() const ATLAS_NOEXCEPT {
+  int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  int64_t top = top_.load(std::memory_order_relaxed);
+  return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool WorkStealingDeque<Tp_>::IsEmpty() const ATLAS_NOEXCEPT {
+  return Size() == 0;
+}
+
+}  // namespace details
+
+}  // namespace atlas
@@ -0,0 +1,246 @@
+/**
+ * \file	mailbox.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_MAILBOX_H_
+#define LIB_ATLAS_PATTERN_MAILBOX_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/thread_pool.h>
+#include <lib_atlas/sys/thread.h>
+
+namespace atlas {
+
+/**
+ * What a Mailbox does with an item pushed while it is full.
+ */
+enum class OverflowPolicy {
+  /** Discard the oldest pending item to make room for the new one. */
+  kDropOldest = 0,
+  /** Discard the new item. */
+  kDropNewest,
+  /** Wait until the handler took an item. */
+  kBlock
+};
+
+struct MailboxOptions {
+  /** Maximum number of pending items, must not be 0. */
+  size_t capacity = {64};
+
+  OverflowPolicy overflow = {OverflowPolicy::kDropOldest};
+
+  /** Attributes of the thread draining the mailbox, when it has its own. */
+  ThreadAttributes attributes;
+};
+
+/**
+ * A copy of the counters of a Mailbox.
+ */
+struct MailboxStats {
+  /** Number of pending items. */
+  size_t depth = {0};
+
+  /** Highest number of pending items since the creation of the mailbox. */
+  size_t max_depth = {0};
+
+  /** Number of items passed to the handler. */
+  uint64_t delivered = {0};
+
+  /** Number of items discarded by the overflow policy, Discard or Stop. */
+  uint64_t dropped = {0};
+};
+
+/**
+ * A bounded queue of items delivered to a handler on another thread.
+ *
+ * The items are drained either by a thread owned by the mailbox or by tasks
+ * posted on a ThreadPool, one task at a time so that the handler is never
+ * called concurrently and sees the items in order. An exception thrown by
+ * the handler does not stop the delivery of the next items, the first one is
+ * rethrown by Stop.
+ *
+ * With the kBlock policy, Push waits for the handler: it must not be called
+ * from a worker of the ThreadPool draining the mailbox, nor from the handler.
+ *
+ * \template Item_ The type of the items, which must be default constructible
+ *           and move assignable. The storage of capacity items is allocated
+ *           once.
+ */
+template <class Item_>
+class Mailbox {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Handler = std::function<void(Item_ &)>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * Create a mailbox drained by a thread of its own, created with
+   * options.attributes.
+   */
+  Mailbox(const MailboxOptions &options, Handler handler);
+
+  /**
+   * Create a mailbox drained by tasks posted on pool.
+   */
+  Mailbox(const MailboxOptions &options, ThreadPool &pool, Handler handler);
+
+  /**
+   * Stop the mailbox, discarding the pending items.
+   */
+  ~Mailbox() ATLAS_NOEXCEPT;
+
+  Mailbox(const Mailbox &) = delete;
+
+  Mailbox &operator=(const Mailbox &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Queue an item, applying the overflow policy if the mailbox is full.
+   *
+   * \return False if the mailbox is stopped, the item is then left untouched
+   *         so the caller can handle it itself.
+   */
+  bool Push(Item_ &&item);
+
+  /**
+   * Discard the pending items matching predicate, then wait until the handler
+   * returned, unless it is the caller.
+   *
+   * \param predicate Called with the mutex of the mailbox held, it must not
+   *        use the mailbox.
+   * \return The number of discarded items.
+   */
+  template <class Predicate_>
+  size_t Discard(Predicate_ predicate);
+
+  /**
+   * Stop accepting items and wait until the handler returned. Must not be
+   * called from the handler.
+   *
+   * \param deliver_pending If true, the pending items are delivered before
+   *        returning, on the thread of the mailbox or on the calling thread.
+   *        Otherwise they are discarded.
+   * \throw The first exception thrown by the handler since the last call to
+   *        Stop, once the mailbox is stopped.
+   */
+  void Stop(bool deliver_pending);
+
+  bool IsStopped() const ATLAS_NOEXCEPT;
+
+  MailboxStats GetStats() const;
+
+  const MailboxOptions &GetOptions() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Deliver the pending items with the lock held, releasing it during the
+   * calls to the handler.
+   */
+  void DeliverPending(std::unique_lock<std::mutex> &lock);
+
+  /**
+   * The loop of the thread of the mailbox.
+   */
+  void Run();
+
+  /**
+   * Post a task draining the mailbox on the pool.
+   */
+  void Schedule();
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  MailboxOptions options_;
+
+  Handler handler_;
+
+  /** Null if the mailbox has its own thread. */
+  ThreadPool *pool_;
+
+  /** A ring buffer of options_.capacity items. */
+  std::vector<Item_> items_;
+
+  size_t head_;
+
+  size_t size_;
+
+  size_t max_depth_;
+
+  bool is_stopped_;
+
+  bool is_discarding_;
+
+  /** True while a task draining the mailbox is posted on the pool. */
+  bool is_draining_;
+
+  /** True while the handler runs, on delivering_thread_. */
+  bool is_delivering_;
+
+  std::thread::id delivering_thread_;
+
+  /** The first exception thrown by the handler, rethrown by Stop. */
+  std::exception_ptr error_;
+
+  std::atomic<uint64_t> delivered_;
+
+  std::atomic<uint64_t> dropped_;
+
+  mutable std::mutex mutex_;
+
+  std::condition_variable not_empty_;
+
+  std::condition_variable not_full_;
+
+  std::condition_variable drained_;
+
+  /** Notified when the handler returns. */
+  std::condition_variable idle_;
+
+  Thread thread_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/mailbox_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_MAILBOX_H_
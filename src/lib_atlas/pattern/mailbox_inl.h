@@ -0,0 +1,336 @@
+/**
+ * \file	mailbox_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_MAILBOX_H_
+#error This file may only be included from mailbox.h
+#endif
+
+#include <stdexcept>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Item_>
+ATLAS_INLINE Mailbox<Item_>::Mailbox(const MailboxOptions &options,
+                                     Handler handler)
+    : options_(options),
+      handler_(std::move(handler)),
+      pool_(nullptr),
+      items_(),
+      head_(0),
+      size_(0),
+      max_depth_(0),
+      is_stopped_(false),
+      is_discarding_(false),
+      is_draining_(false),
+      is_delivering_(false),
+      delivering_thread_(),
+      error_(),
+      delivered_(0),
+      dropped_(0),
+      mutex_(),
+      not_empty_(),
+      not_full_(),
+      drained_(),
+      idle_(),
+      thread_() {
+  if (options_.capacity == 0) {
+    throw std::invalid_argument("the capacity of a mailbox must not be 0");
+  }
+  items_.resize(options_.capacity);
+  thread_ = Thread(options_.attributes, [this]() { Run(); });
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Item_>
+ATLAS_INLINE Mailbox<Item_>::Mailbox(const MailboxOptions &options,
+                                     ThreadPool &pool, Handler handler)
+    : options_(options),
+      handler_(std::move(handler)),
+      pool_(&pool),
+      items_(),
+      head_(0),
+      size_(0),
+      max_depth_(0),
+      is_stopped_(false),
+      is_discarding_(false),
+      is_draining_(false),
+      is_delivering_(false),
+      delivering_thread_(),
+      error_(),
+      delivered_(0),
+      dropped_(0),
+      mutex_(),
+      not_empty_(),
+      not_full_(),
+      drained_(),
+      idle_(),
+      thread_() {
+  if (options_.capacity == 0) {
+    throw std::invalid_argument("the capacity of a mailbox must not be 0");
+  }
+  items_.resize(options_.capacity);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Item_>
+ATLAS_INLINE Mailbox<Item_>::~Mailbox() ATLAS_NOEXCEPT {
+  try {
+    Stop(false);
+  } catch (...) {
+    // The error of the handler has no one left to be reported to.
+  }
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Item_>
+ATLAS_INLINE bool Mailbox<Item_>::Push(Item_ &&item) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (is_stopped_) {
+    return false;
+  }
+  if (size_ == options_.capacity) {
+    switch (options_.overflow) {
+      case OverflowPolicy::kDropNewest:
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      case OverflowPolicy::kDropOldest:
+        head_ = (head_ + 1) % options_.capacity;
+        --size_;
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        break;
+      case OverflowPolicy::kBlock:
+        not_full_.wait(lock, [this]() {
+          return size_ < options_.capacity || is_stopped_;
+        });
+        if (is_stopped_) {
+          return false;
+        }
+        break;
+    }
+  }
+
+  items_[(head_ + size_) % options_.capacity] = std::move(item);
+  ++size_;
+  if (size_ > max_depth_) {
+    max_depth_ = size_;
+  }
+
+  if (pool_ == nullptr) {
+    not_empty_.notify_one();
+    return true;
+  }
+  // A single draining task at a time keeps the items in order. A task that
+  // is already running picks the new item up before it ends.
+  if (is_draining_) {
+    return true;
+  }
+  is_draining_ = true;
+  lock.unlock();
+  Schedule();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Item_>
+template <class Predicate_>
+ATLAS_INLINE size_t Mailbox<Item_>::Discard(Predicate_ predicate) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  // Compact the kept items towards the head, in order.
+  size_t kept = 0;
+  for (size_t i = 0; i < size_; ++i) {
+    Item_ &item = items_[(head_ + i) % options_.capacity];
+    if (predicate(static_cast<const Item_ &>(item))) {
+      continue;
+    }
+    if (kept != i) {
+      items_[(head_ + kept) % options_.capacity] = std::move(item);
+    }
+    ++kept;
+  }
+  const size_t discarded = size_ - kept;
+  for (size_t i = kept; i < size_; ++i) {
+    items_[(head_ + i) % options_.capacity] = Item_();
+  }
+  size_ = kept;
+  if (discarded > 0) {
+    dropped_.fetch_add(discarded, std::memory_order_relaxed);
+    not_full_.notify_all();
+  }
+
+  if (delivering_thread_ != std::this_thread::get_id()) {
+    idle_.wait(lock, [this]() { return !is_delivering_; });
+  }
+  return discarded;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Item_>
+ATLAS_INLINE void Mailbox<Item_>::Stop(bool deliver_pending) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!is_stopped_) {
+    is_stopped_ = true;
+    is_discarding_ = !deliver_pending;
+    not_empty_.notify_all();
+    not_full_.notify_all();
+  }
+
+  if (pool_ != nullptr) {
+    drained_.wait(lock, [this]() { return !is_draining_; });
+    // Items may be left if the pool refused the draining task.
+    if (!is_discarding_) {
+      DeliverPending(lock);
+    }
+  } else if (thread_.IsJoinable()) {
+    lock.unlock();
+    thread_.Join();
+    lock.lock();
+  }
+
+  dropped_.fetch_add(size_, std::memory_order_relaxed);
+  for (; size_ > 0; --size_) {
+    items_[head_] = Item_();
+    head_ = (head_ + 1) % options_.capacity;
+  }
+  head_ = 0;
+
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Item_>
+ATLAS_INLINE bool Mailbox<Item_>::IsStopped() const ATLAS_NOEXCEPT {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return is_stopped_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Item_>
+ATLAS_INLINE MailboxStats Mailbox<Item_>::GetStats() const {
+  MailboxStats stats;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.depth = size_;
+    stats.max_depth = max_depth_;
+  }
+  stats.delivered = delivered_.load(std::memory_order_relaxed);
+  stats.dropped = dropped_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Item_>
+ATLAS_INLINE const MailboxOptions &Mailbox<Item_>::GetOptions() const
+    ATLAS_NOEXCEPT {
+  return options_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Item_>
+ATLAS_INLINE void Mailbox<Item_>::DeliverPending(
+    std::unique_lock<std::mutex> &lock) {
+  while (size_ > 0 && !is_discarding_) {
+    Item_ item(std::move(items_[head_]));
+    // A moved-from item may still hold resources, e.g. a pooled buffer.
+    items_[head_] = Item_();
+    head_ = (head_ + 1) % options_.capacity;
+    --size_;
+    not_full_.notify_one();
+    is_delivering_ = true;
+    delivering_thread_ = std::this_thread::get_id();
+    lock.unlock();
+    // An escaping exception would leave is_delivering_ and is_draining_ set,
+    // and Discard and Stop waiting forever.
+    std::exception_ptr error;
+    try {
+      handler_(item);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    delivered_.fetch_add(1, std::memory_order_relaxed);
+    lock.lock();
+    if (error && !error_) {
+      error_ = error;
+    }
+    is_delivering_ = false;
+    delivering_thread_ = std::thread::id();
+    idle_.notify_all();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Item_>
+ATLAS_INLINE void Mailbox<Item_>::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    not_empty_.wait(lock, [this]() { return size_ > 0 || is_stopped_; });
+    if (is_stopped_ && (is_discarding_ || size_ == 0)) {
+      return;
+    }
+    DeliverPending(lock);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Item_>
+ATLAS_INLINE void Mailbox<Item_>::Schedule() {
+  try {
+    pool_->Post([this]() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      DeliverPending(lock);
+      is_draining_ = false;
+      drained_.notify_all();
+    });
+  } catch (const std::runtime_error &) {
+    // The pool is stopped, the items wait for Stop.
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_draining_ = false;
+    drained_.notify_all();
+  }
+}
+
+}  // namespace atlas
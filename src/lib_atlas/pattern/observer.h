@@ -29,14 +29,32 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
 #include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/details/index_sequence.h>
+#include <lib_atlas/pattern/mailbox.h>
 #include <lib_atlas/pattern/subject.h>
 
 namespace atlas {
 
+/**
+ * An observer is notified by the subjects it is attached to.
+ *
+ * By default OnSubjectNotify is called synchronously by the thread calling
+ * Subject::Notify. With SetQueuedDelivery, the notifications are copied in a
+ * bounded mailbox instead, and OnSubjectNotify is called by another thread,
+ * so a slow observer does not slow down the subject. The arguments are then
+ * decayed copies of the notified ones. Detaching from a subject discards the
+ * notifications it queued and waits for the one being delivered, if any.
+ *
+ * Whatever the delivery, a derived observer notified from other threads must
+ * detach from its subjects in its own destructor: the destructor of Observer
+ * runs once the derived part is gone, and a notification reaching it then
+ * would call the pure virtual OnSubjectNotify.
+ */
 template <typename... Args_>
 class Observer {
   // The callback on the Observer class are private by default.
@@ -87,6 +105,38 @@ class Observer {
 
   void DetachFromAllSubject() ATLAS_NOEXCEPT;
 
+  /**
+   * Deliver the notifications through a mailbox drained by a thread of its
+   * own. Must be called while the observer is not attached to any subject.
+   *
+   * \throw std::logic_error If the observer is attached.
+   */
+  void SetQueuedDelivery(const MailboxOptions &options);
+
+  /**
+   * Deliver the notifications through a mailbox drained on pool. Must be
+   * called while the observer is not attached to any subject.
+   *
+   * \throw std::logic_error If the observer is attached.
+   */
+  void SetQueuedDelivery(const MailboxOptions &options, ThreadPool &pool);
+
+  /**
+   * Deliver the pending notifications, then go back to synchronous delivery.
+   *
+   * \throw The first exception thrown by OnSubjectNotify on the thread of
+   *        the mailbox.
+   */
+  void StopQueuedDelivery();
+
+  bool IsQueued() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The counters of the mailbox, all zero if the observer has never
+   *         been queued.
+   */
+  MailboxStats GetDeliveryStats() const;
+
  protected:
   //============================================================================
   // P R O T E C T E D   M E T H O D S
@@ -99,9 +149,32 @@ class Observer {
   virtual void OnSubjectNotify(Subject<Args_...> &subject, Args_... args) = 0;
 
  private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  using Notification =
+      std::tuple<Subject<Args_...> *, typename std::decay<Args_>::type...>;
+
   //============================================================================
   // P R I V A T E   M E T H O D S
 
+  /**
+   * Called by the subjects: queue the notification, or call OnSubjectNotify
+   * if the delivery is synchronous.
+   */
+  template <class... Up_>
+  void Dispatch(Subject<Args_...> &subject, Up_ &&... args);
+
+  /**
+   * Call OnSubjectNotify with the content of a notification, moving the
+   * arguments taken by value out of it.
+   */
+  template <size_t... Indices_>
+  void Deliver(Notification &notification,
+               details::IndexSequence<Indices_...>);
+
+  void CheckDetached() const;
+
   virtual void OnSubjectConnected(Subject<Args_...> &subject);
 
   virtual void OnSubjectDisconnected(Subject<Args_...> &subject);
@@ -112,6 +185,9 @@ class Observer {
   std::vector<Subject<Args_...> *> subjects_;
 
   mutable std::mutex subjects_mutex_;
+
+  /** Null while the delivery is synchronous. */
+  std::unique_ptr<Mailbox<Notification>> mailbox_;
 };
 
 }  // namespace atlas
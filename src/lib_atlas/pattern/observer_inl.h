@@ -29,6 +29,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <stdexcept>
+#include <utility>
 
 namespace atlas {
 
@@ -40,14 +42,16 @@ namespace atlas {
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE Observer<Args_...>::Observer() ATLAS_NOEXCEPT
     : subjects_(),
-      subjects_mutex_() {}
+      subjects_mutex_(),
+      mailbox_() {}
 
 //------------------------------------------------------------------------------
 //
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE Observer<Args_...>::Observer(const Observer<Args_...> &rhs)
     ATLAS_NOEXCEPT : subjects_(),
-                     subjects_mutex_() {
+                     subjects_mutex_(),
+                     mailbox_() {
   for (auto &subject : rhs.subjects_) {
     subject->Attach(*this);
   }
@@ -58,7 +62,8 @@ ATLAS_ALWAYS_INLINE Observer<Args_...>::Observer(const Observer<Args_...> &rhs)
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE Observer<Args_...>::Observer(Subject<Args_...> &subject)
     ATLAS_NOEXCEPT : subjects_(),
-                     subjects_mutex_() {
+                     subjects_mutex_(),
+                     mailbox_() {
   subject.Attach(*this);
 }
 
@@ -69,6 +74,8 @@ ATLAS_ALWAYS_INLINE Observer<Args_...>::~Observer() ATLAS_NOEXCEPT {
   for (const auto &subject : subjects_) {
     subject->DetachNoCallback(*this);
   }
+  // No notification can be queued anymore, discard the pending ones.
+  mailbox_.reset();
 }
 
 //==============================================================================
@@ -119,12 +126,22 @@ ATLAS_ALWAYS_INLINE void Observer<Args_...>::OnSubjectConnected(
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Observer<Args_...>::OnSubjectDisconnected(
     Subject<Args_...> &subject) {
-  std::unique_lock<std::mutex> locker(subjects_mutex_);
-  auto it = std::find(subjects_.begin(), subjects_.end(), &subject);
-  if (it == subjects_.end()) {
-    throw std::invalid_argument("The element is not in the container.");
-  } else {
-    subjects_.erase(it);
+  {
+    std::unique_lock<std::mutex> locker(subjects_mutex_);
+    auto it = std::find(subjects_.begin(), subjects_.end(), &subject);
+    if (it == subjects_.end()) {
+      throw std::invalid_argument("The element is not in the container.");
+    } else {
+      subjects_.erase(it);
+    }
+  }
+  // The subject cannot queue anything anymore. Its pending notifications are
+  // discarded, they would use it after it is destroyed, and a running one is
+  // waited for so the observer can be destroyed once Detach returned.
+  if (mailbox_) {
+    mailbox_->Discard([&subject](const Notification &notification) {
+      return std::get<0>(notification) == &subject;
+    });
   }
 }
 
@@ -146,4 +163,99 @@ ATLAS_ALWAYS_INLINE void Observer<Args_...>::Observe(
   subject.Attach(*this);
 }
 
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void Observer<Args_...>::SetQueuedDelivery(
+    const MailboxOptions &options) {
+  CheckDetached();
+  mailbox_.reset();
+  mailbox_.reset(new Mailbox<Notification>(
+      options, [this](Notification &notification) {
+        Deliver(notification, typename details::MakeIndexSequence<
+                                  sizeof...(Args_)>::Type());
+      }));
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void Observer<Args_...>::SetQueuedDelivery(
+    const MailboxOptions &options, ThreadPool &pool) {
+  CheckDetached();
+  mailbox_.reset();
+  mailbox_.reset(new Mailbox<Notification>(
+      options, pool, [this](Notification &notification) {
+        Deliver(notification, typename details::MakeIndexSequence<
+                                  sizeof...(Args_)>::Type());
+      }));
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void Observer<Args_...>::StopQueuedDelivery() {
+  if (mailbox_) {
+    // The mailbox is kept so the notifications running concurrently can see
+    // it is stopped and fall back on the synchronous delivery.
+    mailbox_->Stop(true);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE bool Observer<Args_...>::IsQueued() const ATLAS_NOEXCEPT {
+  return mailbox_ && !mailbox_->IsStopped();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE MailboxStats Observer<Args_...>::GetDeliveryStats() const {
+  return mailbox_ ? mailbox_->GetStats() : MailboxStats();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+template <class... Up_>
+ATLAS_ALWAYS_INLINE void Observer<Args_...>::Dispatch(
+    Subject<Args_...> &subject, Up_ &&... args) {
+  if (mailbox_) {
+    Notification notification(&subject, std::forward<Up_>(args)...);
+    // A stopped mailbox leaves the notification untouched.
+    if (!mailbox_->Push(std::move(notification))) {
+      Deliver(notification, typename details::MakeIndexSequence<
+                                sizeof...(Args_)>::Type());
+    }
+    return;
+  }
+  OnSubjectNotify(subject, std::forward<Up_>(args)...);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+template <size_t... Indices_>
+ATLAS_ALWAYS_INLINE void Observer<Args_...>::Deliver(
+    Notification &notification, details::IndexSequence<Indices_...>) {
+  OnSubjectNotify(
+      *std::get<0>(notification),
+      std::forward<typename std::tuple_element<
+          Indices_, std::tuple<Args_...>>::type>(
+          std::get<Indices_ + 1>(notification))...);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void Observer<Args_...>::CheckDetached() const {
+  std::unique_lock<std::mutex> locker(subjects_mutex_);
+  if (!subjects_.empty()) {
+    throw std::logic_error(
+        "the delivery mode of an attached observer cannot be changed");
+  }
+}
+
 }  // namespace atlas
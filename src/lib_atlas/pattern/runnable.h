@@ -27,9 +27,9 @@
 #define LIB_ATLAS_PATTERN_RUNNABLE_H_
 
 #include <lib_atlas/macros.h>
+#include <lib_atlas/sys/thread.h>
 #include <atomic>
 #include <memory>
-#include <thread>
 
 namespace atlas {
 
@@ -42,6 +42,10 @@ namespace atlas {
  * The user of this class must consider checking the state of the thread with
  * running when implementing its run method (or any other method that will try
  * to access the thread). The running() method as been provided at this effect.
+ *
+ * The thread is created with the ThreadAttributes given to
+ * SetThreadAttributes(), so it can be pinned to a CPU or run with a realtime
+ * policy.
  */
 class Runnable {
  public:
@@ -103,6 +107,13 @@ class Runnable {
    */
   bool IsRunning() const ATLAS_NOEXCEPT;
 
+  /**
+   * Set the attributes of the thread created by the next call to Start().
+   */
+  void SetThreadAttributes(const ThreadAttributes &attributes);
+
+  const ThreadAttributes &GetThreadAttributes() const ATLAS_NOEXCEPT;
+
  protected:
   //============================================================================
   // P R O T E C T E D   M E T H O D S
@@ -134,9 +145,11 @@ class Runnable {
   //============================================================================
   // P R I V A T E   M E M B E R S
 
-  std::unique_ptr<std::thread> thread_;
+  std::unique_ptr<Thread> thread_;
 
   std::atomic<bool> stop_;
+
+  ThreadAttributes attributes_;
 };
 
 }  // namespace atlas
@@ -35,7 +35,8 @@ namespace atlas {
 //------------------------------------------------------------------------------
 //
 ATLAS_ALWAYS_INLINE Runnable::Runnable() ATLAS_NOEXCEPT : thread_(nullptr),
-                                                          stop_(false) {}
+                                                          stop_(false),
+                                                          attributes_() {}
 
 //------------------------------------------------------------------------------
 //
@@ -52,8 +53,8 @@ ATLAS_ALWAYS_INLINE Runnable::~Runnable() ATLAS_NOEXCEPT {
 //
 ATLAS_ALWAYS_INLINE void Runnable::Start() {
   if (thread_ == nullptr) {
-    thread_ =
-        std::unique_ptr<std::thread>(new std::thread(&Runnable::Run, this));
+    thread_ = std::unique_ptr<Thread>(
+        new Thread(attributes_, [this] { Run(); }));
   } else {
     throw std::logic_error("The thread must be stoped before it is started.");
   }
@@ -64,7 +65,7 @@ ATLAS_ALWAYS_INLINE void Runnable::Start() {
 ATLAS_ALWAYS_INLINE void Runnable::Stop() ATLAS_NOEXCEPT {
   if (IsRunning()) {
     stop_ = true;
-    thread_->join();
+    thread_->Join();
     thread_ = nullptr;
   } else {
     throw std::logic_error("The thread is not running.");
@@ -74,7 +75,21 @@ ATLAS_ALWAYS_INLINE void Runnable::Stop() ATLAS_NOEXCEPT {
 //------------------------------------------------------------------------------
 //
 ATLAS_ALWAYS_INLINE bool Runnable::IsRunning() const ATLAS_NOEXCEPT {
-  return thread_ != nullptr && thread_->joinable() && !MustStop();
+  return thread_ != nullptr && thread_->IsJoinable() && !MustStop();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void Runnable::SetThreadAttributes(
+    const ThreadAttributes &attributes) {
+  attributes_ = attributes;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE const ThreadAttributes &Runnable::GetThreadAttributes()
+    const ATLAS_NOEXCEPT {
+  return attributes_;
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,114 @@
+/**
+ * \file	shared_payload.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_SHARED_PAYLOAD_H_
+#define LIB_ATLAS_PATTERN_SHARED_PAYLOAD_H_
+
+#include <memory>
+#include <utility>
+
+#include <lib_atlas/macros.h>
+
+namespace atlas {
+
+/**
+ * An immutable value shared by reference counting.
+ *
+ * A SharedPayload is meant to be the argument of a Subject notification: all
+ * the observers read the same value, and copying the payload -- e.g. in the
+ * mailbox of a queued observer -- only increments a reference count. Since
+ * the value cannot be modified, it can safely be read from several threads.
+ *
+ * Sample usage:
+ *
+ * class Sonar : public atlas::Subject<const SharedPayload<Scan> &> {
+ *  public:
+ *   void OnScan(Scan &&scan) {
+ *     Notify(MakeSharedPayload<Scan>(std::move(scan)));
+ *   }
+ * };
+ *
+ * \template Tp_ The type of the value.
+ */
+template <class Tp_>
+class SharedPayload {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * Create an empty payload.
+   */
+  SharedPayload() ATLAS_NOEXCEPT;
+
+  /**
+   * Share an existing value. The payload is empty if value is null.
+   */
+  explicit SharedPayload(std::shared_ptr<const Tp_> value) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  const Tp_ &operator*() const ATLAS_NOEXCEPT;
+
+  const Tp_ *operator->() const ATLAS_NOEXCEPT;
+
+  explicit operator bool() const ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * \throw std::logic_error If the payload is empty.
+   */
+  const Tp_ &Get() const;
+
+  bool IsEmpty() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of payloads sharing the value, 0 if empty.
+   */
+  long UseCount() const ATLAS_NOEXCEPT;
+
+  const std::shared_ptr<const Tp_> &GetPointer() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::shared_ptr<const Tp_> value_;
+};
+
+/**
+ * Construct a value in a single allocation with its reference count.
+ */
+template <class Tp_, class... Args_>
+SharedPayload<Tp_> MakeSharedPayload(Args_ &&... args);
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/shared_payload_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_SHARED_PAYLOAD_H_
@@ -0,0 +1,119 @@
+/**
+ * \file	shared_payload_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_SHARED_PAYLOAD_H_
+#error This file may only be included from shared_payload.h
+#endif
+
+#include <stdexcept>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE SharedPayload<Tp_>::SharedPayload() ATLAS_NOEXCEPT
+    : value_() {}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE SharedPayload<Tp_>::SharedPayload(
+    std::shared_ptr<const Tp_> value) ATLAS_NOEXCEPT
+    : value_(std::move(value)) {}
+
+//==============================================================================
+// O P E R A T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE const Tp_ &SharedPayload<Tp_>::operator*() const
+    ATLAS_NOEXCEPT {
+  return *value_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE const Tp_ *SharedPayload<Tp_>::operator->() const
+    ATLAS_NOEXCEPT {
+  return value_.get();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE SharedPayload<Tp_>::operator bool() const ATLAS_NOEXCEPT {
+  return value_ != nullptr;
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE const Tp_ &SharedPayload<Tp_>::Get() const {
+  if (!value_) {
+    throw std::logic_error("the payload is empty");
+  }
+  return *value_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE bool SharedPayload<Tp_>::IsEmpty() const ATLAS_NOEXCEPT {
+  return value_ == nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE long SharedPayload<Tp_>::UseCount() const ATLAS_NOEXCEPT {
+  return value_.use_count();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE const std::shared_ptr<const Tp_>
+    &SharedPayload<Tp_>::GetPointer() const ATLAS_NOEXCEPT {
+  return value_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_, class... Args_>
+ATLAS_ALWAYS_INLINE SharedPayload<Tp_> MakeSharedPayload(Args_ &&... args) {
+  return SharedPayload<Tp_>(
+      std::make_shared<const Tp_>(std::forward<Args_>(args)...));
+}
+
+}  // namespace atlas
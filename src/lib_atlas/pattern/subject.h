@@ -25,6 +25,7 @@
 #ifndef LIB_ATLAS_PATTERN_SUBJECT_H_
 #define LIB_ATLAS_PATTERN_SUBJECT_H_
 
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -65,6 +66,15 @@ class Observer;
  *   bool must_stop_searching_ = {false};
  * };
  *
+ * Notify does not take any lock: it atomically loads an immutable snapshot of
+ * the observers and iterates it, while Attach and Detach publish a new
+ * snapshot. Once Detach returned, the detached observer is not notified
+ * anymore and no notification running on another thread still uses it, so it
+ * can be destroyed. For a queued observer, this covers the notifications
+ * still in its mailbox, which Detach discards, and the one its thread may be
+ * delivering, which Detach waits for. An observer may detach itself or attach
+ * other observers from its OnSubjectNotify, but must not be destroyed there.
+ *
  * \template Args_ A list of arguments to send when a notification is thown.
  * This will usually be the list of the member an observer wants to access --
  * e.g. A reference to an image if the subject is an image provider
@@ -83,6 +93,8 @@ class Subject {
 
   using Ptr = std::shared_ptr<Subject<Args_...>>;
 
+  using ObserverList = std::vector<Observer<Args_...> *>;
+
   //============================================================================
   // P U B L I C   C / D T O R S
 
@@ -104,6 +116,10 @@ class Subject {
    * Throw a notification to all the observers that have attached to this
    * subject.
    *
+   * The arguments taken by value are copied for every observer but the last
+   * one, which receives them as rvalues. To fan out a large value without
+   * any copy, notify a SharedPayload.
+   *
    * \param args The arguments that
    */
   void Notify(Args_... args) ATLAS_NOEXCEPT;
@@ -113,6 +129,13 @@ class Subject {
    */
   size_t ObserverCount() const ATLAS_NOEXCEPT;
 
+  /**
+   * Return true if one of the observers attached to this subject has a
+   * queued delivery -- i.e. reads the notified arguments after Notify
+   * returned.
+   */
+  bool HasQueuedObservers() const ATLAS_NOEXCEPT;
+
   /**
    * Add a new observer to the list. Return false if already in the attached.
    */
@@ -146,18 +169,51 @@ class Subject {
    */
   void DetachNoCallback(Observer<Args_...> &observer);
 
+  /**
+   * Remove an observer from the list and wait until the notifications that
+   * may still be using it are done.
+   *
+   * \return True if the observer was attached to this subject.
+   */
+  bool Remove(Observer<Args_...> &observer);
+
+  /**
+   * Publish a new snapshot of the observers, with the observers_mutex_ held.
+   */
+  void Publish(ObserverList &&observers);
+
+  /**
+   * Return the current snapshot of the observers.
+   */
+  std::shared_ptr<const ObserverList> Snapshot() const ATLAS_NOEXCEPT;
+
+  /**
+   * Wait until no notification of another thread iterates the given
+   * snapshot. The notifications of the calling thread are not waited for,
+   * this would never return if Detach is called from OnSubjectNotify.
+   */
+  static void WaitForReaders(const std::shared_ptr<const ObserverList> &list)
+      ATLAS_NOEXCEPT;
+
+  /**
+   * The snapshots iterated by the notifications of the calling thread, the
+   * innermost last.
+   */
+  static std::vector<const ObserverList *> &ActiveSnapshots() ATLAS_NOEXCEPT;
+
   //============================================================================
   // P R I V A T E   M E M B E R S
 
   /**
-   * This list of all the observers that are currently attached to this subject.
+   * The immutable list of all the observers that are currently attached to
+   * this subject. It is only accessed with std::atomic_load and
+   * std::atomic_store, a new list being published on every change.
    */
-  std::vector<Observer<Args_...> *> observers_;
+  std::shared_ptr<const ObserverList> observers_;
 
   /**
-   * A mutex that is going to be locked every time we try to access the list
-   * of observers.
-   * This provides thread safety for the all class ressources.
+   * Serializes the writers of the observers_ list -- i.e. Attach and Detach.
+   * Notify never locks it.
    */
   mutable std::mutex observers_mutex_;
 };
@@ -30,6 +30,10 @@
 #include <assert.h>
 #include <lib_atlas/pattern/observer.h>
 #include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <utility>
 
 namespace atlas {
 
@@ -49,16 +53,22 @@ template <typename... Args_>
 ATLAS_ALWAYS_INLINE Subject<Args_...>::Subject(const Subject<Args_...> &rhs)
     ATLAS_NOEXCEPT : observers_(),
                      observers_mutex_() {
-  for (auto &observer : rhs.observers_) {
-    observer->Observe(*this);
+  auto observers = rhs.Snapshot();
+  if (observers) {
+    for (const auto &observer : *observers) {
+      observer->Observe(*this);
+    }
   }
 }
 //------------------------------------------------------------------------------
 //
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE Subject<Args_...>::~Subject() ATLAS_NOEXCEPT {
-  for (const auto &observer : observers_) {
-    observer->OnSubjectDisconnected(*this);
+  auto observers = Snapshot();
+  if (observers) {
+    for (const auto &observer : *observers) {
+      observer->OnSubjectDisconnected(*this);
+    }
   }
 }
 
@@ -71,8 +81,11 @@ template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Subject<Args_...>::operator=(
     const Subject<Args_...> &rhs) ATLAS_NOEXCEPT {
   DetachAll();
-  for (auto &observer : rhs.observers_) {
-    Attach(*observer);
+  auto observers = rhs.Snapshot();
+  if (observers) {
+    for (const auto &observer : *observers) {
+      Attach(*observer);
+    }
   }
 }
 
@@ -84,13 +97,21 @@ ATLAS_ALWAYS_INLINE void Subject<Args_...>::operator=(
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Subject<Args_...>::Attach(
     Observer<Args_...> &observer) {
-  std::unique_lock<std::mutex> locker(observers_mutex_);
-
-  auto it = std::find(observers_.begin(), observers_.end(), &observer);
-  if (it != observers_.end()) {
-    throw std::invalid_argument("The element is already in the container.");
-  } else {
-    observers_.push_back(&observer);
+  {
+    std::unique_lock<std::mutex> locker(observers_mutex_);
+    auto current = Snapshot();
+    ObserverList observers;
+    if (current) {
+      if (std::find(current->begin(), current->end(), &observer) !=
+          current->end()) {
+        throw std::invalid_argument(
+            "The element is already in the container.");
+      }
+      observers.reserve(current->size() + 1);
+      observers = *current;
+    }
+    observers.push_back(&observer);
+    Publish(std::move(observers));
   }
   observer.OnSubjectConnected(*this);
 }
@@ -100,12 +121,8 @@ ATLAS_ALWAYS_INLINE void Subject<Args_...>::Attach(
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Subject<Args_...>::Detach(
     Observer<Args_...> &observer) {
-  std::unique_lock<std::mutex> locker(observers_mutex_);
-  auto it = std::find(observers_.begin(), observers_.end(), &observer);
-  if (it == observers_.end()) {
+  if (!Remove(observer)) {
     throw std::invalid_argument("The element is not in the container.");
-  } else {
-    observers_.erase(it);
   }
   observer.OnSubjectDisconnected(*this);
 }
@@ -115,12 +132,8 @@ ATLAS_ALWAYS_INLINE void Subject<Args_...>::Detach(
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Subject<Args_...>::DetachNoCallback(
     Observer<Args_...> &observer) {
-  std::unique_lock<std::mutex> locker(observers_mutex_);
-  auto it = std::find(observers_.begin(), observers_.end(), &observer);
-  if (it == observers_.end()) {
+  if (!Remove(observer)) {
     throw std::invalid_argument("The element is not in the container.");
-  } else {
-    observers_.erase(it);
   }
 }
 
@@ -128,8 +141,21 @@ ATLAS_ALWAYS_INLINE void Subject<Args_...>::DetachNoCallback(
 //
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Subject<Args_...>::DetachAll() ATLAS_NOEXCEPT {
-  for (const auto &observer : observers_) {
-    Detach(*observer);
+  // Copy the list rather than holding the snapshot, Remove waits until
+  // nobody holds it anymore.
+  ObserverList observers;
+  {
+    auto snapshot = Snapshot();
+    if (!snapshot) {
+      return;
+    }
+    observers = *snapshot;
+  }
+  for (const auto &observer : observers) {
+    // Another thread may have detached the observer in the meantime.
+    if (Remove(*observer)) {
+      observer->OnSubjectDisconnected(*this);
+    }
   }
 }
 
@@ -138,10 +164,22 @@ ATLAS_ALWAYS_INLINE void Subject<Args_...>::DetachAll() ATLAS_NOEXCEPT {
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Subject<Args_...>::Notify(Args_... args)
     ATLAS_NOEXCEPT {
-  std::unique_lock<std::mutex> locker(observers_mutex_);
-  for (const auto &observer : observers_) {
-    observer->OnSubjectNotify(*this, args...);
+  auto observers = Snapshot();
+  if (!observers) {
+    return;
+  }
+  // Registering the snapshot lets a Detach called from an observer know that
+  // it must not wait for this notification to be over.
+  auto &active = ActiveSnapshots();
+  active.push_back(observers.get());
+  // The arguments taken by value belong to this call: the last observer can
+  // have them moved rather than copied.
+  const size_t last = observers->size() - 1;
+  for (size_t i = 0; i < last; ++i) {
+    (*observers)[i]->Dispatch(*this, args...);
   }
+  (*observers)[last]->Dispatch(*this, std::forward<Args_>(args)...);
+  active.pop_back();
 }
 
 //------------------------------------------------------------------------------
@@ -149,8 +187,96 @@ ATLAS_ALWAYS_INLINE void Subject<Args_...>::Notify(Args_... args)
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE size_t
 Subject<Args_...>::ObserverCount() const ATLAS_NOEXCEPT {
-  std::unique_lock<std::mutex> locker(observers_mutex_);
-  return observers_.size();
+  auto observers = Snapshot();
+  return observers ? observers->size() : 0;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE bool Subject<Args_...>::HasQueuedObservers() const
+    ATLAS_NOEXCEPT {
+  auto observers = Snapshot();
+  if (!observers) {
+    return false;
+  }
+  return std::any_of(
+      observers->begin(), observers->end(),
+      [](const Observer<Args_...> *observer) { return observer->IsQueued(); });
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE bool Subject<Args_...>::Remove(
+    Observer<Args_...> &observer) {
+  std::shared_ptr<const ObserverList> previous;
+  {
+    std::unique_lock<std::mutex> locker(observers_mutex_);
+    previous = Snapshot();
+    if (!previous) {
+      return false;
+    }
+    auto it = std::find(previous->begin(), previous->end(), &observer);
+    if (it == previous->end()) {
+      return false;
+    }
+    ObserverList observers;
+    observers.reserve(previous->size() - 1);
+    observers.insert(observers.end(), previous->begin(), it);
+    observers.insert(observers.end(), it + 1, previous->end());
+    Publish(std::move(observers));
+  }
+  // The lock is released so the observers that are being notified can still
+  // attach or detach while we wait for them.
+  WaitForReaders(previous);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void Subject<Args_...>::Publish(
+    ObserverList &&observers) {
+  std::shared_ptr<const ObserverList> snapshot;
+  if (!observers.empty()) {
+    snapshot = std::make_shared<const ObserverList>(std::move(observers));
+  }
+  std::atomic_store(&observers_, std::move(snapshot));
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE
+    std::shared_ptr<const typename Subject<Args_...>::ObserverList>
+    Subject<Args_...>::Snapshot() const ATLAS_NOEXCEPT {
+  return std::atomic_load(&observers_);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void Subject<Args_...>::WaitForReaders(
+    const std::shared_ptr<const ObserverList> &list) ATLAS_NOEXCEPT {
+  // Every notification iterating the list holds a reference on it, and no new
+  // one can start since the list has been replaced.
+  const auto &active = ActiveSnapshots();
+  auto own = std::count(active.begin(), active.end(), list.get());
+  while (list.use_count() > 1 + own) {
+    std::this_thread::yield();
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE
+    std::vector<const typename Subject<Args_...>::ObserverList *> &
+    Subject<Args_...>::ActiveSnapshots() ATLAS_NOEXCEPT {
+  static thread_local std::vector<const ObserverList *> snapshots;
+  return snapshots;
 }
 
 }  // namespace atlas
@@ -0,0 +1,168 @@
+/**
+ * \file	task_future.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_TASK_FUTURE_H_
+#define LIB_ATLAS_PATTERN_TASK_FUTURE_H_
+
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/details/future_state.h>
+#include <lib_atlas/pattern/thread_pool.h>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace atlas {
+
+namespace details {
+
+/**
+ * The type returned by a continuation of a TaskFuture<Tp_>.
+ */
+template <class Tp_, class Fn_>
+struct ContinuationResult {
+  using type = typename std::result_of<typename std::decay<Fn_>::type &(
+      const Tp_ &)>::type;
+};
+
+template <class Fn_>
+struct ContinuationResult<void, Fn_> {
+  using type =
+      typename std::result_of<typename std::decay<Fn_>::type &()>::type;
+};
+
+/**
+ * The type returned by TaskFuture<Tp_>::Get().
+ */
+template <class Tp_>
+struct FutureReference {
+  using type = const Tp_ &;
+};
+
+template <>
+struct FutureReference<void> {
+  using type = void;
+};
+
+}  // namespace details
+
+/**
+ * The result of a task executed on a ThreadPool, which can be chained with
+ * other tasks without blocking a worker.
+ *
+ * Then() schedules a continuation on the pool once the result is available,
+ * and WhenAll() combines several results. Contrary to std::future, the
+ * result can be read by several consumers, as with std::shared_future.
+ *
+ * If a task throws, its continuations are not executed: they forward the
+ * exception, which Get() finally rethrows.
+ */
+template <class Tp_>
+class TaskFuture {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using State = details::FutureState<Tp_>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * A future without a state, as a default constructed std::future.
+   */
+  TaskFuture() ATLAS_NOEXCEPT;
+
+  explicit TaskFuture(std::shared_ptr<State> state) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  bool IsValid() const ATLAS_NOEXCEPT;
+
+  bool IsReady() const;
+
+  void Wait() const;
+
+  /**
+   * Wait for the result. As it blocks, this should not be called from a
+   * worker of the pool -- use Then() instead.
+   *
+   * \throw The exception thrown by the task.
+   */
+  typename details::FutureReference<Tp_>::type Get() const;
+
+  /**
+   * Execute fn with the result of this future once it is ready, on the pool
+   * of this future.
+   *
+   * \param fn A copyable callable taking a const Tp_ &, or no argument if
+   *        Tp_ is void.
+   * \return The future of the result of fn.
+   */
+  template <class Fn_>
+  TaskFuture<typename details::ContinuationResult<Tp_, Fn_>::type> Then(
+      Fn_ &&fn, ThreadPool::Priority priority = ThreadPool::Priority::kNormal)
+      const;
+
+  const std::shared_ptr<State> &GetState() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  const std::shared_ptr<State> &CheckedState() const;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::shared_ptr<State> state_;
+};
+
+/**
+ * Execute a function on a pool.
+ *
+ * \return The future of its result, on which continuations can be chained.
+ */
+template <class Fn_, class... Args_>
+TaskFuture<typename std::result_of<Fn_(Args_...)>::type> Async(
+    ThreadPool &pool, Fn_ &&fn, Args_ &&... args);
+
+/**
+ * \return A future ready once all the futures are, holding their results in
+ *         order. If one of them failed, it holds the exception of the first
+ *         one that did.
+ */
+template <class Tp_>
+TaskFuture<std::vector<Tp_>> WhenAll(
+    const std::vector<TaskFuture<Tp_>> &futures);
+
+TaskFuture<void> WhenAll(const std::vector<TaskFuture<void>> &futures);
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/task_future_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_TASK_FUTURE_H_
@@ -0,0 +1,245 @@
+/**
+ * \file	task_future_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_TASK_FUTURE_H_
+#error This file may only be included from task_future.h
+#endif
+
+#include <atomic>
+#include <functional>
+#include <utility>
+
+namespace atlas {
+
+namespace details {
+
+//------------------------------------------------------------------------------
+//
+template <class Fn_>
+auto ApplyResult(Fn_ &fn, FutureState<void> &) -> decltype(fn()) {
+  return fn();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Fn_, class Tp_>
+auto ApplyResult(Fn_ &fn, FutureState<Tp_> &state)
+    -> decltype(fn(state.Get())) {
+  return fn(state.Get());
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+std::vector<Tp_> CollectResults(const std::vector<TaskFuture<Tp_>> &futures) {
+  std::vector<Tp_> results;
+  results.reserve(futures.size());
+  for (const auto &future : futures) {
+    results.push_back(future.GetState()->Get());
+  }
+  return results;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void CollectResults(const std::vector<TaskFuture<void>> &) {}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_, class Rp_>
+TaskFuture<Rp_> WhenAllOf(const std::vector<TaskFuture<Tp_>> &futures) {
+  ThreadPool *pool = nullptr;
+  for (const auto &future : futures) {
+    if (!future.IsValid()) {
+      throw std::future_error(std::future_errc::no_state);
+    }
+    pool = future.GetState()->GetPool();
+  }
+
+  auto next = std::make_shared<FutureState<Rp_>>(pool);
+  auto inputs = std::make_shared<std::vector<TaskFuture<Tp_>>>(futures);
+  auto collect = [next, inputs] {
+    for (const auto &input : *inputs) {
+      if (input.GetState()->GetError()) {
+        next->SetError(input.GetState()->GetError());
+        return;
+      }
+    }
+    Fulfill(*next, [&inputs] { return CollectResults(*inputs); });
+  };
+  if (futures.empty()) {
+    collect();
+    return TaskFuture<Rp_>(next);
+  }
+
+  // The last input to complete collects the results on its own thread,
+  // which is cheap compared to scheduling a task.
+  auto remaining = std::make_shared<std::atomic<size_t>>(futures.size());
+  for (const auto &future : futures) {
+    future.GetState()->AddContinuation([remaining, collect] {
+      if (remaining->fetch_sub(1) == 1) {
+        collect();
+      }
+    });
+  }
+  return TaskFuture<Rp_>(next);
+}
+
+}  // namespace details
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+TaskFuture<Tp_>::TaskFuture() ATLAS_NOEXCEPT : state_() {}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+TaskFuture<Tp_>::TaskFuture(std::shared_ptr<State> state) ATLAS_NOEXCEPT
+    : state_(std::move(state)) {}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+bool TaskFuture<Tp_>::IsValid() const ATLAS_NOEXCEPT {
+  return state_ != nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+bool TaskFuture<Tp_>::IsReady() const {
+  return CheckedState()->IsReady();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+void TaskFuture<Tp_>::Wait() const {
+  CheckedState()->Wait();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+typename details::FutureReference<Tp_>::type TaskFuture<Tp_>::Get() const {
+  CheckedState()->Wait();
+  return state_->Get();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+template <class Fn_>
+TaskFuture<typename details::ContinuationResult<Tp_, Fn_>::type>
+TaskFuture<Tp_>::Then(Fn_ &&fn, ThreadPool::Priority priority) const {
+  using result_type = typename details::ContinuationResult<Tp_, Fn_>::type;
+  using function_type = typename std::decay<Fn_>::type;
+
+  std::shared_ptr<State> state = CheckedState();
+  auto next = std::make_shared<details::FutureState<result_type>>(
+      state->GetPool());
+  function_type function(std::forward<Fn_>(fn));
+  state->AddContinuation([state, next, function, priority] {
+    if (state->GetError()) {
+      next->SetError(state->GetError());
+      return;
+    }
+    auto run = [state, next, function]() mutable {
+      details::Fulfill(*next, [&state, &function] {
+        return details::ApplyResult(function, *state);
+      });
+    };
+    ThreadPool *pool = state->GetPool();
+    if (pool == nullptr) {
+      run();
+      return;
+    }
+    try {
+      pool->Post(priority, run);
+    } catch (...) {
+      // The pool is stopping.
+      next->SetError(std::current_exception());
+    }
+  });
+  return TaskFuture<result_type>(next);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+const std::shared_ptr<typename TaskFuture<Tp_>::State>
+    &TaskFuture<Tp_>::GetState() const ATLAS_NOEXCEPT {
+  return state_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+const std::shared_ptr<typename TaskFuture<Tp_>::State>
+    &TaskFuture<Tp_>::CheckedState() const {
+  if (state_ == nullptr) {
+    throw std::future_error(std::future_errc::no_state);
+  }
+  return state_;
+}
+
+//==============================================================================
+// F U N C T I O N S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Fn_, class... Args_>
+TaskFuture<typename std::result_of<Fn_(Args_...)>::type> Async(
+    ThreadPool &pool, Fn_ &&fn, Args_ &&... args) {
+  using result_type = typename std::result_of<Fn_(Args_...)>::type;
+  auto state = std::make_shared<details::FutureState<result_type>>(&pool);
+  auto bound = std::bind(std::forward<Fn_>(fn), std::forward<Args_>(args)...);
+  pool.Post([state, bound]() mutable { details::Fulfill(*state, bound); });
+  return TaskFuture<result_type>(state);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+TaskFuture<std::vector<Tp_>> WhenAll(
+    const std::vector<TaskFuture<Tp_>> &futures) {
+  return details::WhenAllOf<Tp_, std::vector<Tp_>>(futures);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE TaskFuture<void> WhenAll(
+    const std::vector<TaskFuture<void>> &futures) {
+  return details::WhenAllOf<void, void>(futures);
+}
+
+}  // namespace atlas
@@ -0,0 +1,173 @@
+/**
+ * \file	task_graph.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_TASK_GRAPH_H_
+#define LIB_ATLAS_PATTERN_TASK_GRAPH_H_
+
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/task_future.h>
+#include <lib_atlas/pattern/thread_pool.h>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * A directed acyclic graph of tasks executed on a ThreadPool.
+ *
+ * The graph is built once, with Add() and Precede(), and can then be run
+ * as many times as needed. A task is posted on the pool as soon as all its
+ * predecessors are done, so no worker ever waits for another task.
+ *
+ * If a task throws, the tasks that did not start yet are skipped and the
+ * future returned by Run() holds the exception.
+ *
+ * \code
+ * TaskGraph graph(pool);
+ * auto undistort = graph.Add([&] { Undistort(image); });
+ * auto threshold = graph.Add([&] { Threshold(image); }, {undistort});
+ * auto contours = graph.Add([&] { FindContours(image); }, {threshold});
+ * graph.Add([&] { Fuse(); }, {contours});
+ * graph.Run().Wait();
+ * \endcode
+ */
+class TaskGraph {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using NodeId = size_t;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  explicit TaskGraph(ThreadPool &pool) ATLAS_NOEXCEPT;
+
+  /**
+   * Wait for the current run, if any.
+   */
+  ~TaskGraph() ATLAS_NOEXCEPT;
+
+  TaskGraph(const TaskGraph &) = delete;
+
+  TaskGraph &operator=(const TaskGraph &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Add a task executed once all the dependencies are done.
+   *
+   * \throw std::logic_error if the graph is running.
+   */
+  template <class Fn_>
+  NodeId Add(Fn_ &&fn, std::initializer_list<NodeId> dependencies = {},
+             ThreadPool::Priority priority = ThreadPool::Priority::kNormal);
+
+  /**
+   * Make the task after wait for the task before.
+   *
+   * \throw std::out_of_range if one of the tasks does not exist.
+   * \throw std::logic_error if the graph is running.
+   */
+  void Precede(NodeId before, NodeId after);
+
+  /**
+   * Post the tasks without predecessors on the pool.
+   *
+   * \return A future ready once all the tasks are done.
+   * \throw std::logic_error if the graph is already running.
+   * \throw std::invalid_argument if the graph has a cycle.
+   */
+  TaskFuture<void> Run();
+
+  bool IsRunning() const ATLAS_NOEXCEPT;
+
+  size_t GetNodeCount() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  struct Node {
+    std::function<void()> fn;
+
+    ThreadPool::Priority priority;
+
+    std::vector<NodeId> successors;
+
+    size_t predecessors;
+
+    /** The predecessors not done yet in the current run. */
+    std::atomic<size_t> remaining;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  void CheckNotRunning() const;
+
+  /**
+   * Throw if the graph has a cycle, which would never complete.
+   */
+  void CheckAcyclic() const;
+
+  void Schedule(NodeId id);
+
+  /**
+   * Execute a task, then schedule its successors that are ready.
+   */
+  void Execute(NodeId id) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  ThreadPool &pool_;
+
+  std::vector<std::unique_ptr<Node>> nodes_;
+
+  /** The state of the current or of the last run. */
+  std::shared_ptr<details::FutureState<void>> run_;
+
+  /** The tasks not done yet in the current run. */
+  std::atomic<size_t> pending_;
+
+  std::atomic<bool> has_failed_;
+
+  std::exception_ptr error_;
+
+  std::mutex error_mutex_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/task_graph_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_TASK_GRAPH_H_
@@ -0,0 +1,226 @@
+/**
+ * \file	task_graph_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_TASK_GRAPH_H_
+#error This file may only be included from task_graph.h
+#endif
+
+#include <stdexcept>
+#include <utility>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE TaskGraph::TaskGraph(ThreadPool &pool) ATLAS_NOEXCEPT
+    : pool_(pool),
+      nodes_(),
+      run_(),
+      pending_(0),
+      has_failed_(false),
+      error_(),
+      error_mutex_() {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE TaskGraph::~TaskGraph() ATLAS_NOEXCEPT {
+  if (run_ != nullptr) {
+    run_->Wait();
+  }
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Fn_>
+TaskGraph::NodeId TaskGraph::Add(Fn_ &&fn,
+                                 std::initializer_list<NodeId> dependencies,
+                                 ThreadPool::Priority priority) {
+  CheckNotRunning();
+  for (NodeId dependency : dependencies) {
+    if (dependency >= nodes_.size()) {
+      throw std::out_of_range("TaskGraph::Add: unknown dependency");
+    }
+  }
+
+  std::unique_ptr<Node> node(new Node());
+  node->fn = std::forward<Fn_>(fn);
+  node->priority = priority;
+  node->predecessors = 0;
+  node->remaining.store(0, std::memory_order_relaxed);
+  nodes_.push_back(std::move(node));
+
+  NodeId id = nodes_.size() - 1;
+  for (NodeId dependency : dependencies) {
+    Precede(dependency, id);
+  }
+  return id;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void TaskGraph::Precede(NodeId before, NodeId after) {
+  CheckNotRunning();
+  if (before >= nodes_.size() || after >= nodes_.size()) {
+    throw std::out_of_range("TaskGraph::Precede: unknown task");
+  }
+  nodes_[before]->successors.push_back(after);
+  ++nodes_[after]->predecessors;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE TaskFuture<void> TaskGraph::Run() {
+  CheckNotRunning();
+  CheckAcyclic();
+
+  for (auto &node : nodes_) {
+    node->remaining.store(node->predecessors, std::memory_order_relaxed);
+  }
+  pending_.store(nodes_.size(), std::memory_order_relaxed);
+  has_failed_.store(false, std::memory_order_relaxed);
+  error_ = nullptr;
+  run_ = std::make_shared<details::FutureState<void>>(&pool_);
+  TaskFuture<void> future(run_);
+
+  if (nodes_.empty()) {
+    run_->SetValue();
+    return future;
+  }
+  // The roots are listed before the first one is scheduled, as it could
+  // complete the whole graph before the loop ends.
+  std::vector<NodeId> roots;
+  for (NodeId id = 0; id < nodes_.size(); ++id) {
+    if (nodes_[id]->predecessors == 0) {
+      roots.push_back(id);
+    }
+  }
+  for (NodeId id : roots) {
+    Schedule(id);
+  }
+  return future;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool TaskGraph::IsRunning() const ATLAS_NOEXCEPT {
+  return run_ != nullptr && !run_->IsReady();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t TaskGraph::GetNodeCount() const ATLAS_NOEXCEPT {
+  return nodes_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void TaskGraph::CheckNotRunning() const {
+  if (IsRunning()) {
+    throw std::logic_error("The TaskGraph is running.");
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void TaskGraph::CheckAcyclic() const {
+  // Kahn's algorithm: a graph is acyclic if removing the nodes without
+  // predecessors one by one removes them all.
+  std::vector<size_t> remaining(nodes_.size());
+  std::vector<NodeId> ready;
+  for (NodeId id = 0; id < nodes_.size(); ++id) {
+    remaining[id] = nodes_[id]->predecessors;
+    if (remaining[id] == 0) {
+      ready.push_back(id);
+    }
+  }
+  size_t visited = 0;
+  while (!ready.empty()) {
+    NodeId id = ready.back();
+    ready.pop_back();
+    ++visited;
+    for (NodeId successor : nodes_[id]->successors) {
+      if (--remaining[successor] == 0) {
+        ready.push_back(successor);
+      }
+    }
+  }
+  if (visited != nodes_.size()) {
+    throw std::invalid_argument("The TaskGraph has a cycle.");
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void TaskGraph::Schedule(NodeId id) {
+  try {
+    pool_.Post(nodes_[id]->priority, [this, id] { Execute(id); });
+  } catch (const std::runtime_error &) {
+    // The pool is stopping, the task is executed by the calling thread.
+    Execute(id);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void TaskGraph::Execute(NodeId id) ATLAS_NOEXCEPT {
+  Node &node = *nodes_[id];
+  if (!has_failed_.load(std::memory_order_acquire)) {
+    try {
+      node.fn();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex_);
+      if (!has_failed_.load(std::memory_order_relaxed)) {
+        error_ = std::current_exception();
+        has_failed_.store(true, std::memory_order_release);
+      }
+    }
+  }
+
+  for (NodeId successor : node.successors) {
+    if (nodes_[successor]->remaining.fetch_sub(1) == 1) {
+      Schedule(successor);
+    }
+  }
+
+  if (pending_.fetch_sub(1) == 1) {
+    // Once the state is ready, the graph may be destroyed by a thread
+    // waiting for it, so nothing of the graph is used after.
+    std::shared_ptr<details::FutureState<void>> run = run_;
+    std::exception_ptr error = error_;
+    if (error) {
+      run->SetError(error);
+    } else {
+      run->SetValue();
+    }
+  }
+}
+
+}  // namespace atlas
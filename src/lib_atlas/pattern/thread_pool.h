@@ -26,17 +26,26 @@
 #ifndef LIB_ATLAS_PATTERN_THREAD_POOL_H_
 #define LIB_ATLAS_PATTERN_THREAD_POOL_H_
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <stdexcept>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 #include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/details/block_pool.h>
+#include <lib_atlas/pattern/details/parallel_loop.h>
+#include <lib_atlas/pattern/details/small_task.h>
+#include <lib_atlas/pattern/details/work_stealing_deque.h>
+#include <lib_atlas/sys/latency_histogram.h>
+#include <lib_atlas/sys/thread.h>
 
 namespace atlas {
 
@@ -53,6 +62,35 @@ namespace atlas {
  * an instance of a task in, for exemple, a loop. You could use a thread pool
  * for your application and simply add a thread in this pool fo your need.
  *
+ * By default, all the workers share a single queue protected by a mutex. With
+ * Scheduling::kWorkStealing, every worker owns a Chase-Lev deque instead: the
+ * tasks enqueued from a worker go to its own deque without locking, and the
+ * idle workers steal from the others. Only the tasks enqueued from outside
+ * the pool go through a shared queue, from which the workers take a batch at
+ * a time.
+ *
+ * Submitting a task does not allocate once the pool is warmed up: the
+ * callables are stored in recycled queue nodes with a small inline buffer,
+ * and the shared states of the futures come from a pool of blocks.
+ *
+ * ParallelFor and ParallelReduce split a range of indices between the
+ * workers and the calling thread.
+ *
+ * A task can be given a Priority and a deadline through TaskOptions. The
+ * realtime tasks are executed before the normal ones, and the background
+ * ones only when nothing else is queued. With Scheduling::kWorkStealing, the
+ * realtime and background tasks always go through the shared queues, the
+ * deques of the workers only holding normal tasks.
+ *
+ * Every worker can be created with its own ThreadAttributes, to pin it to a
+ * CPU or give it a realtime policy.
+ *
+ * A pool created from a Sizing is elastic: it starts min_threads workers,
+ * adds workers up to max_threads while the queued tasks outnumber the idle
+ * workers, and a worker idle for idle_timeout exits. The idle workers of
+ * such a pool spin for a while before parking, which shortens the wake-up
+ * of bursty work such as the processing of a frame.
+ *
  * This thread pool is based on this open implementation from:
  * https://github.com/progschj/ThreadPool
  */
@@ -63,109 +101,546 @@ class ThreadPool {
 
   using Ptr = std::shared_ptr<ThreadPool>;
 
+  enum class Scheduling { kSharedQueue = 0, kWorkStealing };
+
+  enum class Priority { kRealtime = 0, kNormal, kBackground };
+
+  /**
+   * What to do with a task whose deadline passed before it started.
+   */
+  enum class Expiry {
+    /** Do not execute the task. The future of an Enqueue-d task then
+        throws a std::future_error with std::future_errc::broken_promise. */
+    kDrop = 0,
+    /** Execute the task anyway, IsLate() returning true while it runs. */
+    kRunLate
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  struct TaskOptions {
+    TaskOptions(Priority priority = Priority::kNormal,
+                Clock::time_point deadline = Clock::time_point::max(),
+                Expiry expiry = Expiry::kDrop) ATLAS_NOEXCEPT;
+
+    Priority priority;
+
+    /** Clock::time_point::max() for no deadline. */
+    Clock::time_point deadline;
+
+    Expiry expiry;
+  };
+
+  /**
+   * True for the types that select the options overloads of Enqueue and
+   * Post.
+   */
+  template <class Tp_>
+  struct IsOptions
+      : std::integral_constant<
+            bool,
+            std::is_same<typename std::decay<Tp_>::type, TaskOptions>::value ||
+                std::is_same<typename std::decay<Tp_>::type,
+                             Priority>::value> {};
+
+  /**
+   * The statistics of a priority class -- see GetPriorityStats().
+   */
+  struct PriorityStats {
+    /** Number of tasks executed, late or not, while the stats were
+        enabled. */
+    uint64_t executed = {0};
+
+    /** Number of tasks that started after their deadline, dropped or not. */
+    uint64_t expired = {0};
+
+    uint64_t dropped = {0};
+
+    /** Time between the submission of the tasks and their start. */
+    LatencyHistogramSnapshot wait;
+  };
+
+  static const size_t kPriorityCount = 3;
+
+  /**
+   * The bounds of an elastic pool.
+   */
+  struct Sizing {
+    size_t min_threads = {0};
+
+    size_t max_threads = {1};
+
+    /** How long a worker waits for a task before exiting, as long as there
+        are more than min_threads workers. */
+    std::chrono::milliseconds idle_timeout = {std::chrono::milliseconds(1000)};
+
+    /** Number of checks for a task before an idle worker parks. */
+    size_t spin_count = {1000};
+
+    /** The attributes of every worker. */
+    ThreadAttributes attributes;
+  };
+
+  /**
+   * How ParallelFor and ParallelReduce cut their range in chunks.
+   */
+  enum class Partition {
+    /** One chunk per thread, for iterations of equal cost. */
+    kStatic = 0,
+    /** Chunks of grain iterations, claimed one at a time. */
+    kDynamic,
+    /** Chunks shrinking with the remaining iterations, down to grain. */
+    kGuided
+  };
+
   //============================================================================
   // P U B L I C   C / D T O R S
 
-  explicit ThreadPool(size_t) ATLAS_NOEXCEPT;
+  /**
+   * Create threads workers with the default attributes.
+   *
+   * \throw std::system_error if a worker cannot be created. The workers
+   *        already created are then stopped.
+   */
+  explicit ThreadPool(size_t threads,
+                      Scheduling scheduling = Scheduling::kSharedQueue);
+
+  /**
+   * Create a worker for each element of workers, with these attributes.
+   *
+   * \throw std::system_error if a worker cannot be created with its
+   *        attributes. The workers already created are then stopped.
+   */
+  explicit ThreadPool(const std::vector<ThreadAttributes> &workers,
+                      Scheduling scheduling = Scheduling::kSharedQueue);
+
+  /**
+   * Create an elastic pool.
+   *
+   * \throw std::invalid_argument if max_threads is 0 or lower than
+   *        min_threads.
+   * \throw std::system_error if the first workers cannot be created.
+   */
+  explicit ThreadPool(const Sizing &sizing,
+                      Scheduling scheduling = Scheduling::kSharedQueue);
 
   ~ThreadPool() ATLAS_NOEXCEPT;
 
+  ThreadPool(const ThreadPool &) = delete;
+
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
   //============================================================================
   // P U B L I C  M E T H O D S
 
-  template <class Tp_, class... Args_>
+  template <class Tp_, class... Args_,
+            class = typename std::enable_if<!IsOptions<Tp_>::value>::type>
   std::future<typename std::result_of<Tp_(Args_...)>::type> Enqueue(
       Tp_ &&f, Args_ &&... args);
 
+  /**
+   * Enqueue a task with a priority and a deadline. A Priority can be given
+   * in place of the options.
+   */
+  template <class Tp_, class... Args_>
+  std::future<typename std::result_of<Tp_(Args_...)>::type> Enqueue(
+      const TaskOptions &options, Tp_ &&f, Args_ &&... args);
+
+  /**
+   * Execute a function on the pool without a way to get its result or to
+   * wait for it. This is cheaper than Enqueue, and does not allocate if the
+   * bound function fits in details::SmallTask::kInlineSize bytes.
+   *
+   * As for a std::thread, an exception thrown by the function terminates the
+   * program.
+   */
+  template <class Tp_, class... Args_,
+            class = typename std::enable_if<!IsOptions<Tp_>::value>::type>
+  void Post(Tp_ &&f, Args_ &&... args);
+
+  template <class Tp_, class... Args_>
+  void Post(const TaskOptions &options, Tp_ &&f, Args_ &&... args);
+
+  /**
+   * Call fn(i) for every i in [begin, end) and return once they are all
+   * done.
+   *
+   * A single batch of helper tasks is enqueued, and the calling thread
+   * executes chunks as well until the range is exhausted. As it never waits
+   * for a helper that did not start, ParallelFor can be called from a
+   * worker of the pool.
+   *
+   * \param grain The minimum number of iterations of a chunk.
+   * \throw The first exception thrown by fn, once the chunks being executed
+   *        are done. The chunks that were not started are skipped.
+   */
+  template <class Index_, class Fn_>
+  void ParallelFor(Index_ begin, Index_ end,
+                   typename std::common_type<Index_>::type grain, Fn_ &&fn,
+                   Partition partition = Partition::kDynamic);
+
+  /**
+   * Reduce the range [begin, end) in parallel, as ParallelFor.
+   *
+   * Every thread reduces the chunks it claims with map(first, last), merges
+   * the results with combine(a, b), and finally merges its result with the
+   * ones of the other threads. The order of the merges is not specified, so
+   * combine must be associative and commutative.
+   *
+   * \param identity The neutral element of combine.
+   */
+  template <class Index_, class Tp_, class Map_, class Combine_>
+  Tp_ ParallelReduce(Index_ begin, Index_ end,
+                     typename std::common_type<Index_>::type grain,
+                     Tp_ identity, Map_ &&map, Combine_ &&combine,
+                     Partition partition = Partition::kDynamic);
+
+  /**
+   * \return The number of workers alive.
+   */
+  size_t GetThreadCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of workers looking for a task or parked.
+   */
+  size_t GetIdleCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of workers executing a task.
+   */
+  size_t GetActiveCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of tasks waiting for a worker.
+   */
+  size_t GetQueuedCount() const ATLAS_NOEXCEPT;
+
+  bool IsElastic() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return A copy of the attributes of a worker. An elastic pool replaces
+   *         the workers of its slots, so they cannot be referenced.
+   * \throw std::out_of_range if index is not a slot of the pool.
+   */
+  ThreadAttributes GetWorkerAttributes(size_t index) const;
+
+  /**
+   * \throw std::out_of_range if index is not a slot of the pool.
+   */
+  pthread_t GetWorkerHandle(size_t index) const;
+
+  Scheduling GetScheduling() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of tasks a worker took from the deque of another
+   *         worker. Always 0 with Scheduling::kSharedQueue.
+   */
+  uint64_t GetStealCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * Count the executed tasks and measure their wait time. This costs a clock
+   * read on the submission and on the start of every task, so it is disabled
+   * by default. The expired and dropped tasks are always counted.
+   */
+  void EnableStats(bool enable = true) ATLAS_NOEXCEPT;
+
+  bool IsStatsEnabled() const ATLAS_NOEXCEPT;
+
+  PriorityStats GetPriorityStats(Priority priority) const;
+
+  void ResetStats() ATLAS_NOEXCEPT;
+
+  /**
+   * \return From a task of the pool, true if the task started after its
+   *         deadline -- see Expiry::kRunLate.
+   */
+  static bool IsLate() ATLAS_NOEXCEPT;
+
  private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  using Task = details::SmallTask;
+
+  struct TaskNode {
+    Task task;
+
+    TaskNode *next;
+
+    /** True if the node comes from the free list of the pool. */
+    bool is_shared;
+
+    Priority priority;
+
+    Expiry expiry;
+
+    /** kNoDeadline if the task has no deadline. */
+    int64_t deadline_ns;
+
+    /** 0 if the stats were disabled when the task was submitted. */
+    int64_t submit_ns;
+  };
+
+  /**
+   * An intrusive list of task nodes, used both as a queue and as a free list.
+   */
+  struct TaskList {
+    void PushBack(TaskNode *node) ATLAS_NOEXCEPT;
+
+    void PushFront(TaskNode *node) ATLAS_NOEXCEPT;
+
+    TaskNode *PopFront() ATLAS_NOEXCEPT;
+
+    bool IsEmpty() const ATLAS_NOEXCEPT;
+
+    /** Move all the nodes of a list at the end of this one. */
+    void Splice(TaskList &list) ATLAS_NOEXCEPT;
+
+    void DeleteAll() ATLAS_NOEXCEPT;
+
+    TaskNode *head = {nullptr};
+
+    TaskNode *tail = {nullptr};
+
+    size_t size = {0};
+  };
+
+  /**
+   * The state owned by a worker when stealing work.
+   */
+  struct WorkerQueue {
+    details::WorkStealingDeque<TaskNode> deque;
+
+    /** The nodes of the tasks enqueued from this worker it executed. */
+    TaskList free_nodes;
+
+    /**
+     * The nodes of the tasks enqueued from outside the pool this worker
+     * executed, given back to the pool the next time it locks the mutex.
+     */
+    TaskList shared_nodes;
+  };
+
+  /**
+   * The thread local identity of a worker, so Enqueue knows whether it is
+   * called from one of the workers of the pool.
+   */
+  struct WorkerSlot {
+    const ThreadPool *pool;
+    size_t index;
+  };
+
+  /**
+   * The statistics of a priority class, in the pool.
+   */
+  struct PriorityCounters {
+    std::atomic<uint64_t> executed;
+
+    std::atomic<uint64_t> expired;
+
+    std::atomic<uint64_t> dropped;
+
+    LatencyHistogram wait;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Create the workers, or stop the ones already created if one fails.
+   *
+   * \param slots The maximum number of workers.
+   */
+  void StartWorkers(const std::vector<ThreadAttributes> &workers,
+                    size_t slots);
+
+  Thread CreateWorker(size_t index, const ThreadAttributes &attributes);
+
+  /**
+   * Add workers to an elastic pool while the queued tasks outnumber the idle
+   * workers. The queue mutex must be locked.
+   */
+  void GrowIfNeeded() ATLAS_NOEXCEPT;
+
+  bool NeedsWorker() const ATLAS_NOEXCEPT;
+
+  /**
+   * Count a worker in or out of the idle ones.
+   */
+  void SetIdle(bool &is_idle, bool idle) ATLAS_NOEXCEPT;
+
+  /**
+   * Check for work spin_count_ times without locking.
+   *
+   * \return True if ready returned true.
+   */
+  template <class Predicate_>
+  bool Spin(Predicate_ ready) const;
+
+  /**
+   * Wait on the condition until ready returns true. In an elastic pool, the
+   * worker exits if it waited for idle_timeout_ and there are more than
+   * min_threads_ workers.
+   *
+   * \return False if the worker must exit.
+   */
+  template <class Predicate_>
+  bool Park(std::unique_lock<std::mutex> &lock, size_t index,
+            Predicate_ ready);
+
+  /**
+   * Wake the workers up and wait for them to execute the pending tasks.
+   */
+  void StopWorkers() ATLAS_NOEXCEPT;
+
+  void Submit(Task &&task, const TaskOptions &options);
+
+  /**
+   * Enqueue count copies of a function at once.
+   */
+  template <class Fn_>
+  void SubmitBatch(size_t count, const Fn_ &fn);
+
+  /**
+   * Execute a loop with the calling thread and as many workers as useful.
+   */
+  template <class Index_>
+  void RunParallelLoop(
+      Index_ begin, Index_ end, Index_ grain, Partition partition,
+      typename details::ParallelLoop<Index_>::Participant participant,
+      void *context);
+
+  /**
+   * Move a task in a node of the free list, or in a new node if it is empty.
+   */
+  TaskNode *AcquireNode(TaskList &free_nodes, Task &&task,
+                        const TaskOptions &options = TaskOptions());
+
+  /**
+   * Execute the task of a node, unless it expired and must be dropped.
+   */
+  void RunNode(TaskNode *node);
+
+  /**
+   * \return The first task of the shared queues by order of priority, or
+   *         nullptr if they are empty. The queue mutex must be locked.
+   */
+  TaskNode *PopShared() ATLAS_NOEXCEPT;
+
+  /**
+   * Add a task to the shared queue of its priority. The queue mutex must be
+   * locked.
+   */
+  void PushShared(TaskNode *node) ATLAS_NOEXCEPT;
+
+  /**
+   * Destroy the task of a node executed by a worker and keep the node for
+   * the next tasks.
+   */
+  void ReleaseNode(size_t index, TaskNode *node);
+
+  /**
+   * Give the shared nodes a worker executed back to the pool. The queue
+   * mutex must be locked.
+   */
+  void ReturnSharedNodes(size_t index) ATLAS_NOEXCEPT;
+
+  void RunSharedQueue(size_t index);
+
+  void RunWorkStealing(size_t index);
+
+  /**
+   * Look for a realtime task, then for a task in the deque of the worker,
+   * in the deques of the other workers, in the normal shared queue, and
+   * finally for a background task.
+   *
+   * \return The task, or nullptr if there is none.
+   */
+  TaskNode *FindTask(size_t index, uint32_t &seed);
+
+  /**
+   * Take a task from a shared queue. The normal tasks are taken in batches
+   * moved to the deque of the worker.
+   *
+   * \return The first task of the batch, or nullptr if the queue is empty.
+   */
+  TaskNode *TakeShared(size_t index, Priority priority);
+
+  static WorkerSlot &CurrentWorker() ATLAS_NOEXCEPT;
+
+  static bool &CurrentTaskIsLate() ATLAS_NOEXCEPT;
+
   //============================================================================
   // P R I V A T E   M E M B E R S
 
-  std::vector<std::thread> workers_;
+  Scheduling scheduling_;
 
-  std::queue<std::function<void()>> tasks_;
+  /** A slot per worker an elastic pool can have, joined when reused. */
+  std::vector<Thread> workers_;
 
-  mutable std::mutex queue_mutex_;
+  /** True for the slots with a running worker. */
+  std::vector<bool> is_running_;
 
-  std::condition_variable condition_;
+  bool is_elastic_;
 
-  bool is_stoped_;
-};
+  size_t min_threads_;
 
-//==============================================================================
-// C / D T O R   S E C T I O N
-
-//------------------------------------------------------------------------------
-//
-ThreadPool::ThreadPool(size_t threads) ATLAS_NOEXCEPT : workers_(),
-                                                        tasks_(),
-                                                        queue_mutex_(),
-                                                        condition_(),
-                                                        is_stoped_(false) {
-  for (size_t i = 0; i < threads; ++i) {
-    workers_.emplace_back([this] {
-      for (;;) {
-        std::function<void()> task;
-
-        {
-          auto lock = std::unique_lock<std::mutex>{queue_mutex_};
-          condition_.wait(lock,
-                          [this] { return is_stoped_ || !tasks_.empty(); });
-          if (is_stoped_ && tasks_.empty()) {
-            return;
-          }
-          task = std::move(tasks_.front());
-          tasks_.pop();
-        }
-
-        task();
-      }
-    });
-  }
-}
-
-//------------------------------------------------------------------------------
-//
-ThreadPool::~ThreadPool() ATLAS_NOEXCEPT {
-  {
-    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
-    is_stoped_ = true;
-  }
-  condition_.notify_all();
-  for (std::thread &worker : workers_) {
-    worker.join();
-  }
-}
+  size_t max_threads_;
 
-//==============================================================================
-// M E T H O D S   S E C T I O N
+  std::chrono::milliseconds idle_timeout_;
+
+  size_t spin_count_;
+
+  ThreadAttributes attributes_;
+
+  std::atomic<size_t> live_;
+
+  std::atomic<size_t> idle_;
+
+  /**
+   * The tasks of the workers by priority with Scheduling::kSharedQueue. With
+   * Scheduling::kWorkStealing, the normal tasks enqueued from outside the
+   * pool and all the realtime and background tasks.
+   */
+  TaskList tasks_[kPriorityCount];
+
+  /**
+   * The sizes of the shared queues, so the workers can skip the empty ones
+   * without locking.
+   */
+  std::atomic<size_t> shared_sizes_[kPriorityCount];
+
+  /** The nodes of the executed tasks given back to the pool. */
+  TaskList free_nodes_;
 
-//------------------------------------------------------------------------------
-//
-template <class Tp_, class... Args_>
-auto ThreadPool::Enqueue(Tp_ &&f, Args_ &&... args)
-    -> std::future<typename std::result_of<Tp_(Args_...)>::type> {
-  using return_type = typename std::result_of<Tp_(Args_...)>::type;
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
 
-  auto task = std::make_shared<std::packaged_task<return_type()>>(
-      std::bind(std::forward<Tp_>(f), std::forward<Args_>(args)...));
+  mutable std::mutex queue_mutex_;
+
+  std::condition_variable condition_;
+
+  std::atomic<bool> is_stoped_;
 
-  std::future<return_type> res = task->get_future();
+  /** Number of tasks queued and not taken yet, when stealing work. */
+  std::atomic<size_t> pending_;
 
-  {
-    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+  /** Number of workers waiting on the condition, when stealing work. */
+  std::atomic<size_t> sleepers_;
 
-    if (is_stoped_) {
-      throw std::runtime_error("enqueue on stopped ThreadPool");
-    }
+  std::atomic<uint64_t> steals_;
 
-    tasks_.emplace([task]() { (*task)(); });
-  }
+  std::atomic<bool> stats_enabled_;
 
-  condition_.notify_one();
-  return res;
-}
+  PriorityCounters counters_[kPriorityCount];
+
+  /** Maximum number of free nodes a worker keeps for itself. */
+  static const size_t kMaxFreeNodes = 256;
+
+  static const int64_t kNoDeadline = INT64_MAX;
+};
 
 }  // namespace atlas
 
+#include <lib_atlas/pattern/thread_pool_inl.h>
+
 #endif  // LIB_ATLAS_PATTERN_THREAD_POOL_H_
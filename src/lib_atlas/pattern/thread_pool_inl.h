@@ -0,0 +1,978 @@
+/**
+ * \file	thread_pool_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_THREAD_POOL_H_
+#error This file may only be included from thread_pool.h
+#endif
+
+#include <lib_atlas/sys/instrumented_lock.h>
+#include <lib_atlas/sys/timer.h>
+
+namespace atlas {
+
+//==============================================================================
+// T A S K   O P T I O N S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::TaskOptions::TaskOptions(Priority priority,
+                                                  Clock::time_point deadline,
+                                                  Expiry expiry) ATLAS_NOEXCEPT
+    : priority(priority),
+      deadline(deadline),
+      expiry(expiry) {}
+
+//==============================================================================
+// T A S K   L I S T   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::TaskList::PushBack(TaskNode *node)
+    ATLAS_NOEXCEPT {
+  node->next = nullptr;
+  if (tail != nullptr) {
+    tail->next = node;
+  } else {
+    head = node;
+  }
+  tail = node;
+  ++size;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::TaskList::PushFront(TaskNode *node)
+    ATLAS_NOEXCEPT {
+  node->next = head;
+  head = node;
+  if (tail == nullptr) {
+    tail = node;
+  }
+  ++size;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::TaskNode *ThreadPool::TaskList::PopFront()
+    ATLAS_NOEXCEPT {
+  TaskNode *node = head;
+  if (node != nullptr) {
+    head = node->next;
+    if (head == nullptr) {
+      tail = nullptr;
+    }
+    --size;
+  }
+  return node;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::TaskList::IsEmpty() const ATLAS_NOEXCEPT {
+  return head == nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::TaskList::Splice(TaskList &list)
+    ATLAS_NOEXCEPT {
+  if (list.IsEmpty()) {
+    return;
+  }
+  if (tail != nullptr) {
+    tail->next = list.head;
+  } else {
+    head = list.head;
+  }
+  tail = list.tail;
+  size += list.size;
+  list.head = nullptr;
+  list.tail = nullptr;
+  list.size = 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::TaskList::DeleteAll() ATLAS_NOEXCEPT {
+  while (!IsEmpty()) {
+    delete PopFront();
+  }
+}
+
+//==============================================================================
+// C / D T O R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::ThreadPool(size_t threads, Scheduling scheduling)
+    : ThreadPool(std::vector<ThreadAttributes>(threads), scheduling) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::ThreadPool(
+    const std::vector<ThreadAttributes> &workers, Scheduling scheduling)
+    : scheduling_(scheduling),
+      workers_(),
+      is_running_(),
+      is_elastic_(false),
+      min_threads_(workers.size()),
+      max_threads_(workers.size()),
+      idle_timeout_(0),
+      spin_count_(0),
+      attributes_(),
+      live_(0),
+      idle_(0),
+      tasks_(),
+      free_nodes_(),
+      queues_(),
+      queue_mutex_(),
+      condition_(),
+      is_stoped_(false),
+      pending_(0),
+      sleepers_(0),
+      steals_(0),
+      stats_enabled_(false) {
+  for (size_t i = 0; i < kPriorityCount; ++i) {
+    shared_sizes_[i].store(0, std::memory_order_relaxed);
+    counters_[i].executed.store(0, std::memory_order_relaxed);
+    counters_[i].expired.store(0, std::memory_order_relaxed);
+    counters_[i].dropped.store(0, std::memory_order_relaxed);
+  }
+  StartWorkers(workers, workers.size());
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::ThreadPool(const Sizing &sizing,
+                                    Scheduling scheduling)
+    : scheduling_(scheduling),
+      workers_(),
+      is_running_(),
+      is_elastic_(true),
+      min_threads_(sizing.min_threads),
+      max_threads_(sizing.max_threads),
+      idle_timeout_(sizing.idle_timeout),
+      spin_count_(sizing.spin_count),
+      attributes_(sizing.attributes),
+      live_(0),
+      idle_(0),
+      tasks_(),
+      free_nodes_(),
+      queues_(),
+      queue_mutex_(),
+      condition_(),
+      is_stoped_(false),
+      pending_(0),
+      sleepers_(0),
+      steals_(0),
+      stats_enabled_(false) {
+  if (max_threads_ == 0 || max_threads_ < min_threads_) {
+    throw std::invalid_argument("invalid ThreadPool sizing");
+  }
+  for (size_t i = 0; i < kPriorityCount; ++i) {
+    shared_sizes_[i].store(0, std::memory_order_relaxed);
+    counters_[i].executed.store(0, std::memory_order_relaxed);
+    counters_[i].expired.store(0, std::memory_order_relaxed);
+    counters_[i].dropped.store(0, std::memory_order_relaxed);
+  }
+  StartWorkers(std::vector<ThreadAttributes>(min_threads_, attributes_),
+               max_threads_);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::~ThreadPool() ATLAS_NOEXCEPT {
+  StopWorkers();
+  for (auto &tasks : tasks_) {
+    tasks.DeleteAll();
+  }
+  free_nodes_.DeleteAll();
+  for (auto &queue : queues_) {
+    queue->free_nodes.DeleteAll();
+    queue->shared_nodes.DeleteAll();
+  }
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_, class... Args_, class>
+auto ThreadPool::Enqueue(Tp_ &&f, Args_ &&... args)
+    -> std::future<typename std::result_of<Tp_(Args_...)>::type> {
+  return Enqueue(TaskOptions(), std::forward<Tp_>(f),
+                 std::forward<Args_>(args)...);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_, class... Args_>
+auto ThreadPool::Enqueue(const TaskOptions &options, Tp_ &&f,
+                         Args_ &&... args)
+    -> std::future<typename std::result_of<Tp_(Args_...)>::type> {
+  using return_type = typename std::result_of<Tp_(Args_...)>::type;
+
+  // The promise rebinds the allocator to its shared state and its result.
+  std::promise<return_type> promise(std::allocator_arg,
+                                    details::PoolAllocator<char>());
+  std::future<return_type> res = promise.get_future();
+  Submit(Task(details::MakePromisedCall(
+             std::move(promise), std::bind(std::forward<Tp_>(f),
+                                           std::forward<Args_>(args)...))),
+         options);
+  return res;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_, class... Args_, class>
+void ThreadPool::Post(Tp_ &&f, Args_ &&... args) {
+  Submit(Task(std::bind(std::forward<Tp_>(f), std::forward<Args_>(args)...)),
+         TaskOptions());
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_, class... Args_>
+void ThreadPool::Post(const TaskOptions &options, Tp_ &&f, Args_ &&... args) {
+  Submit(Task(std::bind(std::forward<Tp_>(f), std::forward<Args_>(args)...)),
+         options);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_, class Fn_>
+void ThreadPool::ParallelFor(Index_ begin, Index_ end,
+                             typename std::common_type<Index_>::type grain,
+                             Fn_ &&fn, Partition partition) {
+  using function_type = typename std::remove_reference<Fn_>::type;
+  if (end <= begin) {
+    return;
+  }
+  RunParallelLoop<Index_>(
+      begin, end, grain, partition,
+      &details::ParallelForParticipant<Index_, function_type>,
+      const_cast<void *>(static_cast<const void *>(&fn)));
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_, class Tp_, class Map_, class Combine_>
+Tp_ ThreadPool::ParallelReduce(Index_ begin, Index_ end,
+                               typename std::common_type<Index_>::type grain,
+                               Tp_ identity, Map_ &&map, Combine_ &&combine,
+                               Partition partition) {
+  using map_type = typename std::remove_reference<Map_>::type;
+  using combine_type = typename std::remove_reference<Combine_>::type;
+  if (end <= begin) {
+    return identity;
+  }
+  details::ReduceContext<Tp_, map_type, combine_type> context{
+      identity, map, combine, identity, {}};
+  RunParallelLoop<Index_>(
+      begin, end, grain, partition,
+      &details::ParallelReduceParticipant<Index_, Tp_, map_type,
+                                          combine_type>,
+      &context);
+  return context.result;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t ThreadPool::GetThreadCount() const ATLAS_NOEXCEPT {
+  return live_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t ThreadPool::GetIdleCount() const ATLAS_NOEXCEPT {
+  return idle_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t ThreadPool::GetActiveCount() const ATLAS_NOEXCEPT {
+  // The counters are read separately, so they may be briefly inconsistent.
+  size_t live = GetThreadCount();
+  size_t idle = GetIdleCount();
+  return live > idle ? live - idle : 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t ThreadPool::GetQueuedCount() const ATLAS_NOEXCEPT {
+  if (scheduling_ == Scheduling::kWorkStealing) {
+    return pending_.load(std::memory_order_relaxed);
+  }
+  size_t queued = 0;
+  for (const auto &size : shared_sizes_) {
+    queued += size.load(std::memory_order_relaxed);
+  }
+  return queued;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::IsElastic() const ATLAS_NOEXCEPT {
+  return is_elastic_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadAttributes
+ThreadPool::GetWorkerAttributes(size_t index) const {
+  // GrowIfNeeded replaces the workers with the queue_mutex_ held.
+  auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+  return workers_.at(index).GetAttributes();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE pthread_t ThreadPool::GetWorkerHandle(size_t index) const {
+  auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+  return workers_.at(index).GetNativeHandle();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::Scheduling ThreadPool::GetScheduling() const
+    ATLAS_NOEXCEPT {
+  return scheduling_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t ThreadPool::GetStealCount() const ATLAS_NOEXCEPT {
+  return steals_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::EnableStats(bool enable) ATLAS_NOEXCEPT {
+  stats_enabled_.store(enable, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::IsStatsEnabled() const ATLAS_NOEXCEPT {
+  return stats_enabled_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::PriorityStats ThreadPool::GetPriorityStats(
+    Priority priority) const {
+  const PriorityCounters &counters =
+      counters_[static_cast<size_t>(priority)];
+  PriorityStats stats;
+  stats.executed = counters.executed.load(std::memory_order_relaxed);
+  stats.expired = counters.expired.load(std::memory_order_relaxed);
+  stats.dropped = counters.dropped.load(std::memory_order_relaxed);
+  stats.wait = counters.wait.Snapshot();
+  return stats;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::ResetStats() ATLAS_NOEXCEPT {
+  for (auto &counters : counters_) {
+    counters.executed.store(0, std::memory_order_relaxed);
+    counters.expired.store(0, std::memory_order_relaxed);
+    counters.dropped.store(0, std::memory_order_relaxed);
+    counters.wait.Reset();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::IsLate() ATLAS_NOEXCEPT {
+  return CurrentTaskIsLate();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::StartWorkers(
+    const std::vector<ThreadAttributes> &workers, size_t slots) {
+  if (scheduling_ == Scheduling::kWorkStealing) {
+    // The deques must all exist before a worker tries to steal from them.
+    for (size_t i = 0; i < slots; ++i) {
+      queues_.emplace_back(new WorkerQueue());
+    }
+  }
+  workers_.resize(slots);
+  is_running_.resize(slots, false);
+  try {
+    for (size_t i = 0; i < workers.size(); ++i) {
+      auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+      is_running_[i] = true;
+      live_.fetch_add(1);
+      idle_.fetch_add(1);
+      workers_[i] = CreateWorker(i, workers[i]);
+    }
+  } catch (...) {
+    StopWorkers();
+    throw;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Thread ThreadPool::CreateWorker(
+    size_t index, const ThreadAttributes &attributes) {
+  if (scheduling_ == Scheduling::kWorkStealing) {
+    return Thread(attributes, [this, index] { RunWorkStealing(index); });
+  }
+  return Thread(attributes, [this, index] { RunSharedQueue(index); });
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::NeedsWorker() const ATLAS_NOEXCEPT {
+  return is_elastic_ && live_.load(std::memory_order_relaxed) < max_threads_ &&
+         idle_.load(std::memory_order_relaxed) < GetQueuedCount();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::GrowIfNeeded() ATLAS_NOEXCEPT {
+  while (NeedsWorker() && !is_stoped_) {
+    size_t index = 0;
+    while (is_running_[index]) {
+      ++index;
+    }
+    // The worker counts as idle until it takes a task, so the next
+    // submissions do not create more workers than needed.
+    is_running_[index] = true;
+    live_.fetch_add(1);
+    idle_.fetch_add(1);
+    try {
+      if (workers_[index].IsJoinable()) {
+        // A worker that exited after its idle timeout.
+        workers_[index].Join();
+      }
+      workers_[index] = CreateWorker(index, attributes_);
+    } catch (const std::system_error &) {
+      // The pool keeps running with the workers it has.
+      is_running_[index] = false;
+      live_.fetch_sub(1);
+      idle_.fetch_sub(1);
+      return;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::SetIdle(bool &is_idle, bool idle)
+    ATLAS_NOEXCEPT {
+  if (is_idle == idle) {
+    return;
+  }
+  is_idle = idle;
+  if (idle) {
+    idle_.fetch_add(1);
+  } else {
+    idle_.fetch_sub(1);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Predicate_>
+bool ThreadPool::Spin(Predicate_ ready) const {
+  for (size_t i = 0; i < spin_count_; ++i) {
+    if (ready()) {
+      return true;
+    }
+    details::CpuRelax();
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Predicate_>
+bool ThreadPool::Park(std::unique_lock<std::mutex> &lock, size_t index,
+                      Predicate_ ready) {
+  if (!is_elastic_) {
+    condition_.wait(lock, ready);
+    return true;
+  }
+  while (!condition_.wait_for(lock, idle_timeout_, ready)) {
+    if (live_.load() > min_threads_) {
+      // The thread is joined when its slot is reused or by the destructor.
+      is_running_[index] = false;
+      live_.fetch_sub(1);
+      idle_.fetch_sub(1);
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::StopWorkers() ATLAS_NOEXCEPT {
+  {
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+    is_stoped_ = true;
+  }
+  condition_.notify_all();
+  for (Thread &worker : workers_) {
+    if (worker.IsJoinable()) {
+      worker.Join();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::Submit(Task &&task,
+                                     const TaskOptions &options) {
+  if (scheduling_ == Scheduling::kSharedQueue) {
+    {
+      auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+
+      if (is_stoped_) {
+        throw std::runtime_error("enqueue on stopped ThreadPool");
+      }
+
+      PushShared(AcquireNode(free_nodes_, std::move(task), options));
+      GrowIfNeeded();
+    }
+
+    condition_.notify_one();
+    return;
+  }
+
+  if (is_stoped_) {
+    throw std::runtime_error("enqueue on stopped ThreadPool");
+  }
+
+  // The task is counted before being published, so a worker that sees no
+  // pending task cannot miss it when going to sleep.
+  // Only the normal tasks go in the deques, the others must be seen by all
+  // the workers in order.
+  WorkerSlot &worker = CurrentWorker();
+  if (worker.pool == this && options.priority == Priority::kNormal) {
+    WorkerQueue &queue = *queues_[worker.index];
+    TaskNode *node = AcquireNode(queue.free_nodes, std::move(task), options);
+    pending_.fetch_add(1);
+    queue.deque.Push(node);
+    if (sleepers_.load() == 0 && !NeedsWorker()) {
+      return;
+    }
+    // Taking the mutex makes sure the sleeper is either waiting on the
+    // condition or has not checked the pending count yet.
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+    GrowIfNeeded();
+  } else {
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+    PushShared(AcquireNode(free_nodes_, std::move(task), options));
+    pending_.fetch_add(1);
+    GrowIfNeeded();
+  }
+  if (sleepers_.load() > 0) {
+    condition_.notify_one();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Fn_>
+void ThreadPool::SubmitBatch(size_t count, const Fn_ &fn) {
+  if (scheduling_ == Scheduling::kSharedQueue) {
+    {
+      auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+
+      if (is_stoped_) {
+        throw std::runtime_error("enqueue on stopped ThreadPool");
+      }
+
+      for (size_t i = 0; i < count; ++i) {
+        PushShared(AcquireNode(free_nodes_, Task(fn)));
+      }
+      GrowIfNeeded();
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      condition_.notify_one();
+    }
+    return;
+  }
+
+  if (is_stoped_) {
+    throw std::runtime_error("enqueue on stopped ThreadPool");
+  }
+
+  WorkerSlot &worker = CurrentWorker();
+  if (worker.pool == this) {
+    WorkerQueue &queue = *queues_[worker.index];
+    pending_.fetch_add(count);
+    for (size_t i = 0; i < count; ++i) {
+      queue.deque.Push(AcquireNode(queue.free_nodes, Task(fn)));
+    }
+    if (sleepers_.load() == 0 && !NeedsWorker()) {
+      return;
+    }
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+    GrowIfNeeded();
+  } else {
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+    for (size_t i = 0; i < count; ++i) {
+      PushShared(AcquireNode(free_nodes_, Task(fn)));
+    }
+    pending_.fetch_add(count);
+    GrowIfNeeded();
+  }
+  if (sleepers_.load() == 0) {
+    return;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    condition_.notify_one();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_>
+void ThreadPool::RunParallelLoop(
+    Index_ begin, Index_ end, Index_ grain, Partition partition,
+    typename details::ParallelLoop<Index_>::Participant participant,
+    void *context) {
+  if (grain < 1) {
+    grain = 1;
+  }
+  Index_ count = end - begin;
+  size_t chunks = static_cast<size_t>((count - 1) / grain) + 1;
+  // An elastic pool creates the workers the helpers need.
+  size_t threads = is_elastic_ ? max_threads_ : GetThreadCount();
+  size_t helpers = std::min(threads, chunks - 1);
+  size_t participants = helpers + 1;
+
+  Index_ chunk = grain;
+  if (partition == Partition::kStatic) {
+    Index_ share = static_cast<Index_>(
+        (static_cast<size_t>(count) + participants - 1) / participants);
+    chunk = std::max(grain, share);
+  }
+
+  auto loop = details::ParallelLoop<Index_>::Create(
+      begin, end, chunk, partition == Partition::kGuided, participants,
+      participant, context);
+  if (helpers > 0) {
+    try {
+      SubmitBatch(helpers, [loop] {
+        loop->Participate();
+        loop->Release();
+      });
+    } catch (const std::runtime_error &) {
+      // The pool is stopping, the calling thread executes the whole loop.
+      loop->Release(helpers);
+    }
+  }
+
+  loop->Participate();
+  loop->Wait();
+  std::exception_ptr error = loop->GetError();
+  loop->Release();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::TaskNode *ThreadPool::AcquireNode(
+    TaskList &free_nodes, Task &&task, const TaskOptions &options) {
+  TaskNode *node = free_nodes.PopFront();
+  if (node == nullptr) {
+    node = new TaskNode();
+  }
+  node->task = std::move(task);
+  node->is_shared = &free_nodes == &free_nodes_;
+  node->priority = options.priority;
+  node->expiry = options.expiry;
+  node->deadline_ns = kNoDeadline;
+  if (options.deadline != Clock::time_point::max()) {
+    node->deadline_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            options.deadline.time_since_epoch()).count();
+  }
+  node->submit_ns =
+      stats_enabled_.load(std::memory_order_relaxed) ? NanoTimer::Now() : 0;
+  return node;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::RunNode(TaskNode *node) {
+  PriorityCounters &counters = counters_[static_cast<size_t>(node->priority)];
+  bool late = false;
+  if (node->deadline_ns != kNoDeadline || node->submit_ns != 0) {
+    int64_t now = NanoTimer::Now();
+    if (node->deadline_ns != kNoDeadline && now > node->deadline_ns) {
+      late = true;
+      counters.expired.fetch_add(1, std::memory_order_relaxed);
+      if (node->expiry == Expiry::kDrop) {
+        // Destroying the task breaks the promise of an Enqueue-d task.
+        counters.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+    if (node->submit_ns != 0) {
+      counters.executed.fetch_add(1, std::memory_order_relaxed);
+      counters.wait.Record(
+          now > node->submit_ns ? static_cast<uint64_t>(now - node->submit_ns)
+                                : 0);
+    }
+  }
+
+  bool &is_late = CurrentTaskIsLate();
+  bool was_late = is_late;
+  is_late = late;
+  node->task();
+  is_late = was_late;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::TaskNode *ThreadPool::PopShared() ATLAS_NOEXCEPT {
+  for (size_t i = 0; i < kPriorityCount; ++i) {
+    if (!tasks_[i].IsEmpty()) {
+      shared_sizes_[i].fetch_sub(1, std::memory_order_relaxed);
+      return tasks_[i].PopFront();
+    }
+  }
+  return nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::PushShared(TaskNode *node) ATLAS_NOEXCEPT {
+  size_t priority = static_cast<size_t>(node->priority);
+  tasks_[priority].PushBack(node);
+  shared_sizes_[priority].fetch_add(1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::ReleaseNode(size_t index, TaskNode *node) {
+  node->task = Task();
+  WorkerQueue &queue = *queues_[index];
+  if (node->is_shared) {
+    // Giving the node back right away would cost a lock per task, the
+    // worker does it when it next takes tasks from the shared queue.
+    queue.shared_nodes.PushFront(node);
+    if (queue.shared_nodes.size > kMaxFreeNodes) {
+      auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+      ReturnSharedNodes(index);
+    }
+    return;
+  }
+
+  queue.free_nodes.PushFront(node);
+  if (queue.free_nodes.size > kMaxFreeNodes) {
+    // Give half of the nodes to the tasks enqueued from outside.
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+    while (queue.free_nodes.size > kMaxFreeNodes / 2) {
+      free_nodes_.PushFront(queue.free_nodes.PopFront());
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::ReturnSharedNodes(size_t index) ATLAS_NOEXCEPT {
+  free_nodes_.Splice(queues_[index]->shared_nodes);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::RunSharedQueue(size_t index) {
+  TaskNode *done = nullptr;
+  bool is_idle = true;
+  for (;;) {
+    TaskNode *node = nullptr;
+
+    {
+      auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+      if (done != nullptr) {
+        free_nodes_.PushFront(done);
+        done = nullptr;
+      }
+      node = PopShared();
+      if (node == nullptr) {
+        SetIdle(is_idle, true);
+        if (spin_count_ > 0 && !is_stoped_) {
+          lock.unlock();
+          Spin([this] { return is_stoped_ || GetQueuedCount() > 0; });
+          lock.lock();
+          node = PopShared();
+        }
+      }
+      if (node == nullptr) {
+        bool is_running = Park(lock, index, [this, &node] {
+          node = PopShared();
+          return is_stoped_ || node != nullptr;
+        });
+        if (!is_running || node == nullptr) {
+          return;
+        }
+      }
+    }
+
+    SetIdle(is_idle, false);
+    RunNode(node);
+    // Destroy the callable out of the lock, the node is recycled with the
+    // next lock.
+    node->task = Task();
+    done = node;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::RunWorkStealing(size_t index) {
+  CurrentWorker() = WorkerSlot{this, index};
+  uint32_t seed = static_cast<uint32_t>(index) * 2654435761u + 1;
+  bool is_idle = true;
+
+  for (;;) {
+    TaskNode *node = FindTask(index, seed);
+    if (node != nullptr) {
+      SetIdle(is_idle, false);
+      pending_.fetch_sub(1);
+      RunNode(node);
+      ReleaseNode(index, node);
+      continue;
+    }
+
+    SetIdle(is_idle, true);
+    auto has_work = [this] { return is_stoped_ || pending_.load() > 0; };
+    if (spin_count_ > 0 && !is_stoped_ && Spin(has_work) && !is_stoped_) {
+      continue;
+    }
+
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+    ReturnSharedNodes(index);
+    sleepers_.fetch_add(1);
+    bool is_running = Park(lock, index, has_work);
+    sleepers_.fetch_sub(1);
+    if (!is_running || (is_stoped_ && pending_.load() == 0)) {
+      break;
+    }
+  }
+
+  CurrentWorker() = WorkerSlot{nullptr, 0};
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::TaskNode *ThreadPool::FindTask(size_t index,
+                                                        uint32_t &seed) {
+  TaskNode *node = nullptr;
+  if (shared_sizes_[static_cast<size_t>(Priority::kRealtime)].load(
+          std::memory_order_relaxed) > 0) {
+    node = TakeShared(index, Priority::kRealtime);
+    if (node != nullptr) {
+      return node;
+    }
+  }
+
+  node = queues_[index]->deque.Take();
+  if (node != nullptr) {
+    return node;
+  }
+
+  // Start from a random victim so the thieves spread over the workers.
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  size_t count = queues_.size();
+  size_t first = seed % count;
+  for (size_t i = 0; i < count; ++i) {
+    size_t victim = (first + i) % count;
+    if (victim == index) {
+      continue;
+    }
+    node = queues_[victim]->deque.Steal();
+    if (node != nullptr) {
+      steals_.fetch_add(1, std::memory_order_relaxed);
+      return node;
+    }
+  }
+
+  node = TakeShared(index, Priority::kNormal);
+  if (node != nullptr) {
+    return node;
+  }
+  return TakeShared(index, Priority::kBackground);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::TaskNode *ThreadPool::TakeShared(
+    size_t index, Priority priority) {
+  auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+  ReturnSharedNodes(index);
+  TaskList &tasks = tasks_[static_cast<size_t>(priority)];
+  if (tasks.IsEmpty()) {
+    return nullptr;
+  }
+
+  // Take a fair share of the normal queue so the other workers can steal it
+  // without contending on the mutex. The other classes are taken one at a
+  // time to keep their order.
+  size_t batch = 1;
+  if (priority == Priority::kNormal) {
+    size_t count = queues_.size();
+    batch = std::min<size_t>((tasks.size + count - 1) / count, 32);
+  }
+  shared_sizes_[static_cast<size_t>(priority)].fetch_sub(
+      batch, std::memory_order_relaxed);
+  TaskNode *node = tasks.PopFront();
+  for (size_t i = 1; i < batch; ++i) {
+    queues_[index]->deque.Push(tasks.PopFront());
+  }
+  return node;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::WorkerSlot &ThreadPool::CurrentWorker()
+    ATLAS_NOEXCEPT {
+  static thread_local WorkerSlot worker = {nullptr, 0};
+  return worker;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool &ThreadPool::CurrentTaskIsLate() ATLAS_NOEXCEPT {
+  static thread_local bool is_late = false;
+  return is_late;
+}
+
+}  // namespace atlas
@@ -0,0 +1,140 @@
+/**
+ * \file	triple_buffer.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_TRIPLE_BUFFER_H_
+#define LIB_ATLAS_PATTERN_TRIPLE_BUFFER_H_
+
+#include <stdint.h>
+#include <atomic>
+
+#include <lib_atlas/macros.h>
+
+namespace atlas {
+
+/**
+ * A wait-free channel of the latest value from one writer to one reader.
+ *
+ * The writer fills the write buffer and publishes it, the reader fetches
+ * the last published buffer and reads it in place. Each side owns one of the
+ * three buffers and the third one holds the last published value, so
+ * publishing and fetching only exchange an index and never wait for the
+ * other side. The values that the reader did not fetch are overwritten.
+ *
+ * Sample usage:
+ *
+ * // Writer thread
+ * buffer.GetWriteBuffer() = ComputePose();
+ * buffer.Publish();
+ *
+ * // Reader thread
+ * if (buffer.Update()) {
+ *   Use(buffer.GetReadBuffer());
+ * }
+ *
+ * \template Tp_ The type of the values.
+ */
+template <class Tp_>
+class TripleBuffer {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  TripleBuffer();
+
+  /**
+   * Initialize the three buffers with a copy of value.
+   */
+  explicit TripleBuffer(const Tp_ &value);
+
+  TripleBuffer(const TripleBuffer &) = delete;
+
+  TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * \return The buffer the writer is filling. It holds a stale value, which
+   *         may not be the last published one.
+   */
+  Tp_ &GetWriteBuffer() ATLAS_NOEXCEPT;
+
+  /**
+   * Make the write buffer the latest value and take a new write buffer.
+   * Only called by the writer.
+   */
+  void Publish() ATLAS_NOEXCEPT;
+
+  /**
+   * Move value into the write buffer and publish it.
+   */
+  void Write(Tp_ value);
+
+  /**
+   * Fetch the latest published value if the reader does not have it yet.
+   * Only called by the reader.
+   *
+   * \return True if a new value was fetched.
+   */
+  bool Update() ATLAS_NOEXCEPT;
+
+  /**
+   * \return The value fetched by the last Update. It is not modified by the
+   *         writer until the reader calls Update again.
+   */
+  const Tp_ &GetReadBuffer() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return True if a value was published since the last Update. Can be
+   *         called from any thread.
+   */
+  bool HasUpdate() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  static const uint8_t kIndexMask = 0x3;
+
+  /** Set when the latest value was not fetched by the reader yet. */
+  static const uint8_t kDirtyBit = 0x4;
+
+  Tp_ buffers_[3];
+
+  /** The index of the buffer holding the latest value, and kDirtyBit. */
+  std::atomic<uint8_t> latest_;
+
+  /** Only accessed by the writer. */
+  uint8_t write_index_;
+
+  /** Only accessed by the reader. */
+  uint8_t read_index_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/triple_buffer_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_TRIPLE_BUFFER_H_
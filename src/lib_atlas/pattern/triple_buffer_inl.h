@@ -0,0 +1,111 @@
+/**
+ * \file	triple_buffer_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_TRIPLE_BUFFER_H_
+#error This file may only be included from triple_buffer.h
+#endif
+
+#include <utility>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE TripleBuffer<Tp_>::TripleBuffer()
+    : buffers_(), latest_(1), write_index_(0), read_index_(2) {}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE TripleBuffer<Tp_>::TripleBuffer(const Tp_ &value)
+    : buffers_{value, value, value},
+      latest_(1),
+      write_index_(0),
+      read_index_(2) {}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE Tp_ &TripleBuffer<Tp_>::GetWriteBuffer() ATLAS_NOEXCEPT {
+  return buffers_[write_index_];
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void TripleBuffer<Tp_>::Publish() ATLAS_NOEXCEPT {
+  // The release orders the writes to the buffer before the reader fetches
+  // it, the acquire orders the previous reads of the buffer we get back.
+  uint8_t previous = latest_.exchange(
+      static_cast<uint8_t>(write_index_ | kDirtyBit),
+      std::memory_order_acq_rel);
+  write_index_ = previous & kIndexMask;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void TripleBuffer<Tp_>::Write(Tp_ value) {
+  GetWriteBuffer() = std::move(value);
+  Publish();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool TripleBuffer<Tp_>::Update() ATLAS_NOEXCEPT {
+  if (!HasUpdate()) {
+    return false;
+  }
+  // Only the reader clears the dirty bit, so the exchange always fetches a
+  // new value.
+  uint8_t latest = latest_.exchange(read_index_, std::memory_order_acq_rel);
+  read_index_ = latest & kIndexMask;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE const Tp_ &TripleBuffer<Tp_>::GetReadBuffer() const
+    ATLAS_NOEXCEPT {
+  return buffers_[read_index_];
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE bool TripleBuffer<Tp_>::HasUpdate() const ATLAS_NOEXCEPT {
+  return (latest_.load(std::memory_order_relaxed) & kDirtyBit) != 0;
+}
+
+}  // namespace atlas
@@ -0,0 +1,74 @@
+/**
+ * \file	image_message.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_ROS_IMAGE_MESSAGE_H_
+#define LIB_ATLAS_ROS_IMAGE_MESSAGE_H_
+
+#include <cv_bridge/cv_bridge.h>
+#include <opencv2/opencv.hpp>
+#include <sensor_msgs/Image.h>
+#include <string>
+
+#include <lib_atlas/macros.h>
+
+namespace atlas {
+
+/**
+ * Fill a message with the pixels of an image.
+ *
+ * Unlike cv_bridge::CvImage::toImageMsg, this does not allocate a new
+ * message: the data of the message is reused when the size of the images
+ * does not change, so filling a recycled message only copies the pixels.
+ * The header of the message is left untouched.
+ *
+ * \param image An 8 bits image with 1, 3 or 4 channels in gray, BGR or BGRA
+ *        order, or a 16 bits gray image.
+ * \throw std::invalid_argument If the type of the image is not supported.
+ */
+void FillImageMessage(const cv::Mat &image, sensor_msgs::Image &message);
+
+/**
+ * Convert a received image to bgr8 into a recycled buffer.
+ *
+ * The message is wrapped without a copy with toCvShare, then the common
+ * encodings are converted directly into bgr, whose buffer is reused when the
+ * size of the images does not change. Other encodings fall back to a
+ * conversion by cv_bridge.
+ *
+ * \throw cv_bridge::Exception If the encoding cannot be converted to bgr8.
+ */
+void ConvertImageMessage(const sensor_msgs::ImageConstPtr &message,
+                         cv::Mat &bgr);
+
+/**
+ * \return True if the image can be used as bgr8 without a conversion.
+ */
+bool IsBgr8(const sensor_msgs::Image &message) ATLAS_NOEXCEPT;
+
+}  // namespace atlas
+
+#include <lib_atlas/ros/image_message_inl.h>
+
+#endif  // LIB_ATLAS_ROS_IMAGE_MESSAGE_H_
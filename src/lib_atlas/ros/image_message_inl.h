@@ -0,0 +1,113 @@
+/**
+ * \file	image_message_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_ROS_IMAGE_MESSAGE_H_
+#error This file may only be included from image_message.h
+#endif
+
+#include <sensor_msgs/image_encodings.h>
+#include <cstring>
+#include <stdexcept>
+
+namespace atlas {
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FillImageMessage(const cv::Mat &image,
+                                   sensor_msgs::Image &message) {
+  namespace enc = sensor_msgs::image_encodings;
+  switch (image.type()) {
+    case CV_8UC1:
+      message.encoding = enc::MONO8;
+      break;
+    case CV_8UC3:
+      message.encoding = enc::BGR8;
+      break;
+    case CV_8UC4:
+      message.encoding = enc::BGRA8;
+      break;
+    case CV_16UC1:
+      message.encoding = enc::MONO16;
+      break;
+    default:
+      throw std::invalid_argument("The type of the image is not supported.");
+  }
+
+  size_t row_size = image.cols * image.elemSize();
+  message.height = static_cast<uint32_t>(image.rows);
+  message.width = static_cast<uint32_t>(image.cols);
+  message.step = static_cast<uint32_t>(row_size);
+  message.is_bigendian = 0;
+  // resize does not reallocate when the size of the images does not change.
+  message.data.resize(row_size * image.rows);
+  if (image.isContinuous()) {
+    std::memcpy(message.data.data(), image.data, message.data.size());
+    return;
+  }
+  for (int row = 0; row < image.rows; ++row) {
+    std::memcpy(&message.data[row * row_size], image.ptr(row), row_size);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ConvertImageMessage(
+    const sensor_msgs::ImageConstPtr &message, cv::Mat &bgr) {
+  namespace enc = sensor_msgs::image_encodings;
+  const std::string &encoding = message->encoding;
+  int code = -1;
+  if (encoding == enc::RGB8) {
+    code = cv::COLOR_RGB2BGR;
+  } else if (encoding == enc::MONO8) {
+    code = cv::COLOR_GRAY2BGR;
+  } else if (encoding == enc::BGRA8) {
+    code = cv::COLOR_BGRA2BGR;
+  } else if (encoding == enc::RGBA8) {
+    code = cv::COLOR_RGBA2BGR;
+  } else if (encoding != enc::BGR8) {
+    // Scaled or bayer encodings, cv_bridge allocates the converted image.
+    cv_bridge::toCvShare(message, enc::BGR8)->image.copyTo(bgr);
+    return;
+  }
+
+  // Without a target encoding, toCvShare only wraps the data.
+  cv_bridge::CvImageConstPtr shared = cv_bridge::toCvShare(message);
+  if (code < 0) {
+    shared->image.copyTo(bgr);
+  } else {
+    cv::cvtColor(shared->image, bgr, code);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool IsBgr8(const sensor_msgs::Image &message) ATLAS_NOEXCEPT {
+  return message.encoding == sensor_msgs::image_encodings::BGR8;
+}
+
+}  // namespace atlas
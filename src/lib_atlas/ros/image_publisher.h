@@ -28,16 +28,27 @@
 
 #include <cv_bridge/cv_bridge.h>
 #include <image_transport/image_transport.h>
+#include <lib_atlas/io/image_channel.h>
 #include <lib_atlas/io/image_sequence_writer.h>
 #include <lib_atlas/macros.h>
+#include <lib_atlas/ros/image_message.h>
 #include <ros/ros.h>
 #include <memory>
 #include <mutex>
 #include <opencv2/opencv.hpp>
 #include <string>
+#include <vector>
 
 namespace atlas {
 
+/**
+ * Publish images on a ROS topic.
+ *
+ * The ImageSubscriber of the same process receive the images through the
+ * intra-process ImageChannel of the topic, by pointer and without
+ * serialization. The images are only converted to messages and published
+ * with image_transport when the topic has other subscribers.
+ */
 class ImagePublisher : public ImageSequenceWriter {
  public:
   //==========================================================================
@@ -45,6 +56,18 @@ class ImagePublisher : public ImageSequenceWriter {
 
   using Ptr = std::shared_ptr<ImagePublisher>;
 
+  /**
+   * The number of recycled messages. A message is only reused once the
+   * transport and the intra-process subscribers released it, otherwise a
+   * new one replaces it.
+   */
+  static const size_t kMessageCount = 3;
+
+  /**
+   * The ROS transport, used for the subscribers outside of the process.
+   */
+  class RosTransport;
+
   //============================================================================
   // C O N S T R U C T O R S   A N D   D E S T R U C T O R
 
@@ -52,6 +75,24 @@ class ImagePublisher : public ImageSequenceWriter {
 
   ~ImagePublisher() ATLAS_NOEXCEPT;
 
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Publish an image without copying it for the subscribers of the process.
+   *
+   * \param image Shared with the subscribers, it must not be modified once
+   *        published.
+   * \throw std::invalid_argument If the type of the image is not supported
+   *        and the image has to be converted to a message.
+   */
+  void Publish(std::shared_ptr<const cv::Mat> image);
+
+  /**
+   * \return The number of images published in process and through ROS.
+   */
+  ImageChannelStats GetChannelStats() const ATLAS_NOEXCEPT;
+
  private:
   //============================================================================
   // P R I V A T E   M E T H O D S
@@ -69,6 +110,10 @@ class ImagePublisher : public ImageSequenceWriter {
    * For exemple, you could attach this ImageSequenceWriter to a class that
    * stream the content of a video file in order to publish it to a topic:
    * Everything is going to be handled by the system.
+   *
+   * The image is copied once for the subscribers of the process, as the
+   * caller may reuse its buffer, and once into a recycled message for the
+   * other subscribers.
    */
   void WriteImage(const cv::Mat &image) ATLAS_NOEXCEPT override;
 
@@ -80,6 +125,38 @@ class ImagePublisher : public ImageSequenceWriter {
   image_transport::ImageTransport img_transport_;
 
   image_transport::Publisher publisher_;
+
+  std::unique_ptr<RosTransport> transport_;
+
+  ImageChannelPublisher channel_publisher_;
+};
+
+//------------------------------------------------------------------------------
+//
+class ImagePublisher::RosTransport : public RemoteImageTransport {
+ public:
+  explicit RosTransport(image_transport::Publisher &publisher);
+
+  size_t GetSubscriberCount() const override;
+
+  /**
+   * Fill a recycled message with the image and publish it by pointer, so
+   * that the intra-process ROS subscribers do not copy it again.
+   */
+  void Publish(const ChannelImage &image) override;
+
+ private:
+  /**
+   * \return A message that is not held by the transport anymore.
+   */
+  sensor_msgs::ImagePtr AcquireMessage();
+
+  image_transport::Publisher &publisher_;
+
+  /** Only used by Publish, which is not called concurrently. */
+  std::vector<sensor_msgs::ImagePtr> messages_;
+
+  size_t next_message_;
 };
 
 }  // namespace atlas
@@ -27,8 +27,10 @@
 #error This file may only be included from image_publisher.h
 #endif
 
+#include <boost/make_shared.hpp>
 #include <algorithm>
 #include <cassert>
+#include <stdexcept>
 
 namespace atlas {
 
@@ -41,7 +43,9 @@ ATLAS_ALWAYS_INLINE ImagePublisher::ImagePublisher(
     const std::string &topic_name) ATLAS_NOEXCEPT
     : topic_name_(topic_name),
       img_transport_(ros::NodeHandle()),
-      publisher_(img_transport_.advertise(topic_name_, 1)) {}
+      publisher_(img_transport_.advertise(topic_name_, 1)),
+      transport_(new RosTransport(publisher_)),
+      channel_publisher_(ros::names::resolve(topic_name_), *transport_) {}
 
 //------------------------------------------------------------------------------
 //
@@ -52,17 +56,83 @@ ATLAS_ALWAYS_INLINE ImagePublisher::~ImagePublisher() ATLAS_NOEXCEPT {
 //==============================================================================
 // M E T H O D S   S E C T I O N
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImagePublisher::Publish(
+    std::shared_ptr<const cv::Mat> image) {
+  channel_publisher_.Publish(std::move(image),
+                             static_cast<int64_t>(ros::Time::now().toNSec()));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImageChannelStats ImagePublisher::GetChannelStats() const
+    ATLAS_NOEXCEPT {
+  return channel_publisher_.GetStats();
+}
+
 //------------------------------------------------------------------------------
 //
 ATLAS_ALWAYS_INLINE void ImagePublisher::WriteImage(const cv::Mat &image)
     ATLAS_NOEXCEPT {
-  if (!image.empty()) {
-    sensor_msgs::ImagePtr msg =
-        cv_bridge::CvImage(std_msgs::Header(), "bgr8", image).toImageMsg();
-    msg->header.stamp = ros::Time::now();
-    publisher_.publish(msg);
-    cv::waitKey(1);
+  if (image.empty()) {
+    return;
+  }
+  try {
+    if (channel_publisher_.HasIntraProcessSubscribers()) {
+      Publish(std::make_shared<const cv::Mat>(image.clone()));
+    } else {
+      // The transport copies the image into a message, no need to keep it.
+      Publish(std::make_shared<const cv::Mat>(image));
+    }
+  } catch (const std::exception &e) {
+    ROS_ERROR("Unable to publish the image on %s: %s", topic_name_.c_str(),
+              e.what());
+  }
+}
+
+//==============================================================================
+// R O S   T R A N S P O R T   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImagePublisher::RosTransport::RosTransport(
+    image_transport::Publisher &publisher)
+    : publisher_(publisher), messages_(kMessageCount), next_message_(0) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t ImagePublisher::RosTransport::GetSubscriberCount() const {
+  return publisher_.getNumSubscribers();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImagePublisher::RosTransport::Publish(
+    const ChannelImage &image) {
+  sensor_msgs::ImagePtr msg = AcquireMessage();
+  FillImageMessage(*image.image, *msg);
+  msg->header.stamp.fromNSec(static_cast<uint64_t>(image.stamp_ns));
+  publisher_.publish(msg);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE sensor_msgs::ImagePtr
+ImagePublisher::RosTransport::AcquireMessage() {
+  for (size_t i = 0; i < messages_.size(); ++i) {
+    sensor_msgs::ImagePtr &msg = messages_[next_message_];
+    next_message_ = (next_message_ + 1) % messages_.size();
+    if (msg && msg.unique()) {
+      return msg;
+    }
   }
+  // Every message is still held, or was never allocated: the new message
+  // replaces the oldest one, which is freed by its last holder.
+  sensor_msgs::ImagePtr &msg = messages_[next_message_];
+  next_message_ = (next_message_ + 1) % messages_.size();
+  msg = boost::make_shared<sensor_msgs::Image>();
+  return msg;
 }
 
 }  // namespace atlas
@@ -29,15 +29,41 @@
 #include <cv_bridge/cv_bridge.h>
 #include <image_transport/image_transport.h>
 #include <ros/ros.h>
+#include <stdint.h>
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <opencv2/opencv.hpp>
 
+#include <lib_atlas/io/image_channel.h>
 #include <lib_atlas/io/image_sequence_capture.h>
 #include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/observer.h>
+#include <lib_atlas/pattern/triple_buffer.h>
+#include <lib_atlas/ros/image_message.h>
 
 namespace atlas {
 
+/**
+ * Receive the images of a ROS topic.
+ *
+ * The ROS callback publishes every image as an immutable shared
+ * ReceivedImage, swapped atomically so any thread can read it with
+ * GetLatestImage, and in a triple buffer read by the streaming thread only.
+ * Neither the callback nor the readers ever wait for each other and no image
+ * is copied once received.
+ *
+ * A bgr8 image is shared with the message rather than copied, unless an
+ * observer of GetFrameSubject needs it in a pooled frame. The other
+ * encodings are converted directly into a pooled frame.
+ *
+ * When the topic is published by an ImagePublisher of the same process, the
+ * images come through the intra-process ImageChannel of the topic instead,
+ * shared by pointer without serialization nor conversion, and their copies
+ * received from ROS are ignored. The images of the other publishers, in the
+ * process or not, are received from ROS.
+ */
 class ImageSubscriber : public ImageSequenceCapture {
  public:
   //==========================================================================
@@ -45,37 +71,216 @@ class ImageSubscriber : public ImageSequenceCapture {
 
   using Ptr = std::shared_ptr<ImageSubscriber>;
 
+  /**
+   * A received image with its pooled buffer.
+   */
+  struct ReceivedImage {
+    using ConstPtr = std::shared_ptr<const ReceivedImage>;
+
+    /** Holds the buffer of the frame pool, empty if the image is shared. */
+    Frame frame;
+
+    /** Holds the message the image is shared with, if it is. */
+    cv_bridge::CvImageConstPtr message;
+
+    /** Holds the image shared by a publisher of the process, if it is. */
+    std::shared_ptr<const cv::Mat> shared;
+
+    /** A view of the buffer of frame, of the data of message or of shared. */
+    cv::Mat image;
+
+    /** Starts at 1 for the first received image, 0 if there is none yet. */
+    uint64_t sequence = {0};
+
+    /** The stamp of the header of the message. */
+    ros::Time stamp;
+  };
+
+  /**
+   * The triple buffer holds at most two frames since its stale write buffer
+   * is cleared, and the latest image one, leaving five buffers for the
+   * frames being converted or kept by the observers and the readers.
+   */
+  static const size_t kFramePoolSize = 8;
+
   //============================================================================
   // C O N S T R U C T O R S   A N D   D E S T R U C T O R
 
   explicit ImageSubscriber(const std::string &topic_name)
       : topic_name_(topic_name),
         img_transport_(ros::NodeHandle()),
-        subscriber_(img_transport_.subscribe(
-            topic_name_, 1, &ImageSubscriber::ImageCallback, this)),
-        image_(),
-        topic_mutex_() {}
+        subscriber_(),
+        channel_(ImageChannel::Get(ros::names::resolve(topic_name_))),
+        channel_receiver_(*this),
+        is_writing_(false),
+        sequence_(0),
+        latest_image_(std::make_shared<const ReceivedImage>()),
+        stream_images_(),
+        next_image_mutex_(),
+        next_image_() {
+    EnableFramePool(kFramePoolSize);
+    // The callbacks may be called as soon as they are registered, so they
+    // are only registered once the pool is ready.
+    channel_->Attach(channel_receiver_);
+    channel_->AddTransportSubscriber();
+    subscriber_ = img_transport_.subscribe(topic_name_, 1,
+                                           &ImageSubscriber::ImageCallback,
+                                           this);
+  }
 
-  virtual ~ImageSubscriber() = default;
+  virtual ~ImageSubscriber() {
+    channel_->Detach(channel_receiver_);
+    channel_->RemoveTransportSubscriber();
+    subscriber_.shutdown();
+    Stop();
+  }
 
   //============================================================================
   // P U B L I C   M E T H O D S
 
-  ATLAS_ALWAYS_INLINE const cv::Mat &GetImage() const { return image_; }
+  /**
+   * \return A copy of the latest received image. Can be called from any
+   *         thread.
+   */
+  cv::Mat GetImage() const { return GetLatestImage()->image.clone(); }
+
+  /**
+   * Fetch the latest received image without waiting for the callback nor
+   * copying it. Can be called from any thread.
+   *
+   * \return The latest image with its sequence number, which is the same
+   *         as the one of the previous call if no image was received since.
+   *         The image and its buffer stay valid while the pointer is held.
+   */
+  ATLAS_ALWAYS_INLINE ReceivedImage::ConstPtr GetLatestImage() const {
+    return std::atomic_load(&latest_image_);
+  }
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  /**
+   * Only called by ImageSequenceCapture::GetImage, since StreamNextImage
+   * does not use it. The image stays valid until the next call.
+   */
+  const cv::Mat &GetNextImage() const override {
+    std::lock_guard<std::mutex> lock(next_image_mutex_);
+    next_image_ = GetLatestImage();
+    return next_image_->image;
+  }
+
+  /**
+   * Notify the image received since the previous frame, so that the same
+   * image is not streamed twice. A shared image, received from ROS or from
+   * the channel, is only notified to the cv::Mat observers.
+   */
+  void StreamNextImage() ATLAS_NOEXCEPT override {
+    if (!stream_images_.Update()) {
+      return;
+    }
+    const ReceivedImage &received = stream_images_.GetReadBuffer();
+    if (received.frame) {
+      NotifyFrame(received.frame);
+    } else {
+      NotifyImage(received.image);
+    }
+  }
 
  private:
   //============================================================================
   // P R I V A T E   M E T H O D S
 
   void ImageCallback(const sensor_msgs::ImageConstPtr &msg) {
+    if (channel_->WasNotified(
+            static_cast<int64_t>(msg->header.stamp.toNSec()))) {
+      // The image of the publisher of the channel already came through it.
+      return;
+    }
+    ReceivedImage received;
+    if (IsBgr8(*msg) && GetFrameSubject().ObserverCount() == 0) {
+      // The message is kept alive by the shared image, without a copy.
+      received.message = cv_bridge::toCvShare(msg);
+      received.image = received.message->image;
+    } else {
+      Frame frame = AcquireFrame();
+      if (!frame) {
+        // Every buffer is still held by the observers, drop the image
+        // rather than allocating a new one.
+        return;
+      }
+      try {
+        ConvertImageMessage(msg, *frame);
+      } catch (cv_bridge::Exception &e) {
+        ROS_ERROR("Unable to convert %s image to bgr8",
+                  msg->encoding.c_str());
+        return;
+      }
+      received.image = *frame;
+      received.frame = std::move(frame);
+    }
+    received.stamp = msg->header.stamp;
+    Receive(std::move(received));
+  }
+
+  /**
+   * Called by the thread publishing in the intra-process channel.
+   */
+  void OnChannelImage(const ChannelImage &image) ATLAS_NOEXCEPT {
+    ReceivedImage received;
+    received.shared = image.image;
+    received.image = *image.image;
+    received.stamp.fromNSec(static_cast<uint64_t>(image.stamp_ns));
+    Receive(std::move(received));
+  }
+
+  /**
+   * Number an image and publish it for the readers and in the triple buffer.
+   *
+   * The ROS callback and the channel are each called by a single thread,
+   * and both deliver images when the topic has several publishers. The
+   * triple buffer having a single writer, an image arriving while the other
+   * one is written is dropped rather than waiting.
+   */
+  void Receive(ReceivedImage &&received) ATLAS_NOEXCEPT {
+    if (is_writing_.exchange(true, std::memory_order_acquire)) {
+      return;
+    }
+    received.sequence = ++sequence_;
     try {
-      auto cv_image_ptr = cv_bridge::toCvCopy(msg, "bgr8");
-      image_ = cv_image_ptr->image;
-    } catch (cv_bridge::Exception &e) {
-      ROS_ERROR("Unable to convert %s image to bgr8", msg->encoding.c_str());
+      std::atomic_store(&latest_image_,
+                        std::make_shared<const ReceivedImage>(received));
+    } catch (const std::bad_alloc &) {
+      // The readers keep the previous image, the stream gets this one.
     }
+    stream_images_.Write(std::move(received));
+    // Release the stale image of the write buffer, so its frame goes back
+    // to the pool and its message is freed.
+    stream_images_.GetWriteBuffer() = ReceivedImage();
+    is_writing_.store(false, std::memory_order_release);
   }
 
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  /**
+   * Forward the images of the intra-process channel to the subscriber.
+   */
+  class ChannelReceiver : public Observer<const ChannelImage &> {
+   public:
+    explicit ChannelReceiver(ImageSubscriber &subscriber)
+        : subscriber_(subscriber) {}
+
+   protected:
+    void OnSubjectNotify(Subject<const ChannelImage &> &subject,
+                         const ChannelImage &image) ATLAS_NOEXCEPT override {
+      subscriber_.OnChannelImage(image);
+    }
+
+   private:
+    ImageSubscriber &subscriber_;
+  };
+
   //============================================================================
   // P R I V A T E   M E M B E R S
 
@@ -85,9 +290,26 @@ class ImageSubscriber : public ImageSequenceCapture {
 
   image_transport::Subscriber subscriber_;
 
-  cv::Mat image_;
+  ImageChannel::Ptr channel_;
+
+  ChannelReceiver channel_receiver_;
+
+  /** Set while an image is published in the triple buffers. */
+  std::atomic<bool> is_writing_;
+
+  /** Only accessed while is_writing_ is set. */
+  uint64_t sequence_;
+
+  /** Only accessed with std::atomic_load and std::atomic_store. */
+  ReceivedImage::ConstPtr latest_image_;
+
+  /** Read by the streaming thread. */
+  TripleBuffer<ReceivedImage> stream_images_;
+
+  mutable std::mutex next_image_mutex_;
 
-  mutable std::mutex topic_mutex_;
+  /** Keeps the image returned by GetNextImage alive. */
+  mutable ReceivedImage::ConstPtr next_image_;
 };
 
 }  // namespace atlas
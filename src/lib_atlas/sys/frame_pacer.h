@@ -0,0 +1,191 @@
+/**
+ * \file	frame_pacer.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_SYS_FRAME_PACER_H_
+#define LIB_ATLAS_SYS_FRAME_PACER_H_
+
+#include <stdint.h>
+#include <atomic>
+
+#include <lib_atlas/macros.h>
+#include <lib_atlas/sys/latency_histogram.h>
+
+namespace atlas {
+
+/**
+ * A copy of the statistics of a FramePacer.
+ */
+struct FramePacerStats {
+  /** Number of frames that have been released. */
+  uint64_t frames = {0};
+
+  /**
+   * Number of frames released more than a period after their deadline. The
+   * schedule restarts from them rather than releasing a burst of frames.
+   */
+  uint64_t late_frames = {0};
+
+  /** Delay between the deadline of a frame and its release. */
+  LatencyHistogramSnapshot jitter;
+};
+
+/**
+ * Releases frames at a fixed rate.
+ *
+ * The deadline of the frame n is origin + n / rate, computed from the start
+ * of the schedule rather than from the previous frame, so the rounding and
+ * the lateness of the frames do not accumulate: a fractional rate -- e.g.
+ * 29.97Hz -- is kept on the long run. A frame released more than a period
+ * after its deadline restarts the schedule though, and the time it lost is
+ * not caught up. On Linux the thread sleeps until the deadline with
+ * clock_nanosleep(TIMER_ABSTIME) on the monotonic clock.
+ *
+ * WaitNextFrame is meant to be called by a single thread. Interrupt and the
+ * statistics can be used from any thread.
+ */
+class FramePacer {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param rate The number of frames per second, 0 to release the frames
+   *        as soon as they are requested.
+   * \throw std::invalid_argument If the rate is negative or not finite.
+   */
+  explicit FramePacer(double rate = 0);
+
+  FramePacer(const FramePacer &) = delete;
+
+  FramePacer &operator=(const FramePacer &) = delete;
+
+  virtual ~FramePacer() ATLAS_NOEXCEPT = default;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Change the rate and restart the schedule.
+   *
+   * \throw std::invalid_argument If the rate is negative or not finite.
+   */
+  void SetRate(double rate);
+
+  double GetRate() const ATLAS_NOEXCEPT;
+
+  /**
+   * Restart the schedule: the next frame is released right away. Must be
+   * called after a pause, otherwise the first frame is counted as late.
+   */
+  void Reset() ATLAS_NOEXCEPT;
+
+  /**
+   * Cancel an Interrupt.
+   */
+  void Resume() ATLAS_NOEXCEPT;
+
+  /**
+   * Sleep until the deadline of the next frame.
+   *
+   * \return False if the wait was interrupted by Interrupt.
+   */
+  bool WaitNextFrame() ATLAS_NOEXCEPT;
+
+  /**
+   * Make the current and the next calls to WaitNextFrame return false
+   * within kMaxSleepNs, until Resume is called.
+   */
+  void Interrupt() ATLAS_NOEXCEPT;
+
+  FramePacerStats GetStats() const;
+
+  void ResetStats() ATLAS_NOEXCEPT;
+
+  /**
+   * \return The time of the monotonic clock the deadlines are based on, in
+   *         nanoseconds.
+   */
+  static int64_t Now() ATLAS_NOEXCEPT;
+
+  /**
+   * Longest single sleep, so that an interruption is seen soon enough. The
+   * periods shorter than this are slept in one call.
+   */
+  static const int64_t kMaxSleepNs = 50000000;
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  /**
+   * \return The time the deadlines are computed on, in nanoseconds. This is
+   *         Now, unless a derived class provides its own clock -- e.g. to
+   *         test the schedule without sleeping.
+   */
+  virtual int64_t GetTime() const ATLAS_NOEXCEPT;
+
+  /**
+   * Sleep until wake_ns on the clock of GetTime. Waking up earlier is
+   * allowed, the sleep is then resumed.
+   */
+  virtual void SleepTo(int64_t wake_ns) ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Sleep until deadline_ns on the clock of GetTime, unless interrupted.
+   */
+  bool SleepUntil(int64_t deadline_ns) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  double rate_;
+
+  /** Period in nanoseconds, 0 if the rate is not limited. */
+  double period_ns_;
+
+  /** Release time of the frame 0 of the schedule. */
+  int64_t origin_ns_;
+
+  /** Index of the last released frame in the schedule, -1 if none. */
+  int64_t index_;
+
+  std::atomic<bool> is_interrupted_;
+
+  std::atomic<uint64_t> frames_;
+
+  std::atomic<uint64_t> late_frames_;
+
+  LatencyHistogram jitter_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/sys/frame_pacer_inl.h>
+
+#endif  // LIB_ATLAS_SYS_FRAME_PACER_H_
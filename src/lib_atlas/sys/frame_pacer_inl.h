@@ -0,0 +1,199 @@
+/**
+ * \file	frame_pacer_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_SYS_FRAME_PACER_H_
+#error This file may only be included from frame_pacer.h
+#endif
+
+#include <lib_atlas/sys/timer.h>
+#include <errno.h>
+#include <time.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FramePacer::FramePacer(double rate)
+    : rate_(0),
+      period_ns_(0),
+      origin_ns_(0),
+      index_(-1),
+      is_interrupted_(false),
+      frames_(0),
+      late_frames_(0),
+      jitter_() {
+  SetRate(rate);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FramePacer::SetRate(double rate) {
+  if (!std::isfinite(rate) || rate < 0) {
+    throw std::invalid_argument("the frame rate must be a positive number");
+  }
+  rate_ = rate;
+  period_ns_ = rate == 0 ? 0 : 1e9 / rate;
+  index_ = -1;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE double FramePacer::GetRate() const ATLAS_NOEXCEPT {
+  return rate_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FramePacer::Reset() ATLAS_NOEXCEPT { index_ = -1; }
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FramePacer::Resume() ATLAS_NOEXCEPT {
+  is_interrupted_.store(false, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool FramePacer::WaitNextFrame() ATLAS_NOEXCEPT {
+  if (is_interrupted_.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  int64_t now = GetTime();
+  if (period_ns_ == 0 || index_ < 0) {
+    origin_ns_ = now;
+    index_ = 0;
+    frames_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  int64_t deadline = origin_ns_ + static_cast<int64_t>(std::llround(
+                                      static_cast<double>(index_ + 1) *
+                                      period_ns_));
+  if (static_cast<double>(now - deadline) > period_ns_) {
+    // Catching up would release a burst of frames, start a new schedule.
+    origin_ns_ = now;
+    index_ = 0;
+    late_frames_.fetch_add(1, std::memory_order_relaxed);
+    frames_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  if (now < deadline) {
+    if (!SleepUntil(deadline)) {
+      return false;
+    }
+    now = GetTime();
+  }
+  ++index_;
+  jitter_.Record(static_cast<uint64_t>(std::max<int64_t>(now - deadline, 0)));
+  frames_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FramePacer::Interrupt() ATLAS_NOEXCEPT {
+  is_interrupted_.store(true, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FramePacerStats FramePacer::GetStats() const {
+  FramePacerStats stats;
+  stats.frames = frames_.load(std::memory_order_relaxed);
+  stats.late_frames = late_frames_.load(std::memory_order_relaxed);
+  stats.jitter = jitter_.Snapshot();
+  return stats;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FramePacer::ResetStats() ATLAS_NOEXCEPT {
+  frames_.store(0, std::memory_order_relaxed);
+  late_frames_.store(0, std::memory_order_relaxed);
+  jitter_.Reset();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t FramePacer::Now() ATLAS_NOEXCEPT {
+#ifdef OS_LINUX
+  timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+#else
+  return NanoTimer::Now();
+#endif
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t FramePacer::GetTime() const ATLAS_NOEXCEPT {
+  return Now();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FramePacer::SleepTo(int64_t wake_ns) ATLAS_NOEXCEPT {
+#ifdef OS_LINUX
+  timespec wake;
+  wake.tv_sec = static_cast<time_t>(wake_ns / 1000000000);
+  wake.tv_nsec = static_cast<long>(wake_ns % 1000000000);
+  // clock_nanosleep returns the error instead of setting errno.
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr) ==
+         EINTR) {
+  }
+#else
+  int64_t now = Now();
+  if (wake_ns > now) {
+    NanoTimer::Sleep(wake_ns - now);
+  }
+#endif
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool FramePacer::SleepUntil(int64_t deadline_ns) ATLAS_NOEXCEPT {
+  while (true) {
+    if (is_interrupted_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    int64_t now = GetTime();
+    if (now >= deadline_ns) {
+      return true;
+    }
+    SleepTo(std::min(deadline_ns, now + kMaxSleepNs));
+  }
+}
+
+}  // namespace atlas
@@ -0,0 +1,168 @@
+/**
+ * \file	instrumented_lock.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_SYS_INSTRUMENTED_LOCK_H_
+#define LIB_ATLAS_SYS_INSTRUMENTED_LOCK_H_
+
+#include <lib_atlas/macros.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <atomic>
+
+namespace atlas {
+
+/**
+ * Enumeration defines the strategies of an InstrumentedLock.
+ */
+enum class LockPolicy {
+  /** A pthread mutex. */
+  kMutex,
+  /**
+   * Spin for a short while before putting the thread to sleep. Best for
+   * short critical sections, where the lock is often released before the
+   * cost of a context switch would be paid.
+   */
+  kSpinThenPark,
+  /** No locking at all, for objects used by a single thread. */
+  kNone
+};
+
+/**
+ * Statistics of an InstrumentedLock, the times are in nanoseconds.
+ */
+struct LockStats {
+  /** Number of times the lock was taken. */
+  uint64_t acquisitions = {0};
+
+  /** Number of times the lock was held by another thread when requested. */
+  uint64_t contentions = {0};
+
+  uint64_t total_wait_ns = {0};
+
+  uint64_t max_wait_ns = {0};
+
+  uint64_t total_hold_ns = {0};
+
+  uint64_t max_hold_ns = {0};
+};
+
+/**
+ * A lock whose strategy is chosen at construction, and which counts the time
+ * the threads spent waiting for it and holding it.
+ *
+ * The wait time is only measured when the lock is contended. The counters are
+ * written by the owner of the lock only, so they cost no atomic
+ * read-modify-write operation. With the kNone policy, nothing is measured.
+ */
+class InstrumentedLock {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  explicit InstrumentedLock(LockPolicy policy = LockPolicy::kMutex);
+
+  ~InstrumentedLock() ATLAS_NOEXCEPT;
+
+  InstrumentedLock(const InstrumentedLock &) = delete;
+
+  InstrumentedLock &operator=(const InstrumentedLock &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  void Lock();
+
+  void Unlock();
+
+  LockPolicy GetPolicy() const ATLAS_NOEXCEPT;
+
+  LockStats GetStats() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of threads waiting for the lock, held by another
+   *         thread. Always 0 with the kNone policy.
+   */
+  uint32_t GetWaiterCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * Reset the counters. A concurrent acquisition may still be accounted for
+   * after the reset.
+   */
+  void ResetStats() ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * \return True if the lock was taken without waiting.
+   */
+  bool TryAcquire() ATLAS_NOEXCEPT;
+
+  void AcquireSlow();
+
+  void Release();
+
+  /**
+   * Add a value to a counter. Only called by the owner of the lock.
+   */
+  static void Add(std::atomic<uint64_t> &counter,
+                  uint64_t value) ATLAS_NOEXCEPT;
+
+  static void Max(std::atomic<uint64_t> &counter,
+                  uint64_t value) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  /** Number of tries before a kSpinThenPark lock puts the thread to sleep. */
+  static const int kSpinCount = 100;
+
+  LockPolicy policy_;
+
+  pthread_mutex_t mutex_;
+
+  /** State of a kSpinThenPark lock: 0 free, 1 locked, 2 locked with
+   *  sleeping waiters. */
+  std::atomic<int> state_;
+
+  int64_t locked_at_ns_;
+
+  /** Only updated on contention, by the waiting threads. */
+  std::atomic<uint32_t> waiters_;
+
+  std::atomic<uint64_t> acquisitions_;
+  std::atomic<uint64_t> contentions_;
+  std::atomic<uint64_t> total_wait_ns_;
+  std::atomic<uint64_t> max_wait_ns_;
+  std::atomic<uint64_t> total_hold_ns_;
+  std::atomic<uint64_t> max_hold_ns_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/sys/instrumented_lock_inl.h>
+
+#endif  // LIB_ATLAS_SYS_INSTRUMENTED_LOCK_H_
@@ -0,0 +1,252 @@
+/**
+ * \file	instrumented_lock_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_SYS_INSTRUMENTED_LOCK_H_
+#error This file may only be included from instrumented_lock.h
+#endif
+
+#include <lib_atlas/exceptions.h>
+#include <lib_atlas/sys/timer.h>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace atlas {
+
+namespace details {
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void CpuRelax() ATLAS_NOEXCEPT {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FutexWait(std::atomic<int> &word, int value) ATLAS_NOEXCEPT {
+#if defined(__linux__)
+  syscall(SYS_futex, reinterpret_cast<int *>(&word), FUTEX_WAIT_PRIVATE, value,
+          nullptr, nullptr, 0);
+#else
+  (void)word;
+  (void)value;
+  std::this_thread::yield();
+#endif
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FutexWakeOne(std::atomic<int> &word) ATLAS_NOEXCEPT {
+#if defined(__linux__)
+  syscall(SYS_futex, reinterpret_cast<int *>(&word), FUTEX_WAKE_PRIVATE, 1,
+          nullptr, nullptr, 0);
+#else
+  (void)word;
+#endif
+}
+
+}  // namespace details
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE InstrumentedLock::InstrumentedLock(LockPolicy policy)
+    : policy_(policy),
+      mutex_(),
+      state_(0),
+      locked_at_ns_(0),
+      waiters_(0),
+      acquisitions_(0),
+      contentions_(0),
+      total_wait_ns_(0),
+      max_wait_ns_(0),
+      total_hold_ns_(0),
+      max_hold_ns_(0) {
+  pthread_mutex_init(&mutex_, NULL);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE InstrumentedLock::~InstrumentedLock() ATLAS_NOEXCEPT {
+  pthread_mutex_destroy(&mutex_);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void InstrumentedLock::Lock() {
+  if (policy_ == LockPolicy::kNone) {
+    return;
+  }
+  if (!TryAcquire()) {
+    int64_t wait_start_ns = NanoTimer::Now();
+    waiters_.fetch_add(1, std::memory_order_relaxed);
+    try {
+      AcquireSlow();
+    } catch (...) {
+      waiters_.fetch_sub(1, std::memory_order_relaxed);
+      throw;
+    }
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+    locked_at_ns_ = NanoTimer::Now();
+    uint64_t wait_ns = static_cast<uint64_t>(locked_at_ns_ - wait_start_ns);
+    Add(contentions_, 1);
+    Add(total_wait_ns_, wait_ns);
+    Max(max_wait_ns_, wait_ns);
+  } else {
+    locked_at_ns_ = NanoTimer::Now();
+  }
+  Add(acquisitions_, 1);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void InstrumentedLock::Unlock() {
+  if (policy_ == LockPolicy::kNone) {
+    return;
+  }
+  uint64_t hold_ns = static_cast<uint64_t>(NanoTimer::Now() - locked_at_ns_);
+  Add(total_hold_ns_, hold_ns);
+  Max(max_hold_ns_, hold_ns);
+  Release();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LockPolicy InstrumentedLock::GetPolicy() const ATLAS_NOEXCEPT {
+  return policy_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LockStats InstrumentedLock::GetStats() const ATLAS_NOEXCEPT {
+  LockStats stats;
+  stats.acquisitions = acquisitions_.load(std::memory_order_relaxed);
+  stats.contentions = contentions_.load(std::memory_order_relaxed);
+  stats.total_wait_ns = total_wait_ns_.load(std::memory_order_relaxed);
+  stats.max_wait_ns = max_wait_ns_.load(std::memory_order_relaxed);
+  stats.total_hold_ns = total_hold_ns_.load(std::memory_order_relaxed);
+  stats.max_hold_ns = max_hold_ns_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint32_t InstrumentedLock::GetWaiterCount() const ATLAS_NOEXCEPT {
+  return waiters_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void InstrumentedLock::ResetStats() ATLAS_NOEXCEPT {
+  acquisitions_.store(0, std::memory_order_relaxed);
+  contentions_.store(0, std::memory_order_relaxed);
+  total_wait_ns_.store(0, std::memory_order_relaxed);
+  max_wait_ns_.store(0, std::memory_order_relaxed);
+  total_hold_ns_.store(0, std::memory_order_relaxed);
+  max_hold_ns_.store(0, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool InstrumentedLock::TryAcquire() ATLAS_NOEXCEPT {
+  if (policy_ == LockPolicy::kMutex) {
+    return pthread_mutex_trylock(&mutex_) == 0;
+  }
+  int expected = 0;
+  return state_.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                        std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void InstrumentedLock::AcquireSlow() {
+  if (policy_ == LockPolicy::kMutex) {
+    int result = pthread_mutex_lock(&mutex_);
+    if (result) {
+      ATLAS_THROW(IOException, result);
+    }
+    return;
+  }
+  for (int i = 0; i < kSpinCount; ++i) {
+    details::CpuRelax();
+    int expected = 0;
+    if (state_.load(std::memory_order_relaxed) == 0 &&
+        state_.compare_exchange_weak(expected, 1, std::memory_order_acquire,
+                                     std::memory_order_relaxed)) {
+      return;
+    }
+  }
+  // Mark the lock as having sleeping waiters so the owner wakes one up.
+  while (state_.exchange(2, std::memory_order_acquire) != 0) {
+    details::FutexWait(state_, 2);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void InstrumentedLock::Release() {
+  if (policy_ == LockPolicy::kMutex) {
+    int result = pthread_mutex_unlock(&mutex_);
+    if (result) {
+      ATLAS_THROW(IOException, result);
+    }
+    return;
+  }
+  if (state_.exchange(0, std::memory_order_release) == 2) {
+    details::FutexWakeOne(state_);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void InstrumentedLock::Add(std::atomic<uint64_t> &counter,
+                                               uint64_t value) ATLAS_NOEXCEPT {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void InstrumentedLock::Max(std::atomic<uint64_t> &counter,
+                                               uint64_t value) ATLAS_NOEXCEPT {
+  if (value > counter.load(std::memory_order_relaxed)) {
+    counter.store(value, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace atlas
@@ -0,0 +1,112 @@
+/**
+ * \file	latency_histogram.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_SYS_LATENCY_HISTOGRAM_H_
+#define LIB_ATLAS_SYS_LATENCY_HISTOGRAM_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <lib_atlas/macros.h>
+
+namespace atlas {
+
+/**
+ * A copy of the content of a LatencyHistogram.
+ *
+ * The bucket i counts the durations d such that 2^(i-1) <= d < 2^i
+ * nanoseconds, the bucket 0 counting the durations of 0ns.
+ */
+struct LatencyHistogramSnapshot {
+  std::vector<uint64_t> buckets;
+
+  uint64_t count = {0};
+
+  uint64_t total_ns = {0};
+
+  uint64_t max_ns = {0};
+
+  double MeanNs() const ATLAS_NOEXCEPT;
+
+  /**
+   * \param percentile The percentile in [0, 100].
+   * \return The upper bound of the bucket holding the percentile, in
+   *         nanoseconds. The precision is thus a factor of two.
+   */
+  uint64_t PercentileNs(double percentile) const ATLAS_NOEXCEPT;
+
+  /**
+   * \return A summary of the histogram followed by its non empty buckets.
+   */
+  std::string ToString() const;
+};
+
+/**
+ * A histogram of durations with logarithmic buckets, which can be updated
+ * concurrently without locks.
+ */
+class LatencyHistogram {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  LatencyHistogram() ATLAS_NOEXCEPT;
+
+  LatencyHistogram(const LatencyHistogram &) = delete;
+
+  LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  void Record(uint64_t duration_ns) ATLAS_NOEXCEPT;
+
+  LatencyHistogramSnapshot Snapshot() const;
+
+  void Reset() ATLAS_NOEXCEPT;
+
+  /** 2^40ns is about 18 minutes, longer durations go in the last bucket. */
+  static const size_t kBucketCount = 41;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::atomic<uint64_t> buckets_[kBucketCount];
+
+  std::atomic<uint64_t> count_;
+
+  std::atomic<uint64_t> total_ns_;
+
+  std::atomic<uint64_t> max_ns_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/sys/latency_histogram_inl.h>
+
+#endif  // LIB_ATLAS_SYS_LATENCY_HISTOGRAM_H_
@@ -0,0 +1,145 @@
+/**
+ * \file	latency_histogram_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_SYS_LATENCY_HISTOGRAM_H_
+#error This file may only be included from latency_histogram.h
+#endif
+
+#include <lib_atlas/io/formatter.h>
+
+namespace atlas {
+
+//==============================================================================
+// L A T E N C Y   H I S T O G R A M   S N A P S H O T   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE double LatencyHistogramSnapshot::MeanNs() const ATLAS_NOEXCEPT {
+  if (count == 0) {
+    return 0.;
+  }
+  return static_cast<double>(total_ns) / static_cast<double>(count);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t
+LatencyHistogramSnapshot::PercentileNs(double percentile) const ATLAS_NOEXCEPT {
+  if (count == 0) {
+    return 0;
+  }
+  uint64_t rank = static_cast<uint64_t>(percentile / 100. * count);
+  if (rank >= count) {
+    rank = count - 1;
+  }
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen > rank) {
+      // The last bucket is unbounded, its real upper bound is the maximum.
+      return i + 1 == buckets.size() ? max_ns : uint64_t(1) << i;
+    }
+  }
+  return max_ns;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::string LatencyHistogramSnapshot::ToString() const {
+  std::string result = Format(
+      "count {0}, mean {1}us, p50 < {2}us, p99 < {3}us, max {4}us\n", count,
+      MeanNs() / 1000., PercentileNs(50.) / 1000., PercentileNs(99.) / 1000.,
+      max_ns / 1000.);
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    if (buckets[i] == 0) {
+      continue;
+    }
+    uint64_t lower = i == 0 ? 0 : uint64_t(1) << (i - 1);
+    result += Format("  >= {0,12}ns: {1}\n", lower, buckets[i]);
+  }
+  return result;
+}
+
+//==============================================================================
+// L A T E N C Y   H I S T O G R A M   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LatencyHistogram::LatencyHistogram() ATLAS_NOEXCEPT
+    : count_(0),
+      total_ns_(0),
+      max_ns_(0) {
+  for (auto &bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void LatencyHistogram::Record(uint64_t duration_ns)
+    ATLAS_NOEXCEPT {
+  size_t index =
+      duration_ns == 0 ? 0 : 64 - static_cast<size_t>(__builtin_clzll(
+                                      static_cast<unsigned long long>(
+                                          duration_ns)));
+  if (index >= kBucketCount) {
+    index = kBucketCount - 1;
+  }
+  buckets_[index].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  total_ns_.fetch_add(duration_ns, std::memory_order_relaxed);
+  uint64_t max = max_ns_.load(std::memory_order_relaxed);
+  while (duration_ns > max &&
+         !max_ns_.compare_exchange_weak(max, duration_ns,
+                                        std::memory_order_relaxed)) {
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LatencyHistogramSnapshot LatencyHistogram::Snapshot() const {
+  LatencyHistogramSnapshot snapshot;
+  snapshot.buckets.reserve(kBucketCount);
+  for (const auto &bucket : buckets_) {
+    snapshot.buckets.push_back(bucket.load(std::memory_order_relaxed));
+  }
+  snapshot.count = count_.load(std::memory_order_relaxed);
+  snapshot.total_ns = total_ns_.load(std::memory_order_relaxed);
+  snapshot.max_ns = max_ns_.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void LatencyHistogram::Reset() ATLAS_NOEXCEPT {
+  for (auto &bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  total_ns_.store(0, std::memory_order_relaxed);
+  max_ns_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace atlas
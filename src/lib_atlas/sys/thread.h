@@ -0,0 +1,144 @@
+/**
+ * \file	thread.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_SYS_THREAD_H_
+#define LIB_ATLAS_SYS_THREAD_H_
+
+#include <lib_atlas/macros.h>
+#include <pthread.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * The attributes a Thread is created with. The default attributes give the
+ * same thread as a std::thread.
+ *
+ * The CPU set and the name are only applied on Linux.
+ */
+struct ThreadAttributes {
+  enum class Policy {
+    /** Keep the policy and the priority of the creating thread. */
+    kInherit = 0,
+    /** SCHED_OTHER, the default time sharing policy. */
+    kOther,
+    /** SCHED_FIFO, realtime until the thread blocks or yields. */
+    kFifo,
+    /** SCHED_RR, realtime with a time slice between equal priorities. */
+    kRoundRobin
+  };
+
+  /** The CPUs the thread may run on, empty for all of them. */
+  std::vector<int> cpus;
+
+  Policy policy = {Policy::kInherit};
+
+  /** The static priority, 1 to 99 for kFifo and kRoundRobin, else 0. */
+  int priority = {0};
+
+  /** The name shown by top or gdb, truncated to 15 characters. */
+  std::string name;
+
+  /** The size of the stack in bytes, 0 for the default size. */
+  size_t stack_size = {0};
+};
+
+/**
+ * \return The CPUs of a NUMA node, read from sysfs, or an empty vector if
+ *         the node does not exist.
+ */
+std::vector<int> GetNumaNodeCpus(int node);
+
+/**
+ * A thread created with ThreadAttributes.
+ *
+ * Contrary to a std::thread, the attributes are applied by pthread_create,
+ * so the function never runs on the wrong CPU or with the wrong policy. As
+ * a std::thread, a Thread must be joined before being destroyed.
+ */
+class Thread {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  Thread() ATLAS_NOEXCEPT;
+
+  /**
+   * Start a thread executing fn.
+   *
+   * \throw std::system_error if the thread cannot be created with these
+   *        attributes, for instance EPERM when a realtime policy is
+   *        requested without the CAP_SYS_NICE capability.
+   */
+  template <class Fn_>
+  Thread(const ThreadAttributes &attributes, Fn_ &&fn);
+
+  Thread(Thread &&rhs) ATLAS_NOEXCEPT;
+
+  Thread &operator=(Thread &&rhs) ATLAS_NOEXCEPT;
+
+  ~Thread() ATLAS_NOEXCEPT;
+
+  Thread(const Thread &) = delete;
+
+  Thread &operator=(const Thread &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  void Join();
+
+  bool IsJoinable() const ATLAS_NOEXCEPT;
+
+  pthread_t GetNativeHandle() const ATLAS_NOEXCEPT;
+
+  const ThreadAttributes &GetAttributes() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  void Create(std::unique_ptr<std::function<void()>> fn);
+
+  static void *Execute(void *fn) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  pthread_t handle_;
+
+  bool is_joinable_;
+
+  ThreadAttributes attributes_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/sys/thread_inl.h>
+
+#endif  // LIB_ATLAS_SYS_THREAD_H_
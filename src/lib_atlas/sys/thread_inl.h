@@ -0,0 +1,235 @@
+/**
+ * \file	thread_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_SYS_THREAD_H_
+#error This file may only be included from thread.h
+#endif
+
+#include <sched.h>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <utility>
+
+namespace atlas {
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::vector<int> GetNumaNodeCpus(int node) {
+  std::vector<int> cpus;
+  std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) +
+                     "/cpulist");
+  std::string list;
+  if (!std::getline(file, list)) {
+    return cpus;
+  }
+
+  // The list is made of ranges separated by commas, as "0-3,8-11".
+  std::istringstream ranges(list);
+  std::string range;
+  while (std::getline(ranges, range, ',')) {
+    if (range.empty()) {
+      continue;
+    }
+    size_t dash = range.find('-');
+    int first = std::stoi(range.substr(0, dash));
+    int last =
+        dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Thread::Thread() ATLAS_NOEXCEPT : handle_(),
+                                               is_joinable_(false),
+                                               attributes_() {}
+
+//------------------------------------------------------------------------------
+//
+template <class Fn_>
+Thread::Thread(const ThreadAttributes &attributes, Fn_ &&fn)
+    : handle_(), is_joinable_(false), attributes_(attributes) {
+  Create(std::unique_ptr<std::function<void()>>(
+      new std::function<void()>(std::forward<Fn_>(fn))));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Thread::Thread(Thread &&rhs) ATLAS_NOEXCEPT
+    : handle_(rhs.handle_),
+      is_joinable_(rhs.is_joinable_),
+      attributes_(std::move(rhs.attributes_)) {
+  rhs.is_joinable_ = false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Thread &Thread::operator=(Thread &&rhs) ATLAS_NOEXCEPT {
+  if (is_joinable_) {
+    std::terminate();
+  }
+  handle_ = rhs.handle_;
+  is_joinable_ = rhs.is_joinable_;
+  attributes_ = std::move(rhs.attributes_);
+  rhs.is_joinable_ = false;
+  return *this;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Thread::~Thread() ATLAS_NOEXCEPT {
+  if (is_joinable_) {
+    std::terminate();
+  }
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Thread::Join() {
+  if (!is_joinable_) {
+    throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                            "Thread::Join");
+  }
+  int error = pthread_join(handle_, nullptr);
+  if (error != 0) {
+    throw std::system_error(error, std::system_category(), "pthread_join");
+  }
+  is_joinable_ = false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Thread::IsJoinable() const ATLAS_NOEXCEPT {
+  return is_joinable_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE pthread_t Thread::GetNativeHandle() const ATLAS_NOEXCEPT {
+  return handle_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const ThreadAttributes &Thread::GetAttributes() const
+    ATLAS_NOEXCEPT {
+  return attributes_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Thread::Create(std::unique_ptr<std::function<void()>> fn) {
+  pthread_attr_t attr;
+  int error = pthread_attr_init(&attr);
+  if (error != 0) {
+    throw std::system_error(error, std::system_category(),
+                            "pthread_attr_init");
+  }
+  const char *step = "pthread_attr_setstacksize";
+  if (attributes_.stack_size != 0) {
+    error = pthread_attr_setstacksize(&attr, attributes_.stack_size);
+  }
+
+#if defined(__linux__)
+  if (error == 0 && !attributes_.cpus.empty()) {
+    step = "pthread_attr_setaffinity_np";
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (int cpu : attributes_.cpus) {
+      if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        error = EINVAL;
+        break;
+      }
+      CPU_SET(cpu, &cpus);
+    }
+    if (error == 0) {
+      error = pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+    }
+  }
+#endif
+
+  if (error == 0 &&
+      attributes_.policy != ThreadAttributes::Policy::kInherit) {
+    int policy = SCHED_OTHER;
+    if (attributes_.policy == ThreadAttributes::Policy::kFifo) {
+      policy = SCHED_FIFO;
+    } else if (attributes_.policy == ThreadAttributes::Policy::kRoundRobin) {
+      policy = SCHED_RR;
+    }
+    sched_param param;
+    param.sched_priority = attributes_.priority;
+    step = "pthread_attr_setschedparam";
+    error = pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    if (error == 0) {
+      error = pthread_attr_setschedpolicy(&attr, policy);
+    }
+    if (error == 0) {
+      error = pthread_attr_setschedparam(&attr, &param);
+    }
+  }
+
+  if (error == 0) {
+    step = "pthread_create";
+    error = pthread_create(&handle_, &attr, &Thread::Execute, fn.get());
+  }
+  pthread_attr_destroy(&attr);
+  if (error != 0) {
+    throw std::system_error(error, std::system_category(), step);
+  }
+  // The thread owns the function from now on.
+  fn.release();
+  is_joinable_ = true;
+
+#if defined(__linux__)
+  if (!attributes_.name.empty()) {
+    // The name is limited to 16 bytes with the terminating null.
+    pthread_setname_np(handle_, attributes_.name.substr(0, 15).c_str());
+  }
+#endif
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void *Thread::Execute(void *fn) ATLAS_NOEXCEPT {
+  // As with a std::thread, an exception thrown by the function terminates
+  // the program.
+  std::unique_ptr<std::function<void()>> function(
+      static_cast<std::function<void()> *>(fn));
+  (*function)();
+  return nullptr;
+}
+
+}  // namespace atlas
@@ -0,0 +1,165 @@
+/**
+ * \file	allocation_counter.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_TEST_ALLOCATION_COUNTER_H_
+#define LIB_ATLAS_TEST_ALLOCATION_COUNTER_H_
+
+#include <lib_atlas/macros.h>
+#include <stdlib.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replace the global allocation functions to count the allocations of the
+// whole program. The replacements cannot be inline, so this file must be
+// included by a single translation unit of the program.
+//
+// Every form is replaced, so that the memory of a form of operator new is
+// never released by the default version of the matching operator delete.
+
+std::atomic<size_t> g_allocations(0);
+
+namespace {
+
+void *CountedAllocate(size_t size) ATLAS_NOEXCEPT {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+// Not inlined in the operators delete, so the compiler does not see their
+// memory going from operator new to free -- see -Wmismatched-new-delete.
+__attribute__((noinline)) void CountedRelease(void *pointer) ATLAS_NOEXCEPT {
+  std::free(pointer);
+}
+
+#if defined(__cpp_aligned_new)
+void *CountedAllocate(size_t size, std::align_val_t alignment) ATLAS_NOEXCEPT {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  void *pointer = nullptr;
+  size_t align = static_cast<size_t>(alignment);
+  if (posix_memalign(&pointer, align < sizeof(void *) ? sizeof(void *) : align,
+                     size == 0 ? 1 : size) != 0) {
+    return nullptr;
+  }
+  return pointer;
+}
+#endif
+
+}  // namespace
+
+void *operator new(size_t size) {
+  void *pointer = CountedAllocate(size);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+
+void *operator new(size_t size, const std::nothrow_t &) ATLAS_NOEXCEPT {
+  return CountedAllocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) ATLAS_NOEXCEPT {
+  return CountedAllocate(size);
+}
+
+void operator delete(void *pointer) ATLAS_NOEXCEPT {
+  CountedRelease(pointer);
+}
+
+void operator delete[](void *pointer) ATLAS_NOEXCEPT {
+  CountedRelease(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) ATLAS_NOEXCEPT {
+  CountedRelease(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) ATLAS_NOEXCEPT {
+  CountedRelease(pointer);
+}
+
+void operator delete(void *pointer, size_t) ATLAS_NOEXCEPT {
+  CountedRelease(pointer);
+}
+
+void operator delete[](void *pointer, size_t) ATLAS_NOEXCEPT {
+  CountedRelease(pointer);
+}
+
+#if defined(__cpp_aligned_new)
+void *operator new(size_t size, std::align_val_t alignment) {
+  void *pointer = CountedAllocate(size, alignment);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void *operator new[](size_t size, std::align_val_t alignment) {
+  return operator new(size, alignment);
+}
+
+void *operator new(size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) ATLAS_NOEXCEPT {
+  return CountedAllocate(size, alignment);
+}
+
+void *operator new[](size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &) ATLAS_NOEXCEPT {
+  return CountedAllocate(size, alignment);
+}
+
+void operator delete(void *pointer, std::align_val_t) ATLAS_NOEXCEPT {
+  CountedRelease(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) ATLAS_NOEXCEPT {
+  CountedRelease(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t,
+                     const std::nothrow_t &) ATLAS_NOEXCEPT {
+  CountedRelease(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t,
+                       const std::nothrow_t &) ATLAS_NOEXCEPT {
+  CountedRelease(pointer);
+}
+
+void operator delete(void *pointer, size_t, std::align_val_t) ATLAS_NOEXCEPT {
+  CountedRelease(pointer);
+}
+
+void operator delete[](void *pointer, size_t,
+                       std::align_val_t) ATLAS_NOEXCEPT {
+  CountedRelease(pointer);
+}
+#endif
+
+#endif  // LIB_ATLAS_TEST_ALLOCATION_COUNTER_H_
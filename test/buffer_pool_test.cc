@@ -0,0 +1,211 @@
+/**
+ * \file	buffer_pool_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <lib_atlas/pattern/buffer_pool.h>
+#include <lib_atlas/pattern/observer.h>
+#include <lib_atlas/pattern/subject.h>
+#include <lib_atlas/sys/timer.h>
+#include <lib_atlas/pattern/thread_pool.h>
+#include <atomic>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace atlas;
+
+using Pool = BufferPool<std::vector<uint8_t>>;
+
+namespace {
+
+class FrameObserver : public Observer<const Pool::Handle &> {
+ public:
+  std::vector<Pool::Handle> kept_;
+
+ protected:
+  auto OnSubjectNotify(Subject<const Pool::Handle &> &subject,
+                       const Pool::Handle &frame) ATLAS_NOEXCEPT
+      -> void override {
+    kept_.push_back(frame);
+  }
+};
+
+}  // namespace
+
+TEST(BufferPoolTest, buffersAreRecycled) {
+  Pool pool(2, []() { return std::vector<uint8_t>(1024); });
+  ASSERT_EQ(pool.GetCapacity(), 2);
+
+  const uint8_t *data = nullptr;
+  {
+    Pool::Handle frame = pool.TryAcquire();
+    ASSERT_TRUE(static_cast<bool>(frame));
+    ASSERT_EQ(frame->size(), 1024);
+    data = frame->data();
+    (*frame)[0] = 42;
+  }
+  ASSERT_EQ(pool.GetStats().available, 2);
+
+  // The last released buffer is reused first, with its content.
+  Pool::Handle frame = pool.TryAcquire();
+  ASSERT_EQ(frame->data(), data);
+  ASSERT_EQ(frame.Get()[0], 42);
+  ASSERT_EQ(pool.GetStats().acquired, 2);
+}
+
+TEST(BufferPoolTest, lastHandleReleasesTheBuffer) {
+  Pool pool(1);
+  Pool::Handle frame = pool.TryAcquire();
+  Pool::Handle copy = frame;
+  ASSERT_EQ(frame.UseCount(), 2);
+
+  ASSERT_FALSE(static_cast<bool>(pool.TryAcquire()));
+  ASSERT_EQ(pool.GetStats().exhausted, 1);
+
+  frame.Reset();
+  ASSERT_FALSE(static_cast<bool>(frame));
+  ASSERT_EQ(pool.GetStats().available, 0);
+  Pool::Handle moved = std::move(copy);
+  ASSERT_EQ(moved.UseCount(), 1);
+  moved = Pool::Handle();
+  ASSERT_EQ(pool.GetStats().available, 1);
+  ASSERT_THROW(moved.Get(), std::logic_error);
+}
+
+TEST(BufferPoolTest, acquireWaitsForARelease) {
+  Pool pool(1);
+  Pool::Handle frame = pool.Acquire();
+  std::atomic<bool> is_acquired = {false};
+  std::thread waiter([&]() {
+    Pool::Handle other = pool.Acquire();
+    is_acquired = true;
+  });
+  MilliTimer::Sleep(10);
+  ASSERT_FALSE(is_acquired);
+  frame.Reset();
+  waiter.join();
+  ASSERT_TRUE(is_acquired);
+}
+
+TEST(BufferPoolTest, handlesOutliveThePool) {
+  Pool::Handle frame;
+  {
+    Pool pool(2, []() { return std::vector<uint8_t>(16, 7); });
+    frame = pool.TryAcquire();
+  }
+  ASSERT_EQ((*frame)[15], 7);
+  frame.Reset();
+}
+
+TEST(BufferPoolTest, observersHoldTheFrames) {
+  Pool pool(4);
+  Subject<const Pool::Handle &> subject;
+  FrameObserver synchronous;
+  FrameObserver queued;
+  queued.SetQueuedDelivery(MailboxOptions());
+  subject.Attach(synchronous);
+  subject.Attach(queued);
+
+  std::set<const std::vector<uint8_t> *> buffers;
+  for (int i = 0; i < 2; ++i) {
+    Pool::Handle frame = pool.TryAcquire();
+    buffers.insert(&*frame);
+    subject.Notify(frame);
+  }
+  queued.StopQueuedDelivery();
+  ASSERT_EQ(buffers.size(), 2);
+  ASSERT_EQ(pool.GetStats().available, 2);
+
+  synchronous.kept_.clear();
+  ASSERT_EQ(pool.GetStats().available, 2);
+  queued.kept_.clear();
+  ASSERT_EQ(pool.GetStats().available, 4);
+  subject.DetachAll();
+}
+
+TEST(BufferPoolTest, discardedNotificationsReleaseTheFrames) {
+  Pool pool(4);
+  Subject<const Pool::Handle &> subject;
+  std::unique_ptr<FrameObserver> queued(new FrameObserver);
+  MailboxOptions options;
+  options.capacity = 2;
+  options.overflow = OverflowPolicy::kDropOldest;
+  ThreadPool workers(1);
+  queued->SetQueuedDelivery(options, workers);
+  subject.Attach(*queued);
+
+  // Block the only worker so the notifications stay in the mailbox.
+  std::atomic<bool> is_blocked = {true};
+  workers.Post([&is_blocked]() {
+    while (is_blocked) {
+      std::this_thread::yield();
+    }
+  });
+  for (int i = 0; i < 3; ++i) {
+    subject.Notify(pool.TryAcquire());
+  }
+  // The oldest frame was dropped, the mailbox holds the two others.
+  ASSERT_EQ(pool.GetStats().available, 2);
+
+  // Destroying the observer discards its pending notifications.
+  std::thread destroyer([&queued]() { queued.reset(); });
+  MilliTimer::Sleep(10);
+  is_blocked = false;
+  destroyer.join();
+  ASSERT_EQ(pool.GetStats().available, 4);
+}
+
+TEST(BufferPoolTest, concurrentCopiesAndReleases) {
+  const int kIterations = 20000;
+  Pool pool(4);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&pool, kIterations]() {
+      for (int i = 0; i < kIterations; ++i) {
+        Pool::Handle frame = pool.Acquire();
+        Pool::Handle copy = frame;
+        frame.Reset();
+        copy = Pool::Handle();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  BufferPoolStats stats = pool.GetStats();
+  ASSERT_EQ(stats.available, 4);
+  ASSERT_EQ(stats.acquired, 4 * kIterations);
+}
+
+TEST(BufferPoolTest, zeroBuffersThrows) {
+  ASSERT_THROW(Pool(0), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
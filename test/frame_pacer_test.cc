@@ -0,0 +1,145 @@
+/**
+ * \file	frame_pacer_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <lib_atlas/sys/frame_pacer.h>
+#include <lib_atlas/sys/timer.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+using namespace atlas;
+
+namespace {
+
+/**
+ * A pacer on a simulated clock: a sleep moves the clock to the wake up time,
+ * plus a delay that simulates a late wake up.
+ */
+class SimulatedPacer : public FramePacer {
+ public:
+  explicit SimulatedPacer(double rate) : FramePacer(rate) {}
+
+  int64_t now_ = 1000000000;
+
+  int64_t wake_up_delay_ = 0;
+
+ protected:
+  int64_t GetTime() const ATLAS_NOEXCEPT override { return now_; }
+
+  void SleepTo(int64_t wake_ns) ATLAS_NOEXCEPT override {
+    now_ = std::max(now_, wake_ns + wake_up_delay_);
+  }
+};
+
+}  // namespace
+
+TEST(FramePacerTest, fractionalRateIsKept) {
+  const double kRate = 29.97;
+  const int kFrames = 10000;
+  SimulatedPacer pacer(kRate);
+  // Late, but by less than a period: the schedule is kept.
+  pacer.wake_up_delay_ = 1000000;
+
+  ASSERT_TRUE(pacer.WaitNextFrame());
+  const int64_t origin = pacer.now_;
+  for (int i = 1; i <= kFrames; ++i) {
+    ASSERT_TRUE(pacer.WaitNextFrame());
+    // The deadlines are absolute: neither the rounding of the period nor
+    // the lateness accumulate.
+    int64_t deadline = origin + std::llround(i * 1e9 / kRate);
+    ASSERT_EQ(pacer.now_, deadline + pacer.wake_up_delay_);
+  }
+
+  FramePacerStats stats = pacer.GetStats();
+  ASSERT_EQ(stats.frames, kFrames + 1);
+  ASSERT_EQ(stats.late_frames, 0);
+  ASSERT_EQ(stats.jitter.count, kFrames);
+}
+
+TEST(FramePacerTest, unlimitedRateDoesNotSleep) {
+  SimulatedPacer pacer(0);
+  int64_t start = pacer.now_;
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(pacer.WaitNextFrame());
+  }
+  ASSERT_EQ(pacer.now_, start);
+  ASSERT_EQ(pacer.GetStats().frames, 1000);
+}
+
+TEST(FramePacerTest, lateFrameRestartsTheSchedule) {
+  SimulatedPacer pacer(100);
+  ASSERT_TRUE(pacer.WaitNextFrame());
+  pacer.now_ += 50000000;
+
+  // More than a period late: released right away, without catching up.
+  int64_t late = pacer.now_;
+  ASSERT_TRUE(pacer.WaitNextFrame());
+  ASSERT_EQ(pacer.now_, late);
+  ASSERT_EQ(pacer.GetStats().late_frames, 1);
+
+  // The next frame is a full period after the late one, not a burst.
+  ASSERT_TRUE(pacer.WaitNextFrame());
+  ASSERT_EQ(pacer.now_, late + 10000000);
+  ASSERT_EQ(pacer.GetStats().frames, 3);
+}
+
+TEST(FramePacerTest, interruptWakesTheWaitingThread) {
+  FramePacer pacer(0.1);
+  pacer.WaitNextFrame();
+
+  std::atomic<bool> result = {true};
+  int64_t start = FramePacer::Now();
+  std::thread waiter([&]() { result = pacer.WaitNextFrame(); });
+  MilliTimer::Sleep(10);
+  pacer.Interrupt();
+  waiter.join();
+  ASSERT_FALSE(result);
+  ASSERT_LT(FramePacer::Now() - start, 2 * FramePacer::kMaxSleepNs + 10000000);
+
+  ASSERT_FALSE(pacer.WaitNextFrame());
+  pacer.Resume();
+  pacer.Reset();
+  ASSERT_TRUE(pacer.WaitNextFrame());
+}
+
+TEST(FramePacerTest, invalidRateThrows) {
+  ASSERT_THROW(FramePacer(-1), std::invalid_argument);
+  FramePacer pacer;
+  ASSERT_THROW(pacer.SetRate(std::numeric_limits<double>::infinity()),
+               std::invalid_argument);
+  ASSERT_THROW(pacer.SetRate(std::numeric_limits<double>::quiet_NaN()),
+               std::invalid_argument);
+  pacer.SetRate(29.97);
+  ASSERT_EQ(pacer.GetRate(), 29.97);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,191 @@
+/**
+ * \file	framer_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <lib_atlas/io/framer.h>
+#include <string>
+#include <vector>
+
+using namespace atlas;
+
+namespace {
+
+std::vector<uint8_t> Bytes(const std::string &str) {
+  return std::vector<uint8_t>(str.begin(), str.end());
+}
+
+// Extract all the frames of the buffer, as a stream reader would do.
+std::vector<std::string> ExtractAll(Framer &framer,
+                                    std::vector<uint8_t> buffer) {
+  std::vector<std::string> frames;
+  size_t offset = 0;
+  while (offset < buffer.size()) {
+    FrameView frame;
+    size_t consumed =
+        framer.Extract(&buffer[offset], buffer.size() - offset, frame);
+    if (consumed == 0) {
+      break;
+    }
+    offset += consumed;
+    if (frame.data != nullptr) {
+      frames.push_back(frame.ToString());
+    }
+  }
+  return frames;
+}
+
+// Build a frame of the SyncWordFramer with a big endian length and CRC.
+std::vector<uint8_t> SyncFrame(const std::string &payload, bool crc32) {
+  std::vector<uint8_t> frame = {0xAA, 0x55};
+  frame.push_back(static_cast<uint8_t>(payload.size() >> 8));
+  frame.push_back(static_cast<uint8_t>(payload.size()));
+  frame.insert(frame.end(), payload.begin(), payload.end());
+  uint32_t crc = crc32 ? Crc32(&frame[2], frame.size() - 2)
+                       : Crc16(&frame[2], frame.size() - 2);
+  for (int shift = crc32 ? 24 : 8; shift >= 0; shift -= 8) {
+    frame.push_back(static_cast<uint8_t>(crc >> shift));
+  }
+  return frame;
+}
+
+TEST(FramerTest, crcCheckValues) {
+  std::vector<uint8_t> check = Bytes("123456789");
+  EXPECT_EQ(Crc16(check.data(), check.size()), 0x29B1);
+  EXPECT_EQ(Crc32(check.data(), check.size()), 0xCBF43926);
+}
+
+TEST(FramerTest, delimiterFramer) {
+  DelimiterFramer framer("\r\n");
+  auto frames = ExtractAll(framer, Bytes("$A,1\r\n$B,2\r\n$C"));
+  ASSERT_EQ(frames.size(), 2);
+  EXPECT_EQ(frames[0], std::string("$A,1"));
+  EXPECT_EQ(frames[1], std::string("$B,2"));
+
+  // A frame longer than the maximum payload is discarded.
+  DelimiterFramer small_framer("\n", 4);
+  frames = ExtractAll(small_framer, Bytes("abcdefgh\nabc\n"));
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_EQ(frames[0], std::string("abc"));
+
+  ASSERT_THROW(DelimiterFramer(""), std::invalid_argument);
+}
+
+TEST(FramerTest, lengthPrefixFramer) {
+  LengthPrefixFramer framer(2, true, 16);
+  std::vector<uint8_t> buffer = {0x00, 0x03, 'a', 'b', 'c', 0x00, 0x02, 'd'};
+  FrameView frame;
+  ASSERT_EQ(framer.Extract(buffer.data(), buffer.size(), frame), 5);
+  EXPECT_EQ(frame.ToString(), std::string("abc"));
+
+  // The second frame is partial.
+  frame = FrameView();
+  ASSERT_EQ(framer.Extract(&buffer[5], 3, frame), 0);
+  EXPECT_EQ(frame.data, nullptr);
+
+  // An oversized length is skipped byte by byte.
+  LengthPrefixFramer little_endian(2, false, 16);
+  auto frames = ExtractAll(little_endian, {0xFF, 0x02, 0x00, 'h', 'i'});
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_EQ(frames[0], std::string("hi"));
+
+  ASSERT_THROW(LengthPrefixFramer(3), std::invalid_argument);
+}
+
+TEST(FramerTest, cobsFramer) {
+  CobsFramer framer;
+  // Encoded {0x11, 0x22, 0x00, 0x33} and {0x00}.
+  std::vector<uint8_t> buffer = {0x03, 0x11, 0x22, 0x02, 0x33, 0x00,
+                                 0x01, 0x01, 0x00, 0x00};
+  auto frames = ExtractAll(framer, buffer);
+  ASSERT_EQ(frames.size(), 2);
+  EXPECT_EQ(frames[0], std::string("\x11\x22\x00\x33", 4));
+  EXPECT_EQ(frames[1], std::string("\x00", 1));
+
+  // A code pointing past the delimiter is a malformed frame.
+  frames = ExtractAll(framer, {0x05, 0x11, 0x00, 0x02, 0x44, 0x00});
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_EQ(frames[0], std::string("\x44"));
+
+  // A block of 254 non zero bytes is not followed by a zero.
+  std::vector<uint8_t> long_block(1, 0xFF);
+  for (int i = 1; i <= 254; ++i) {
+    long_block.push_back(static_cast<uint8_t>(i));
+  }
+  long_block.push_back(0x01);
+  long_block.push_back(0x00);
+  frames = ExtractAll(framer, long_block);
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_EQ(frames[0].size(), 254);
+
+  // A frame that is too long is discarded up to its delimiter.
+  CobsFramer small_framer(2);
+  frames =
+      ExtractAll(small_framer, {0x06, 1, 2, 3, 4, 5, 0x00, 0x02, 6, 0x00});
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_EQ(frames[0], std::string("\x06"));
+}
+
+TEST(FramerTest, slipFramer) {
+  SlipFramer framer;
+  std::vector<uint8_t> buffer = {'a', 0xDB, 0xDC, 'b', 0xDB, 0xDD, 0xC0,
+                                 0xC0, 'c', 0xDB, 'd', 0xC0, 'e', 0xC0};
+  auto frames = ExtractAll(framer, buffer);
+  ASSERT_EQ(frames.size(), 2);
+  EXPECT_EQ(frames[0], std::string("a\xC0" "b\xDB"));
+  EXPECT_EQ(frames[1], std::string("e"));
+}
+
+TEST(FramerTest, syncWordFramer) {
+  SyncWordFramer framer({0xAA, 0x55});
+  std::vector<uint8_t> buffer = {0x01, 0xAA, 0x02};
+  auto frame = SyncFrame("hello", false);
+  buffer.insert(buffer.end(), frame.begin(), frame.end());
+  auto corrupted = SyncFrame("world", false);
+  corrupted[5] ^= 0x01;
+  buffer.insert(buffer.end(), corrupted.begin(), corrupted.end());
+  frame = SyncFrame("", false);
+  buffer.insert(buffer.end(), frame.begin(), frame.end());
+
+  auto frames = ExtractAll(framer, buffer);
+  ASSERT_EQ(frames.size(), 2);
+  EXPECT_EQ(frames[0], std::string("hello"));
+  EXPECT_EQ(frames[1], std::string(""));
+  EXPECT_EQ(framer.GetCrcErrorCount(), 1);
+
+  SyncWordFramer crc32_framer({0xAA, 0x55}, SyncWordFramer::Crc::kCrc32);
+  frame = SyncFrame("hello", true);
+  FrameView view;
+  ASSERT_EQ(crc32_framer.Extract(frame.data(), frame.size() - 1, view), 0);
+  ASSERT_EQ(crc32_framer.Extract(frame.data(), frame.size(), view),
+            frame.size());
+  EXPECT_EQ(view.ToString(), std::string("hello"));
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
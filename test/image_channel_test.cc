@@ -0,0 +1,252 @@
+/**
+ * \file	image_channel_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <lib_atlas/io/image_channel.h>
+#include <lib_atlas/pattern/observer.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace atlas;
+
+namespace {
+
+/**
+ * A transport counting its publications instead of serializing them.
+ */
+class MockTransport : public RemoteImageTransport {
+ public:
+  size_t GetSubscriberCount() const override { return subscriber_count_; }
+
+  void Publish(const ChannelImage &image) override {
+    ++published_;
+    last_ = image.image;
+  }
+
+  std::atomic<size_t> subscriber_count_ = {0};
+
+  std::atomic<int> published_ = {0};
+
+  std::shared_ptr<const cv::Mat> last_;
+};
+
+class ImageReceiver : public Observer<const ChannelImage &> {
+ public:
+  std::atomic<int> count_ = {0};
+
+  std::shared_ptr<const cv::Mat> last_;
+
+  int64_t last_stamp_ns_ = {0};
+
+ protected:
+  auto OnSubjectNotify(Subject<const ChannelImage &> &subject,
+                       const ChannelImage &image) ATLAS_NOEXCEPT
+      -> void override {
+    last_ = image.image;
+    last_stamp_ns_ = image.stamp_ns;
+    ++count_;
+  }
+};
+
+std::shared_ptr<const cv::Mat> MakeImage() {
+  return std::make_shared<const cv::Mat>();
+}
+
+}  // namespace
+
+TEST(ImageChannelTest, channelsAreSharedByTopic) {
+  ImageChannel::Ptr camera = ImageChannel::Get("/camera");
+  ASSERT_EQ(camera, ImageChannel::Get("/camera"));
+  ASSERT_NE(camera, ImageChannel::Get("/sonar"));
+
+  // A channel nobody holds anymore is recreated.
+  std::weak_ptr<ImageChannel> previous = camera;
+  camera.reset();
+  ASSERT_TRUE(previous.expired());
+  ASSERT_NE(nullptr, ImageChannel::Get("/camera"));
+}
+
+TEST(ImageChannelTest, subscribersReceiveTheSharedImage) {
+  MockTransport transport;
+  ImageChannelPublisher publisher("/shared", transport);
+  ASSERT_TRUE(publisher.IsIntraProcess());
+  ASSERT_FALSE(publisher.HasIntraProcessSubscribers());
+
+  ImageReceiver first, second;
+  ImageChannel::Ptr channel = ImageChannel::Get("/shared");
+  channel->Attach(first);
+  channel->Attach(second);
+  ASSERT_TRUE(publisher.HasIntraProcessSubscribers());
+  // The transport also counts the two subscribers of the process.
+  channel->AddTransportSubscriber();
+  channel->AddTransportSubscriber();
+  transport.subscriber_count_ = 2;
+
+  auto image = MakeImage();
+  publisher.Publish(image, 42);
+  ASSERT_EQ(1, first.count_);
+  ASSERT_EQ(image, first.last_);
+  ASSERT_EQ(image, second.last_);
+  ASSERT_EQ(42, first.last_stamp_ns_);
+  ASSERT_EQ(0, transport.published_);
+  ASSERT_EQ(1u, publisher.GetStats().intra_process);
+  ASSERT_EQ(0u, publisher.GetStats().remote);
+  channel->RemoveTransportSubscriber();
+  channel->RemoveTransportSubscriber();
+  channel->Detach(first);
+  channel->Detach(second);
+}
+
+TEST(ImageChannelTest, remoteSubscribersUseTheTransport) {
+  MockTransport transport;
+  ImageChannelPublisher publisher("/remote", transport);
+
+  // No subscriber at all, nothing is published.
+  publisher.Publish(MakeImage(), 0);
+  ASSERT_EQ(0, transport.published_);
+
+  // Only remote subscribers.
+  transport.subscriber_count_ = 1;
+  publisher.Publish(MakeImage(), 0);
+  ASSERT_EQ(1, transport.published_);
+
+  // A local subscriber that is not subscribed through the transport does
+  // not hide the remote one.
+  ImageReceiver receiver;
+  ImageChannel::Ptr channel = ImageChannel::Get("/remote");
+  channel->Attach(receiver);
+  auto image = MakeImage();
+  publisher.Publish(image, 0);
+  ASSERT_EQ(2, transport.published_);
+  ASSERT_EQ(image, transport.last_);
+  ASSERT_EQ(image, receiver.last_);
+
+  // A local subscriber also subscribed through the transport, and a remote
+  // one.
+  channel->AddTransportSubscriber();
+  transport.subscriber_count_ = 2;
+  publisher.Publish(image, 0);
+  ASSERT_EQ(3, transport.published_);
+  ASSERT_EQ(2u, publisher.GetStats().intra_process);
+  ASSERT_EQ(3u, publisher.GetStats().remote);
+
+  // Only the local one.
+  transport.subscriber_count_ = 1;
+  publisher.Publish(image, 0);
+  ASSERT_EQ(3, transport.published_);
+  channel->RemoveTransportSubscriber();
+  channel->Detach(receiver);
+}
+
+TEST(ImageChannelTest, secondPublisherFallsBackToTheTransport) {
+  MockTransport transport;
+  transport.subscriber_count_ = 1;
+  ImageReceiver receiver;
+  ImageChannel::Ptr channel = ImageChannel::Get("/twice");
+  channel->Attach(receiver);
+
+  std::unique_ptr<ImageChannelPublisher> first(
+      new ImageChannelPublisher("/twice", transport));
+  ImageChannelPublisher second("/twice", transport);
+  ASSERT_TRUE(first->IsIntraProcess());
+  ASSERT_FALSE(second.IsIntraProcess());
+  ASSERT_FALSE(second.HasIntraProcessSubscribers());
+  ASSERT_TRUE(channel->HasPublisher());
+
+  // Only the images of the publisher of the channel are recognized, the
+  // subscribers receive those of the second one through the transport.
+  first->Publish(MakeImage(), 1);
+  second.Publish(MakeImage(), 2);
+  ASSERT_EQ(1, receiver.count_);
+  ASSERT_EQ(1, receiver.last_stamp_ns_);
+  ASSERT_EQ(2, transport.published_);
+  ASSERT_TRUE(channel->WasNotified(1));
+  ASSERT_FALSE(channel->WasNotified(2));
+
+  first.reset();
+  ASSERT_FALSE(channel->HasPublisher());
+  channel->Detach(receiver);
+}
+
+TEST(ImageChannelTest, onlyTheLatestStampsAreRemembered) {
+  MockTransport transport;
+  ImageChannelPublisher publisher("/stamps", transport);
+  ImageReceiver receiver;
+  ImageChannel::Ptr channel = ImageChannel::Get("/stamps");
+  ASSERT_FALSE(channel->WasNotified(0));
+
+  // Nothing is remembered while nobody receives the images.
+  publisher.Publish(MakeImage(), 0);
+  ASSERT_FALSE(channel->WasNotified(0));
+
+  channel->Attach(receiver);
+  const int64_t count = ImageChannel::kNotifiedStamps;
+  for (int64_t stamp = 1; stamp <= 2 * count; ++stamp) {
+    publisher.Publish(MakeImage(), stamp);
+  }
+  ASSERT_FALSE(channel->WasNotified(count));
+  ASSERT_TRUE(channel->WasNotified(count + 1));
+  ASSERT_TRUE(channel->WasNotified(2 * count));
+  channel->Detach(receiver);
+}
+
+TEST(ImageChannelTest, subscribersComeAndGoWhilePublishing) {
+  const int kImages = 20000;
+  MockTransport transport;
+  ImageChannelPublisher publisher("/busy", transport);
+  ImageReceiver steady;
+  ImageChannel::Get("/busy")->Attach(steady);
+  std::atomic<bool> done(false);
+
+  std::thread churn([&done]() {
+    ImageChannel::Ptr channel = ImageChannel::Get("/busy");
+    while (!done) {
+      ImageReceiver transient;
+      channel->Attach(transient);
+      channel->Detach(transient);
+    }
+  });
+
+  auto image = MakeImage();
+  for (int i = 0; i < kImages; ++i) {
+    publisher.Publish(image, i);
+  }
+  done = true;
+  churn.join();
+
+  ASSERT_EQ(kImages, steady.count_);
+  ASSERT_EQ(kImages - 1, steady.last_stamp_ns_);
+  // The receivers only share the image.
+  steady.last_.reset();
+  ASSERT_EQ(1, image.use_count());
+  ImageChannel::Get("/busy")->Detach(steady);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,108 @@
+/**
+ * \file	image_message_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <lib_atlas/ros/image_message.h>
+#include <boost/make_shared.hpp>
+#include <sensor_msgs/image_encodings.h>
+#include <stdexcept>
+#include <string>
+
+using namespace atlas;
+
+namespace enc = sensor_msgs::image_encodings;
+
+namespace {
+
+cv::Mat MakeImage(int rows, int cols) {
+  cv::Mat image(rows, cols, CV_8UC3);
+  cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+  return image;
+}
+
+bool IsEqual(const cv::Mat &lhs, const cv::Mat &rhs) {
+  return lhs.size() == rhs.size() && lhs.type() == rhs.type() &&
+         cv::countNonZero(lhs.reshape(1) != rhs.reshape(1)) == 0;
+}
+
+}  // namespace
+
+TEST(ImageMessageTest, fillReusesTheMessageData) {
+  cv::Mat image = MakeImage(48, 64);
+  sensor_msgs::Image message;
+  FillImageMessage(image, message);
+  ASSERT_EQ(enc::BGR8, message.encoding);
+  ASSERT_EQ(48u, message.height);
+  ASSERT_EQ(64u, message.width);
+  ASSERT_EQ(64u * 3, message.step);
+  const uint8_t *data = message.data.data();
+
+  image = MakeImage(48, 64);
+  FillImageMessage(image, message);
+  ASSERT_EQ(data, message.data.data());
+  cv::Mat wrapped(48, 64, CV_8UC3, message.data.data(), message.step);
+  ASSERT_TRUE(IsEqual(image, wrapped));
+}
+
+TEST(ImageMessageTest, fillCopiesTheRowsOfARegion) {
+  cv::Mat image = MakeImage(48, 64);
+  cv::Mat region = image(cv::Rect(8, 4, 32, 16));
+  ASSERT_FALSE(region.isContinuous());
+  sensor_msgs::Image message;
+  FillImageMessage(region, message);
+  ASSERT_EQ(32u * 3, message.step);
+  cv::Mat wrapped(16, 32, CV_8UC3, message.data.data(), message.step);
+  ASSERT_TRUE(IsEqual(region, wrapped));
+}
+
+TEST(ImageMessageTest, fillRejectsUnsupportedTypes) {
+  sensor_msgs::Image message;
+  ASSERT_THROW(FillImageMessage(cv::Mat(4, 4, CV_32FC3), message),
+               std::invalid_argument);
+}
+
+TEST(ImageMessageTest, convertIntoARecycledBuffer) {
+  cv::Mat image = MakeImage(48, 64);
+  auto message = boost::make_shared<sensor_msgs::Image>();
+  FillImageMessage(image, *message);
+
+  cv::Mat bgr;
+  ConvertImageMessage(message, bgr);
+  ASSERT_TRUE(IsEqual(image, bgr));
+  const uint8_t *data = bgr.data;
+
+  cv::Mat rgb;
+  cv::cvtColor(image, rgb, cv::COLOR_BGR2RGB);
+  FillImageMessage(rgb, *message);
+  message->encoding = enc::RGB8;
+  ConvertImageMessage(message, bgr);
+  ASSERT_EQ(data, bgr.data);
+  ASSERT_TRUE(IsEqual(image, bgr));
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,215 @@
+/**
+ * \file	image_sequence_capture_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <lib_atlas/io/image_sequence_capture.h>
+#include <lib_atlas/pattern/observer.h>
+#include <lib_atlas/sys/timer.h>
+#include <atomic>
+#include <memory>
+
+using namespace atlas;
+
+namespace {
+
+/**
+ * Counts the threads calling GetNextImage at the same time.
+ */
+class CountingCapture : public ImageSequenceCapture {
+ public:
+  ~CountingCapture() ATLAS_NOEXCEPT { Stop(); }
+
+  mutable std::atomic<int> concurrent_calls_ = {0};
+
+  mutable std::atomic<int> max_concurrent_calls_ = {0};
+
+ protected:
+  const cv::Mat &GetNextImage() const override {
+    int calls = ++concurrent_calls_;
+    if (calls > max_concurrent_calls_) {
+      max_concurrent_calls_ = calls;
+    }
+    MilliTimer::Sleep(1);
+    --concurrent_calls_;
+    return image_;
+  }
+
+ private:
+  cv::Mat image_;
+};
+
+/**
+ * Stops the capture from its first notification, and optionally starts it
+ * again.
+ */
+class StoppingObserver : public Observer<cv::Mat> {
+ public:
+  StoppingObserver(ImageSequenceCapture &capture, bool restart)
+      : capture_(capture), restart_(restart) {}
+
+  std::atomic<int> count_ = {0};
+
+  std::atomic<bool> stopped_ = {false};
+
+ protected:
+  auto OnSubjectNotify(Subject<cv::Mat> &subject, cv::Mat image)
+      ATLAS_NOEXCEPT -> void override {
+    ++count_;
+    if (!stopped_) {
+      capture_.Stop();
+      if (restart_) {
+        capture_.Start();
+      }
+      stopped_ = true;
+      // Leave time to the test to start or destroy the capture while the
+      // streaming thread is still in the notification.
+      MilliTimer::Sleep(20);
+    }
+  }
+
+ private:
+  ImageSequenceCapture &capture_;
+
+  bool restart_;
+};
+
+/**
+ * Writes the number of the frame in the single pixel of its image, reusing
+ * the same buffer for every frame.
+ */
+class OverwritingCapture : public ImageSequenceCapture {
+ public:
+  OverwritingCapture() : image_(cv::Mat::zeros(1, 1, CV_8UC1)) {}
+
+  ~OverwritingCapture() ATLAS_NOEXCEPT { Stop(); }
+
+ protected:
+  const cv::Mat &GetNextImage() const override {
+    ++image_.at<uchar>(0, 0);
+    return image_;
+  }
+
+ private:
+  mutable cv::Mat image_;
+};
+
+/**
+ * Checks that the images it receives do not change after the notification.
+ */
+class SlowObserver : public Observer<cv::Mat> {
+ public:
+  ~SlowObserver() ATLAS_NOEXCEPT { DetachFromAllSubject(); }
+
+  std::atomic<int> count_ = {0};
+
+  std::atomic<int> changed_ = {0};
+
+ protected:
+  auto OnSubjectNotify(Subject<cv::Mat> &subject, cv::Mat image)
+      ATLAS_NOEXCEPT -> void override {
+    uchar value = image.at<uchar>(0, 0);
+    MilliTimer::Sleep(5);
+    if (image.at<uchar>(0, 0) != value) {
+      ++changed_;
+    }
+    ++count_;
+  }
+};
+
+void WaitFor(const std::atomic<bool> &flag) {
+  while (!flag) {
+    MilliTimer::Sleep(1);
+  }
+}
+
+}  // namespace
+
+TEST(ImageSequenceCaptureTest, startAfterAStopFromAnObserver) {
+  CountingCapture capture;
+  StoppingObserver observer(capture, false);
+  capture.Attach(observer);
+  capture.SetStreamingMode(true);
+  capture.Start();
+  WaitFor(observer.stopped_);
+  ASSERT_FALSE(capture.IsRunning());
+
+  // The previous thread is joined, a single thread streams.
+  capture.Start();
+  MilliTimer::Sleep(50);
+  capture.Stop();
+  ASSERT_GT(observer.count_, 1);
+  ASSERT_EQ(1, capture.max_concurrent_calls_);
+  capture.Detach(observer);
+}
+
+TEST(ImageSequenceCaptureTest, startFromTheObserverThatStopped) {
+  CountingCapture capture;
+  StoppingObserver observer(capture, true);
+  capture.Attach(observer);
+  capture.SetStreamingMode(true);
+  capture.Start();
+  WaitFor(observer.stopped_);
+  ASSERT_TRUE(capture.IsRunning());
+
+  MilliTimer::Sleep(50);
+  capture.Stop();
+  ASSERT_GT(observer.count_, 1);
+  ASSERT_EQ(1, capture.max_concurrent_calls_);
+  capture.Detach(observer);
+}
+
+TEST(ImageSequenceCaptureTest, destroyAfterAStopFromAnObserver) {
+  for (int i = 0; i < 20; ++i) {
+    std::unique_ptr<CountingCapture> capture(new CountingCapture);
+    StoppingObserver observer(*capture, false);
+    capture->Attach(observer);
+    capture->SetStreamingMode(true);
+    capture->Start();
+    WaitFor(observer.stopped_);
+    // The destructor joins the thread still returning from the
+    // notification.
+    capture.reset();
+  }
+}
+
+TEST(ImageSequenceCaptureTest, queuedObserversKeepTheirImage) {
+  OverwritingCapture capture;
+  SlowObserver observer;
+  observer.SetQueuedDelivery(MailboxOptions());
+  capture.Attach(observer);
+  capture.SetStreamingMode(true);
+  capture.Start();
+  while (observer.count_ < 10) {
+    MilliTimer::Sleep(1);
+  }
+  capture.Stop();
+  capture.Detach(observer);
+  ASSERT_EQ(0, observer.changed_);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,126 @@
+/**
+ * \file	instrumented_lock_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <lib_atlas/sys/instrumented_lock.h>
+#include <lib_atlas/sys/timer.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace atlas;
+
+namespace {
+
+const int kThreadCount = 4;
+const int kIterations = 100000;
+
+// Increment a counter that is protected by the lock from several threads.
+// Returns the time in nanoseconds per lock/unlock pair.
+double Hammer(InstrumentedLock &lock, int thread_count, int64_t &counter) {
+  std::vector<std::thread> threads;
+  NanoTimer timer;
+  timer.Start();
+  for (int t = 0; t < thread_count; ++t) {
+    threads.emplace_back([&lock, &counter] {
+      for (int i = 0; i < kIterations; ++i) {
+        lock.Lock();
+        ++counter;
+        lock.Unlock();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return static_cast<double>(timer.NanoSeconds()) /
+         (thread_count * kIterations);
+}
+
+TEST(InstrumentedLockTest, mutualExclusion) {
+  for (auto policy : {LockPolicy::kMutex, LockPolicy::kSpinThenPark}) {
+    InstrumentedLock lock(policy);
+    int64_t counter = 0;
+    Hammer(lock, kThreadCount, counter);
+    ASSERT_EQ(counter, kThreadCount * kIterations);
+
+    LockStats stats = lock.GetStats();
+    EXPECT_EQ(stats.acquisitions,
+              static_cast<uint64_t>(kThreadCount * kIterations));
+    EXPECT_LE(stats.contentions, stats.acquisitions);
+    EXPECT_GE(stats.total_wait_ns, stats.max_wait_ns);
+    EXPECT_GE(stats.total_hold_ns, stats.max_hold_ns);
+  }
+}
+
+TEST(InstrumentedLockTest, contentionIsMeasured) {
+  for (auto policy : {LockPolicy::kMutex, LockPolicy::kSpinThenPark}) {
+    InstrumentedLock lock(policy);
+    lock.Lock();
+    std::atomic<bool> started = {false};
+    std::thread waiter([&lock, &started] {
+      started = true;
+      lock.Lock();
+      lock.Unlock();
+    });
+    while (!started) {
+      std::this_thread::yield();
+    }
+    // The lock is only released once the waiter is blocked on it.
+    while (lock.GetWaiterCount() == 0) {
+      std::this_thread::yield();
+    }
+    lock.Unlock();
+    waiter.join();
+
+    LockStats stats = lock.GetStats();
+    EXPECT_EQ(stats.acquisitions, 2);
+    EXPECT_EQ(stats.contentions, 1);
+    EXPECT_GT(stats.max_wait_ns, 0);
+    EXPECT_GT(stats.max_hold_ns, 0);
+    EXPECT_EQ(lock.GetWaiterCount(), 0);
+
+    lock.ResetStats();
+    EXPECT_EQ(lock.GetStats().acquisitions, 0);
+  }
+}
+
+TEST(InstrumentedLockTest, noLockPolicy) {
+  InstrumentedLock lock(LockPolicy::kNone);
+  lock.Lock();
+  lock.Lock();
+  lock.Unlock();
+  lock.Unlock();
+  EXPECT_EQ(lock.GetStats().acquisitions, 0);
+  EXPECT_EQ(lock.GetPolicy(), LockPolicy::kNone);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,302 @@
+/**
+ * \file	mailbox_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <lib_atlas/pattern/mailbox.h>
+#include <lib_atlas/pattern/thread_pool.h>
+#include <lib_atlas/sys/timer.h>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace atlas;
+
+namespace {
+
+/**
+ * Records the items it receives. Once closed, the handler blocks on the next
+ * item until Open is called.
+ */
+class Recorder {
+ public:
+  Mailbox<int>::Handler GetHandler() {
+    return [this](int &item) {
+      if (!is_open_) {
+        is_waiting_ = true;
+        while (!is_open_) {
+          std::this_thread::yield();
+        }
+      }
+      std::lock_guard<std::mutex> lock(mutex_);
+      items_.push_back(item);
+    };
+  }
+
+  void Close() { is_open_ = false; }
+
+  void Open() { is_open_ = true; }
+
+  void WaitUntilBlocked() {
+    while (!is_waiting_) {
+      std::this_thread::yield();
+    }
+  }
+
+  std::vector<int> GetItems() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return items_;
+  }
+
+ private:
+  std::atomic<bool> is_open_ = {true};
+  std::atomic<bool> is_waiting_ = {false};
+  std::mutex mutex_;
+  std::vector<int> items_;
+};
+
+/**
+ * Push 0 and wait for the handler to block on it, then push 1 to count.
+ */
+void FillBlocked(Mailbox<int> &mailbox, Recorder &recorder, int count) {
+  recorder.Close();
+  mailbox.Push(0);
+  recorder.WaitUntilBlocked();
+  for (int i = 1; i <= count; ++i) {
+    mailbox.Push(std::move(i));
+  }
+}
+
+}  // namespace
+
+TEST(MailboxTest, deliversInOrderOnItsThread) {
+  Recorder recorder;
+  std::atomic<bool> is_other_thread = {true};
+  std::thread::id caller = std::this_thread::get_id();
+  auto handler = recorder.GetHandler();
+  MailboxOptions options;
+  options.capacity = 128;
+  Mailbox<int> mailbox(options, [&](int &item) {
+    is_other_thread = is_other_thread && std::this_thread::get_id() != caller;
+    handler(item);
+  });
+
+  std::vector<int> expected;
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(mailbox.Push(std::move(i)));
+    expected.push_back(i);
+  }
+  mailbox.Stop(true);
+
+  ASSERT_EQ(recorder.GetItems(), expected);
+  ASSERT_TRUE(is_other_thread);
+  MailboxStats stats = mailbox.GetStats();
+  ASSERT_EQ(stats.depth, 0);
+  ASSERT_EQ(stats.delivered, 100);
+  ASSERT_EQ(stats.dropped, 0);
+}
+
+TEST(MailboxTest, dropOldest) {
+  Recorder recorder;
+  MailboxOptions options;
+  options.capacity = 4;
+  options.overflow = OverflowPolicy::kDropOldest;
+  Mailbox<int> mailbox(options, recorder.GetHandler());
+
+  FillBlocked(mailbox, recorder, 6);
+  MailboxStats stats = mailbox.GetStats();
+  ASSERT_EQ(stats.depth, 4);
+  ASSERT_EQ(stats.max_depth, 4);
+  ASSERT_EQ(stats.dropped, 2);
+
+  recorder.Open();
+  mailbox.Stop(true);
+  ASSERT_EQ(recorder.GetItems(), std::vector<int>({0, 3, 4, 5, 6}));
+}
+
+TEST(MailboxTest, dropNewest) {
+  Recorder recorder;
+  MailboxOptions options;
+  options.capacity = 4;
+  options.overflow = OverflowPolicy::kDropNewest;
+  Mailbox<int> mailbox(options, recorder.GetHandler());
+
+  FillBlocked(mailbox, recorder, 6);
+  ASSERT_EQ(mailbox.GetStats().dropped, 2);
+
+  recorder.Open();
+  mailbox.Stop(true);
+  ASSERT_EQ(recorder.GetItems(), std::vector<int>({0, 1, 2, 3, 4}));
+}
+
+TEST(MailboxTest, blockUntilTheHandlerTakesAnItem) {
+  Recorder recorder;
+  MailboxOptions options;
+  options.capacity = 1;
+  options.overflow = OverflowPolicy::kBlock;
+  Mailbox<int> mailbox(options, recorder.GetHandler());
+
+  FillBlocked(mailbox, recorder, 1);
+  std::atomic<bool> is_pushed = {false};
+  std::thread pusher([&]() {
+    mailbox.Push(2);
+    is_pushed = true;
+  });
+  MilliTimer::Sleep(20);
+  ASSERT_FALSE(is_pushed);
+
+  recorder.Open();
+  pusher.join();
+  mailbox.Stop(true);
+  ASSERT_EQ(recorder.GetItems(), std::vector<int>({0, 1, 2}));
+  ASSERT_EQ(mailbox.GetStats().dropped, 0);
+}
+
+TEST(MailboxTest, drainedOnThreadPool) {
+  ThreadPool pool(2);
+  std::atomic<int> concurrent = {0};
+  std::atomic<bool> is_serialized = {true};
+  std::vector<int> items;
+  MailboxOptions options;
+  options.capacity = 1024;
+  Mailbox<int> mailbox(options, pool, [&](int &item) {
+    if (concurrent.fetch_add(1) != 0) {
+      is_serialized = false;
+    }
+    items.push_back(item);
+    concurrent.fetch_sub(1);
+  });
+
+  std::vector<int> expected;
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(mailbox.Push(std::move(i)));
+    expected.push_back(i);
+  }
+  mailbox.Stop(true);
+
+  ASSERT_TRUE(is_serialized);
+  ASSERT_EQ(items, expected);
+  ASSERT_EQ(mailbox.GetStats().delivered, 1000);
+}
+
+TEST(MailboxTest, stopDiscardsThePendingItems) {
+  Recorder recorder;
+  MailboxOptions options;
+  options.capacity = 8;
+  Mailbox<int> mailbox(options, recorder.GetHandler());
+
+  FillBlocked(mailbox, recorder, 3);
+  std::thread stopper([&]() { mailbox.Stop(false); });
+  while (!mailbox.IsStopped()) {
+    std::this_thread::yield();
+  }
+  ASSERT_FALSE(mailbox.Push(4));
+  recorder.Open();
+  stopper.join();
+
+  ASSERT_EQ(recorder.GetItems(), std::vector<int>({0}));
+  MailboxStats stats = mailbox.GetStats();
+  ASSERT_EQ(stats.depth, 0);
+  ASSERT_EQ(stats.delivered, 1);
+  ASSERT_EQ(stats.dropped, 3);
+}
+
+TEST(MailboxTest, discardWaitsForTheHandler) {
+  Recorder recorder;
+  MailboxOptions options;
+  options.capacity = 8;
+  Mailbox<int> mailbox(options, recorder.GetHandler());
+
+  FillBlocked(mailbox, recorder, 4);
+  std::atomic<size_t> discarded = {0};
+  std::atomic<bool> is_done = {false};
+  std::thread discarder([&]() {
+    discarded = mailbox.Discard([](const int &item) { return item % 2 == 1; });
+    is_done = true;
+  });
+  while (mailbox.GetStats().depth != 2) {
+    std::this_thread::yield();
+  }
+  MilliTimer::Sleep(10);
+  ASSERT_FALSE(is_done);
+  recorder.Open();
+  discarder.join();
+  mailbox.Stop(true);
+
+  ASSERT_EQ(discarded, 2);
+  ASSERT_EQ(recorder.GetItems(), std::vector<int>({0, 2, 4}));
+  ASSERT_EQ(mailbox.GetStats().dropped, 2);
+}
+
+TEST(MailboxTest, discardFromTheHandlerDoesNotWait) {
+  Mailbox<int> *self = nullptr;
+  std::vector<int> items;
+  MailboxOptions options;
+  options.capacity = 8;
+  ThreadPool pool(1);
+  Mailbox<int> mailbox(options, pool, [&](int &item) {
+    items.push_back(item);
+    self->Discard([](const int &) { return true; });
+  });
+  self = &mailbox;
+
+  ASSERT_TRUE(mailbox.Push(1));
+  mailbox.Stop(true);
+  ASSERT_EQ(items, std::vector<int>({1}));
+}
+
+TEST(MailboxTest, stopRethrowsTheErrorOfTheHandler) {
+  ThreadPool pool(1);
+  std::vector<int> items;
+  MailboxOptions options;
+  options.capacity = 8;
+  Mailbox<int> mailbox(options, pool, [&](int &item) {
+    items.push_back(item);
+    if (item == 1) {
+      throw std::runtime_error("handler error");
+    }
+  });
+
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(mailbox.Push(std::move(i)));
+  }
+  // The draining task has ended despite the error, Stop does not hang.
+  ASSERT_THROW(mailbox.Stop(true), std::runtime_error);
+  ASSERT_EQ(items, std::vector<int>({0, 1, 2}));
+  ASSERT_EQ(mailbox.GetStats().delivered, 3);
+  mailbox.Stop(true);
+}
+
+TEST(MailboxTest, zeroCapacityThrows) {
+  MailboxOptions options;
+  options.capacity = 0;
+  ASSERT_THROW(Mailbox<int>(options, [](int &) {}), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -24,8 +24,15 @@
  */
 
 #include "gtest/gtest.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
 #include <lib_atlas/pattern/observer.h>
+#include <lib_atlas/pattern/shared_payload.h>
 #include <lib_atlas/pattern/subject.h>
+#include <lib_atlas/pattern/thread_pool.h>
+#include <lib_atlas/sys/timer.h>
 
 class ConcreateObserver : public atlas::Observer<const std::string &, int> {
  public:
@@ -46,6 +53,118 @@ class ConcreteSubject : public atlas::Subject<const std::string &, int> {
   void DoSomething(std::string s, int i) { Notify(s, i); }
 };
 
+class CountingObserver : public atlas::Observer<int> {
+ public:
+  std::atomic<int> count_ = {0};
+
+ protected:
+  auto OnSubjectNotify(atlas::Subject<int> &subject,
+                       int nb) ATLAS_NOEXCEPT -> void override {
+    count_.fetch_add(nb);
+  }
+};
+
+/**
+ * Counts the copies and the moves of its instances.
+ */
+struct Tracked {
+  static std::atomic<int> copies;
+  static std::atomic<int> moves;
+
+  Tracked() = default;
+  Tracked(const Tracked &) { ++copies; }
+  Tracked(Tracked &&) { ++moves; }
+  Tracked &operator=(const Tracked &) {
+    ++copies;
+    return *this;
+  }
+  Tracked &operator=(Tracked &&) {
+    ++moves;
+    return *this;
+  }
+
+  static void Reset() {
+    copies = 0;
+    moves = 0;
+  }
+};
+
+std::atomic<int> Tracked::copies = {0};
+std::atomic<int> Tracked::moves = {0};
+
+class TrackedObserver : public atlas::Observer<Tracked> {
+ public:
+  std::atomic<int> count_ = {0};
+
+ protected:
+  auto OnSubjectNotify(atlas::Subject<Tracked> &subject,
+                       Tracked value) ATLAS_NOEXCEPT -> void override {
+    ++count_;
+  }
+};
+
+using Payload = atlas::SharedPayload<std::vector<int>>;
+
+class PayloadObserver : public atlas::Observer<const Payload &> {
+ public:
+  std::atomic<const std::vector<int> *> value_ = {nullptr};
+
+ protected:
+  auto OnSubjectNotify(atlas::Subject<const Payload &> &subject,
+                       const Payload &payload) ATLAS_NOEXCEPT -> void override {
+    value_ = &payload.Get();
+  }
+};
+
+class SelfDetachingObserver : public atlas::Observer<int> {
+ public:
+  int count_ = {0};
+
+ protected:
+  auto OnSubjectNotify(atlas::Subject<int> &subject,
+                       int nb) ATLAS_NOEXCEPT -> void override {
+    ++count_;
+    subject.Detach(*this);
+  }
+};
+
+/**
+ * Counts its notifications in a counter that outlives it, each one taking
+ * 10ms, and reads the subject it is notified by.
+ */
+class SlowCountingObserver : public atlas::Observer<int> {
+ public:
+  explicit SlowCountingObserver(std::atomic<int> &count) : count_(count) {}
+
+  ~SlowCountingObserver() { DetachFromAllSubject(); }
+
+ protected:
+  auto OnSubjectNotify(atlas::Subject<int> &subject,
+                       int nb) ATLAS_NOEXCEPT -> void override {
+    atlas::MilliTimer::Sleep(10);
+    if (subject.ObserverCount() > 0) {
+      count_.fetch_add(1);
+    }
+  }
+
+ private:
+  std::atomic<int> &count_;
+};
+
+class SlowObserver : public atlas::Observer<int> {
+ public:
+  std::atomic<bool> entered_ = {false};
+  std::atomic<bool> left_ = {false};
+
+ protected:
+  auto OnSubjectNotify(atlas::Subject<int> &subject,
+                       int nb) ATLAS_NOEXCEPT -> void override {
+    entered_ = true;
+    atlas::MilliTimer::Sleep(50);
+    left_ = true;
+  }
+};
+
 TEST(Observer, attachToSubject) {
   ConcreteSubject subject = {};
   ConcreateObserver observer = {};
@@ -107,6 +226,208 @@ TEST(Observer, notify) {
   ASSERT_TRUE(observer.i_ == 42);
 }
 
+TEST(Observer, notifyWhileAttachingAndDetaching) {
+  const int kNotifications = 20000;
+  atlas::Subject<int> subject;
+  CountingObserver stable;
+  subject.Attach(stable);
+
+  std::atomic<bool> done = {false};
+  std::thread churn([&subject, &done]() {
+    while (!done) {
+      CountingObserver transient;
+      subject.Attach(transient);
+      subject.Detach(transient);
+    }
+  });
+
+  for (int i = 0; i < kNotifications; ++i) {
+    subject.Notify(1);
+  }
+  done = true;
+  churn.join();
+
+  ASSERT_EQ(stable.count_, kNotifications);
+  ASSERT_EQ(subject.ObserverCount(), 1);
+}
+
+TEST(Observer, detachFromNotification) {
+  atlas::Subject<int> subject;
+  SelfDetachingObserver leaving;
+  CountingObserver staying;
+  subject.Attach(leaving);
+  subject.Attach(staying);
+
+  subject.Notify(1);
+  subject.Notify(1);
+  ASSERT_EQ(leaving.count_, 1);
+  ASSERT_FALSE(leaving.IsAttached(subject));
+  ASSERT_EQ(staying.count_, 2);
+  ASSERT_EQ(subject.ObserverCount(), 1);
+}
+
+TEST(Observer, detachWaitsForRunningNotification) {
+  atlas::Subject<int> subject;
+  SlowObserver observer;
+  subject.Attach(observer);
+
+  std::thread notifier([&subject]() { subject.Notify(1); });
+  while (!observer.entered_) {
+    std::this_thread::yield();
+  }
+  subject.Detach(observer);
+  ASSERT_TRUE(observer.left_);
+  notifier.join();
+}
+
+TEST(Observer, queuedDeliveryDoesNotBlockTheSubject) {
+  atlas::Subject<int> subject;
+  SlowObserver observer;
+  atlas::MailboxOptions options;
+  options.capacity = 2;
+  options.overflow = atlas::OverflowPolicy::kDropOldest;
+  observer.SetQueuedDelivery(options);
+  ASSERT_TRUE(observer.IsQueued());
+  subject.Attach(observer);
+
+  int64_t start = atlas::NanoTimer::Now();
+  for (int i = 0; i < 5; ++i) {
+    subject.Notify(i);
+  }
+  // Each synchronous notification would take 50ms.
+  ASSERT_LT(atlas::NanoTimer::Now() - start, 50000000);
+
+  observer.StopQueuedDelivery();
+  ASSERT_FALSE(observer.IsQueued());
+  atlas::MailboxStats stats = observer.GetDeliveryStats();
+  ASSERT_EQ(stats.delivered + stats.dropped, 5);
+  ASSERT_GE(stats.dropped, 2);
+  ASSERT_EQ(stats.max_depth, 2);
+}
+
+TEST(Observer, queuedObserverCanBeDestroyedOnceDetached) {
+  atlas::Subject<int> subject;
+  std::atomic<int> count = {0};
+  std::unique_ptr<SlowCountingObserver> observer(
+      new SlowCountingObserver(count));
+  observer->SetQueuedDelivery(atlas::MailboxOptions());
+  subject.Attach(*observer);
+
+  for (int i = 0; i < 10; ++i) {
+    subject.Notify(1);
+  }
+  subject.Detach(*observer);
+  int delivered = count;
+  ASSERT_LT(delivered, 10);
+  ASSERT_EQ(observer->GetDeliveryStats().delivered +
+                observer->GetDeliveryStats().dropped,
+            10);
+  observer.reset();
+
+  // Nothing is delivered once Detach returned, even to a destroyed observer.
+  atlas::MilliTimer::Sleep(50);
+  ASSERT_EQ(count, delivered);
+}
+
+TEST(Observer, queuedNotificationsOfADestroyedSubjectAreDiscarded) {
+  atlas::ThreadPool pool(1);
+  std::atomic<int> count = {0};
+  SlowCountingObserver observer(count);
+  observer.SetQueuedDelivery(atlas::MailboxOptions(), pool);
+  std::unique_ptr<atlas::Subject<int>> subject(new atlas::Subject<int>());
+  subject->Attach(observer);
+
+  for (int i = 0; i < 10; ++i) {
+    subject->Notify(1);
+  }
+  // The pending notifications would use the subject once it is destroyed.
+  subject.reset();
+  ASSERT_EQ(observer.GetDeliveryStats().depth, 0);
+  observer.StopQueuedDelivery();
+  ASSERT_LT(count, 10);
+}
+
+TEST(Observer, queuedDeliveryCopiesTheArguments) {
+  ConcreteSubject subject;
+  ConcreateObserver observer;
+  atlas::ThreadPool pool(1);
+  observer.SetQueuedDelivery(atlas::MailboxOptions(), pool);
+  observer.Observe(subject);
+
+  for (int i = 0; i < 10; ++i) {
+    subject.DoSomething(std::string("notification ") + std::to_string(i), i);
+  }
+  observer.StopQueuedDelivery();
+  ASSERT_EQ(observer.s_, "notification 9");
+  ASSERT_EQ(observer.i_, 9);
+  ASSERT_EQ(observer.GetDeliveryStats().delivered, 10);
+
+  // Once stopped, the notifications are synchronous again.
+  subject.DoSomething("synchronous", 42);
+  ASSERT_EQ(observer.s_, "synchronous");
+}
+
+TEST(Observer, deliveryModeCannotChangeWhileAttached) {
+  atlas::Subject<int> subject;
+  CountingObserver observer;
+  subject.Attach(observer);
+  ASSERT_THROW(observer.SetQueuedDelivery(atlas::MailboxOptions()),
+               std::logic_error);
+  subject.Detach(observer);
+  observer.SetQueuedDelivery(atlas::MailboxOptions());
+  ASSERT_TRUE(observer.IsQueued());
+}
+
+TEST(Observer, lastObserverReceivesAnRvalue) {
+  atlas::Subject<Tracked> subject;
+  TrackedObserver observers[3];
+  for (auto &observer : observers) {
+    subject.Attach(observer);
+  }
+
+  Tracked::Reset();
+  subject.Notify(Tracked());
+  ASSERT_EQ(Tracked::copies, 2);
+  ASSERT_EQ(Tracked::moves, 1);
+  for (auto &observer : observers) {
+    ASSERT_EQ(observer.count_, 1);
+  }
+}
+
+TEST(Observer, queuedObserverMovesTheArguments) {
+  atlas::Subject<Tracked> subject;
+  TrackedObserver observer;
+  observer.SetQueuedDelivery(atlas::MailboxOptions());
+  subject.Attach(observer);
+
+  Tracked::Reset();
+  subject.Notify(Tracked());
+  observer.StopQueuedDelivery();
+  ASSERT_EQ(observer.count_, 1);
+  ASSERT_EQ(Tracked::copies, 0);
+}
+
+TEST(Observer, sharedPayloadIsNotCopied) {
+  atlas::Subject<const Payload &> subject;
+  PayloadObserver observers[4];
+  observers[0].SetQueuedDelivery(atlas::MailboxOptions());
+  for (auto &observer : observers) {
+    subject.Attach(observer);
+  }
+
+  Payload payload = atlas::MakeSharedPayload<std::vector<int>>(1000000, 42);
+  subject.Notify(payload);
+  observers[0].StopQueuedDelivery();
+  for (auto &observer : observers) {
+    ASSERT_EQ(observer.value_, &payload.Get());
+  }
+  // The copy held by the mailbox has been released.
+  ASSERT_EQ(payload.UseCount(), 1);
+
+  ASSERT_TRUE(Payload().IsEmpty());
+  ASSERT_THROW(Payload().Get(), std::logic_error);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
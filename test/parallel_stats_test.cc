@@ -0,0 +1,59 @@
+/**
+ * \file	parallel_stats_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+#include <lib_atlas/maths/parallel_stats.h>
+#include <cstdint>
+#include <vector>
+
+TEST(ParallelStatsTest, matchTheSequentialReductions) {
+  std::vector<int64_t> large(200000);
+  std::vector<double> other(large.size());
+  for (size_t i = 0; i < large.size(); ++i) {
+    large[i] = static_cast<int64_t>((i * 7919) % 1000);
+    other[i] = static_cast<double>((i * 104729) % 997) / 10.;
+  }
+  std::vector<double> large_double(large.begin(), large.end());
+  std::vector<int> small = {828, 522, 832, 71, 609, 787, 179, 756};
+
+  for (auto scheduling : {atlas::ThreadPool::Scheduling::kSharedQueue,
+                          atlas::ThreadPool::Scheduling::kWorkStealing}) {
+    atlas::ThreadPool pool(4, scheduling);
+    ASSERT_EQ(atlas::Mean(large, pool), atlas::Mean(large));
+    ASSERT_EQ(atlas::Min(large, pool), atlas::Min(large));
+    ASSERT_EQ(atlas::Max(large, pool), atlas::Max(large));
+    ASSERT_EQ(atlas::Euclidean(large, large, pool), 0.);
+    ASSERT_NEAR(atlas::Covariance(large_double, other, pool),
+                atlas::Covariance(large_double, other), 1e-6);
+    ASSERT_NEAR(atlas::StdDeviation(other, pool), atlas::StdDeviation(other),
+                1e-9);
+    // Smaller than a chunk, computed by the calling thread alone.
+    ASSERT_EQ(atlas::Mean(small, pool), atlas::Mean(small));
+  }
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
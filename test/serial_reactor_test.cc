@@ -0,0 +1,262 @@
+/**
+ * \file	serial_reactor_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <lib_atlas/io/serial_reactor.h>
+#include <lib_atlas/sys/timer.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(OS_LINUX)
+#include <pty.h>
+#else
+#include <util.h>
+#endif
+
+using namespace atlas;
+
+namespace {
+
+const size_t kPortCount = 3;
+
+class SerialReactorTests : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    for (size_t i = 0; i < kPortCount; ++i) {
+      int master_fd, slave_fd;
+      char name[100];
+      ASSERT_NE(openpty(&master_fd, &slave_fd, name, NULL, NULL), -1);
+      master_fds.push_back(master_fd);
+      slave_fds.push_back(slave_fd);
+      ports.push_back(std::unique_ptr<Serial>(new Serial(
+          std::string(name), 115200, Timeout::SimpleTimeout(250))));
+    }
+  }
+
+  virtual void TearDown() {
+    for (size_t i = 0; i < kPortCount; ++i) {
+      ports[i]->Close();
+      if (master_fds[i] != -1) {
+        close(master_fds[i]);
+      }
+      close(slave_fds[i]);
+    }
+  }
+
+  // Poll the reactor until the predicate is true or a second has elapsed.
+  template <class Tp_>
+  bool PollUntil(SerialReactor &reactor, Tp_ predicate) {
+    MilliTimer timer;
+    timer.Start();
+    while (!predicate() && timer.MilliSeconds() < 1000) {
+      reactor.Poll(10);
+    }
+    return predicate();
+  }
+
+  std::vector<std::unique_ptr<Serial>> ports;
+  std::vector<int> master_fds;
+  std::vector<int> slave_fds;
+};
+
+TEST_F(SerialReactorTests, registerPorts) {
+  SerialReactor reactor;
+  for (auto &port : ports) {
+    reactor.Register(*port, [](Serial &) {});
+  }
+  ASSERT_EQ(reactor.PortCount(), kPortCount);
+  ASSERT_THROW(reactor.Register(*ports[0], [](Serial &) {}),
+               std::invalid_argument);
+
+  reactor.Unregister(*ports[0]);
+  ASSERT_EQ(reactor.PortCount(), kPortCount - 1);
+  ASSERT_THROW(reactor.Unregister(*ports[0]), std::invalid_argument);
+
+  Serial closed_port;
+  ASSERT_THROW(reactor.Register(closed_port, [](Serial &) {}),
+               PortNotOpenedException);
+}
+
+TEST_F(SerialReactorTests, dispatchLinesOfManyPorts) {
+  SerialReactor reactor;
+  std::vector<std::vector<std::string>> lines(kPortCount);
+  for (size_t i = 0; i < kPortCount; ++i) {
+    reactor.RegisterLineHandler(
+        *ports[i],
+        [&lines, i](Serial &, const std::string &line) {
+          lines[i].push_back(line);
+        },
+        "\r\n");
+  }
+
+  for (size_t i = 0; i < kPortCount; ++i) {
+    write(master_fds[i], "$A,1*00\r\n$B,", 12);
+  }
+  ASSERT_TRUE(PollUntil(reactor, [&] {
+    for (auto &port_lines : lines) {
+      if (port_lines.size() != 1) return false;
+    }
+    return true;
+  }));
+  for (size_t i = 0; i < kPortCount; ++i) {
+    write(master_fds[i], "2*00\r\n", 6);
+  }
+  ASSERT_TRUE(PollUntil(reactor, [&] {
+    for (auto &port_lines : lines) {
+      if (port_lines.size() != 2) return false;
+    }
+    return true;
+  }));
+  for (auto &port_lines : lines) {
+    EXPECT_EQ(port_lines[0], std::string("$A,1*00\r\n"));
+    EXPECT_EQ(port_lines[1], std::string("$B,2*00\r\n"));
+  }
+}
+
+TEST_F(SerialReactorTests, reactorThread) {
+  SerialReactor reactor;
+  std::atomic<size_t> line_count(0);
+  for (auto &port : ports) {
+    reactor.RegisterLineHandler(
+        *port, [&line_count](Serial &, const std::string &) { ++line_count; });
+  }
+  reactor.Start();
+  for (int fd : master_fds) {
+    write(fd, "abc\ndef\n", 8);
+  }
+  MilliTimer timer;
+  timer.Start();
+  while (line_count < 2 * kPortCount && timer.MilliSeconds() < 1000) {
+    MilliTimer::Sleep(1);
+  }
+  reactor.Stop();
+  ASSERT_EQ(line_count, 2 * kPortCount);
+}
+
+TEST_F(SerialReactorTests, threadPoolDispatch) {
+  ThreadPool pool(2);
+  SerialReactor reactor(&pool);
+  std::atomic<size_t> line_count(0);
+  for (auto &port : ports) {
+    reactor.RegisterLineHandler(
+        *port, [&line_count](Serial &, const std::string &) { ++line_count; });
+  }
+  for (int i = 0; i < 10; ++i) {
+    for (int fd : master_fds) {
+      write(fd, "abc\n", 4);
+    }
+    PollUntil(reactor, [&] { return line_count == (i + 1) * kPortCount; });
+  }
+  ASSERT_EQ(line_count, 10 * kPortCount);
+}
+
+TEST_F(SerialReactorTests, unregisterWaitsForTheCallback) {
+  ThreadPool pool(1);
+  SerialReactor reactor(&pool);
+  std::atomic<bool> started(false), release(false), returned(false);
+  std::atomic<size_t> queued_count(0);
+  reactor.Register(*ports[0], [&](Serial &) {
+    started = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+    returned = true;
+  });
+  reactor.Register(*ports[1], [&queued_count](Serial &) { ++queued_count; });
+  write(master_fds[0], "a", 1);
+  ASSERT_TRUE(PollUntil(reactor, [&] { return started.load(); }));
+
+  // The only worker is busy, so the dispatch of the second port stays queued
+  // and is cancelled rather than waited for.
+  write(master_fds[1], "b", 1);
+  ASSERT_EQ(reactor.Poll(1000), 1);
+  reactor.Unregister(*ports[1]);
+
+  std::thread unregistering([&] {
+    reactor.Unregister(*ports[0]);
+    EXPECT_TRUE(returned);
+  });
+  MilliTimer::Sleep(10);
+  release = true;
+  unregistering.join();
+  EXPECT_EQ(queued_count, 0);
+}
+
+TEST_F(SerialReactorTests, unregisterFromTheCallback) {
+  for (bool use_pool : {false, true}) {
+    ThreadPool pool(1);
+    SerialReactor reactor(use_pool ? &pool : nullptr);
+    reactor.Register(*ports[0],
+                     [&reactor](Serial &port) { reactor.Unregister(port); });
+    write(master_fds[0], "a", 1);
+    ASSERT_TRUE(PollUntil(reactor, [&] { return reactor.PortCount() == 0; }));
+  }
+}
+
+TEST_F(SerialReactorTests, writableEvents) {
+  SerialReactor reactor;
+  std::atomic<size_t> writable_count(0);
+  reactor.Register(*ports[0], [](Serial &) {},
+                   [&writable_count](Serial &port) {
+                     port.Write("abc\n");
+                     ++writable_count;
+                   });
+  reactor.Poll(10);
+  ASSERT_EQ(writable_count, 0);
+
+  reactor.SetWatchWritable(*ports[0], true);
+  ASSERT_TRUE(PollUntil(reactor, [&] { return writable_count != 0; }));
+  reactor.SetWatchWritable(*ports[0], false);
+
+  char buf[5] = "";
+  read(master_fds[0], buf, 4);
+  EXPECT_EQ(std::string(buf, 4), std::string("abc\n"));
+}
+
+TEST_F(SerialReactorTests, hangUpReportsError) {
+  SerialReactor reactor;
+  std::string line;
+  bool error = false;
+  reactor.RegisterLineHandler(
+      *ports[0], [&line](Serial &, const std::string &l) { line = l; }, "\n",
+      [&error](Serial &, const std::exception &) { error = true; });
+
+  write(master_fds[0], "abc\n", 4);
+  close(master_fds[0]);
+  close(slave_fds[0]);
+  master_fds[0] = -1;
+  slave_fds[0] = -1;
+  ASSERT_TRUE(PollUntil(reactor, [&] { return error; }));
+  EXPECT_EQ(reactor.PortCount(), 0);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
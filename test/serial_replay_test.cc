@@ -0,0 +1,170 @@
+/**
+ * \file	serial_replay_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <lib_atlas/io/serial.h>
+#include <lib_atlas/io/serial_replayer.h>
+#include <lib_atlas/sys/timer.h>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(OS_LINUX)
+#include <pty.h>
+#else
+#include <util.h>
+#endif
+
+using namespace atlas;
+
+namespace {
+
+const char *kLogPath = "/tmp/serial_replay_test.log";
+
+// Record the strings as if they were received kGapNs apart.
+const int64_t kGapNs = 20000000;
+void WriteLog(const std::vector<std::string> &records) {
+  SerialRecorder recorder(kLogPath);
+  int64_t time_ns = NanoTimer::Now();
+  for (const auto &record : records) {
+    time_ns += kGapNs;
+    recorder.Record(time_ns, reinterpret_cast<const uint8_t *>(record.data()),
+                    record.size());
+  }
+}
+
+std::string ReplayInMemory(SerialReplayer &replayer) {
+  std::string replayed;
+  replayer.Replay([&replayed](const uint8_t *data, size_t size) {
+    replayed.append(reinterpret_cast<const char *>(data), size);
+  });
+  return replayed;
+}
+
+TEST(SerialReplayerTest, replayInMemory) {
+  WriteLog({"abc", "", "def\n"});
+  SerialReplayer replayer(kLogPath);
+  EXPECT_EQ(replayer.GetRecordCount(), 3);
+  EXPECT_EQ(replayer.GetByteCount(), 7);
+  EXPECT_GE(replayer.GetDurationNs(), 3 * kGapNs);
+
+  MilliTimer timer;
+  timer.Start();
+  EXPECT_EQ(ReplayInMemory(replayer), std::string("abcdef\n"));
+  EXPECT_GE(timer.MilliSeconds(), 3 * kGapNs / 1000000 - 1);
+
+  SerialReplayer fast_replayer(kLogPath, SerialReplayer::Speed::kMaximum);
+  timer.Start();
+  EXPECT_EQ(ReplayInMemory(fast_replayer), std::string("abcdef\n"));
+  EXPECT_LT(timer.MilliSeconds(), kGapNs / 1000000);
+}
+
+TEST(SerialReplayerTest, corruptedLog) {
+  WriteLog({"abcdef"});
+  // Drop the last byte of the record.
+  std::ifstream input(kLogPath, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(input)),
+                      std::istreambuf_iterator<char>());
+  std::ofstream(kLogPath, std::ios::binary)
+      .write(content.data(), content.size() - 1);
+  EXPECT_THROW(SerialReplayer replayer(kLogPath), CorruptedDataException);
+  EXPECT_THROW(SerialReplayer replayer("/tmp/does/not/exist.log"),
+               IOException);
+}
+
+TEST(SerialReplayerTest, recordSerialReads) {
+  int master_fd, slave_fd;
+  char name[100];
+  ASSERT_NE(openpty(&master_fd, &slave_fd, name, NULL, NULL), -1);
+  {
+    Serial serial(std::string(name), 115200, Timeout::SimpleTimeout(250));
+    SerialRecorder::Ptr recorder = std::make_shared<SerialRecorder>(kLogPath);
+    serial.SetRecorder(recorder);
+    write(master_fd, "abc\ndef\n", 8);
+    EXPECT_EQ(serial.ReadLine(), std::string("abc\n"));
+    MilliTimer::Sleep(20);
+    write(master_fd, "ghi\n", 4);
+    EXPECT_EQ(serial.ReadLine(), std::string("def\n"));
+    EXPECT_EQ(serial.ReadLine(), std::string("ghi\n"));
+    EXPECT_EQ(recorder->GetByteCount(), 12);
+    serial.SetRecorder(nullptr);
+  }
+  close(master_fd);
+  close(slave_fd);
+
+  SerialReplayer replayer(kLogPath);
+  EXPECT_EQ(ReplayInMemory(replayer), std::string("abc\ndef\nghi\n"));
+  EXPECT_GE(replayer.GetDurationNs(), 20000000);
+}
+
+TEST(SerialReplayerTest, failingRecorderDoesNotLoseBytes) {
+  int master_fd, slave_fd;
+  char name[100];
+  ASSERT_NE(openpty(&master_fd, &slave_fd, name, NULL, NULL), -1);
+  {
+    Serial serial(std::string(name), 115200, Timeout::SimpleTimeout(250));
+    // Every write of /dev/full fails, once the buffer of the file is full.
+    serial.SetRecorder(std::make_shared<SerialRecorder>("/dev/full"));
+    const std::string sent(1024, 'x');
+    for (int i = 0; i < 64; ++i) {
+      ASSERT_EQ(write(master_fd, sent.data(), sent.size()),
+                static_cast<ssize_t>(sent.size()));
+      ASSERT_EQ(serial.Read(sent.size()), sent);
+    }
+    ASSERT_NE(serial.GetRecorderError(), nullptr);
+    EXPECT_THROW(std::rethrow_exception(serial.GetRecorderError()),
+                 IOException);
+    serial.SetRecorder(nullptr);
+    EXPECT_EQ(serial.GetRecorderError(), nullptr);
+  }
+  close(master_fd);
+  close(slave_fd);
+}
+
+TEST(SerialReplayerTest, replayThroughPty) {
+  WriteLog({"abc\nd", "ef\n"});
+  SerialReplayer replayer(kLogPath);
+  Serial serial(replayer.OpenPty(), 115200, Timeout::SimpleTimeout(250));
+  replayer.Start();
+  EXPECT_EQ(serial.ReadLine(), std::string("abc\n"));
+  EXPECT_EQ(serial.ReadLine(), std::string("def\n"));
+  EXPECT_TRUE(replayer.IsFinished());
+  replayer.Stop();
+}
+
+TEST(SerialReplayerTest, startWithoutPtyThrows) {
+  WriteLog({"abc\n"});
+  SerialReplayer replayer(kLogPath);
+  EXPECT_THROW(replayer.Start(), std::logic_error);
+  EXPECT_FALSE(replayer.IsRunning());
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -33,10 +33,16 @@
  * This provides a cross platform interface for interacting with Serial Ports.
  */
 
+#include <atomic>
 #include <string>
+#include <fstream>
+#include <future>
+#include <thread>
 #include "gtest/gtest.h"
 #include <boost/bind.hpp>
 #include <lib_atlas/io/serial.h>
+#include <lib_atlas/sys/timer.h>
+#include "allocation_counter.h"
 
 #if defined(OS_LINUX)
 #include <pty.h>
@@ -48,6 +54,19 @@ using namespace atlas;
 
 namespace {
 
+// Number of read syscalls issued by the calling thread so far.
+size_t ReadSyscalls() {
+  std::ifstream io("/proc/thread-self/io");
+  std::string key;
+  size_t value = 0;
+  while (io >> key >> value) {
+    if (key == "syscr:") {
+      return value;
+    }
+  }
+  return 0;
+}
+
 class SerialTests : public ::testing::Test {
 protected:
   virtual void SetUp() {
@@ -112,6 +131,417 @@ TEST_F(SerialTests, partialRead) {
   EXPECT_EQ(r, std::string("abc\n"));
 }
 
+TEST_F(SerialTests, readsDoNotAllocate) {
+  // Each read records the chunk it received until the bytes are consumed.
+  std::string line;
+  line.reserve(16);
+  // Only the steady state is measured, after a first line.
+  write(master_fd, "a\n", 2);
+  ASSERT_EQ(port1->ReadLine(line), 2);
+  size_t allocations = g_allocations.load();
+  for (int i = 0; i < 200; ++i) {
+    write(master_fd, "a\n", 2);
+    line.clear();
+    ASSERT_EQ(port1->ReadLine(line), 2);
+  }
+  EXPECT_EQ(g_allocations.load() - allocations, 0);
+}
+
+TEST_F(SerialTests, manyPendingChunksAreMerged) {
+  // More ::read calls than the chunks that can be recorded, each one
+  // leaving its byte pending.
+  Serial::Timestamp before = std::chrono::steady_clock::now();
+  std::string line;
+  for (int i = 0; i < 100; ++i) {
+    write(master_fd, "a", 1);
+    while (port1->Available() == static_cast<size_t>(i)) {
+      std::this_thread::yield();
+    }
+    ASSERT_EQ(port1->TryReadLine(line), 0);
+  }
+  write(master_fd, "\n", 1);
+  Serial::Timestamp receive_time;
+  ASSERT_EQ(port1->ReadLine(line, receive_time), 101);
+  EXPECT_EQ(line, std::string(100, 'a') + "\n");
+  EXPECT_GE(receive_time, before - std::chrono::milliseconds(1));
+  EXPECT_LE(receive_time, std::chrono::steady_clock::now());
+}
+
+TEST_F(SerialTests, readLineWorks) {
+  write(master_fd, "abc\ndef\r\n", 9);
+  EXPECT_EQ(port1->ReadLine(), std::string("abc\n"));
+  EXPECT_EQ(port1->ReadLine(65536, "\r\n"), std::string("def\r\n"));
+
+  // A line without EOL is returned once the read times out.
+  write(master_fd, "ghi", 3);
+  EXPECT_EQ(port1->ReadLine(), std::string("ghi"));
+
+  // The maximum length splits a line.
+  write(master_fd, "abcdef\n", 7);
+  EXPECT_EQ(port1->ReadLine(3), std::string("abc"));
+  EXPECT_EQ(port1->ReadLine(), std::string("def\n"));
+}
+
+TEST_F(SerialTests, readLineKeepsLeftover) {
+  write(master_fd, "abc\ndef\nghi", 11);
+  EXPECT_EQ(port1->ReadLine(), std::string("abc\n"));
+  EXPECT_EQ(port1->Available(), 7);
+  EXPECT_EQ(port1->Read(2), std::string("de"));
+  std::vector<std::string> lines = port1->ReadLines();
+  ASSERT_EQ(lines.size(), 2);
+  EXPECT_EQ(lines[0], std::string("f\n"));
+  EXPECT_EQ(lines[1], std::string("ghi"));
+
+  write(master_fd, "abc\n", 4);
+  port1->FlushInput();
+  EXPECT_EQ(port1->Available(), 0);
+}
+
+TEST_F(SerialTests, readLineSyscallsPerLine) {
+  const size_t line_count = 2000;
+  const std::string sentence =
+      "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+  std::thread writer([&] {
+    for (size_t i = 0; i < line_count; ++i) {
+      write(master_fd, sentence.data(), sentence.length());
+    }
+  });
+
+  std::string line;
+  size_t lines_read = 0;
+  size_t syscalls = ReadSyscalls();
+  while (lines_read < line_count) {
+    line.clear();
+    if (port1->ReadLine(line, 65536, "\r\n") == 0) {
+      break;
+    }
+    ASSERT_EQ(line, sentence);
+    ++lines_read;
+  }
+  syscalls = ReadSyscalls() - syscalls;
+  writer.join();
+
+  ASSERT_EQ(lines_read, line_count);
+  EXPECT_LT(syscalls, lines_read);
+}
+
+TEST_F(SerialTests, readFrameWorks) {
+  SyncWordFramer framer({0xAA, 0x55});
+  std::vector<uint8_t> frame = {0x13, 0xAA, 0x55, 0x00, 0x03, 'a', 'b', 'c'};
+  uint16_t crc = Crc16(&frame[3], 5);
+  frame.push_back(static_cast<uint8_t>(crc >> 8));
+  frame.push_back(static_cast<uint8_t>(crc));
+
+  // The frame is received in two parts.
+  write(master_fd, frame.data(), 6);
+  FrameView view;
+  EXPECT_FALSE(port1->TryReadFrame(framer, view));
+  write(master_fd, &frame[6], frame.size() - 6);
+  ASSERT_TRUE(port1->ReadFrame(framer, view));
+  EXPECT_EQ(view.ToString(), std::string("abc"));
+
+  // A frame that is never completed times out.
+  write(master_fd, frame.data(), 6);
+  EXPECT_FALSE(port1->ReadFrame(framer, view));
+
+  // The bytes that were not consumed by the framer are still readable.
+  DelimiterFramer line_framer("\n");
+  port1->FlushInput();
+  write(master_fd, "abc\ndef", 7);
+  ASSERT_TRUE(port1->ReadFrame(line_framer, view));
+  EXPECT_EQ(view.ToString(), std::string("abc"));
+  EXPECT_EQ(port1->Read(3), std::string("def"));
+}
+
+TEST_F(SerialTests, tryReadFrameDrainsBufferedFrames) {
+  CobsFramer framer;
+  const uint8_t frames[] = {0x02, 'a', 0x00, 0x02, 'b', 0x00, 0x02, 'c'};
+  write(master_fd, frames, sizeof(frames));
+  MilliTimer::Sleep(10);
+
+  std::string payloads;
+  FrameView view;
+  while (port1->TryReadFrame(framer, view)) {
+    payloads += view.ToString();
+  }
+  EXPECT_EQ(payloads, std::string("ab"));
+  write(master_fd, "\x00", 1);
+  ASSERT_TRUE(port1->ReadFrame(framer, view));
+  EXPECT_EQ(view.ToString(), std::string("c"));
+}
+
+TEST_F(SerialTests, writeBatchWorks) {
+  const uint8_t header[] = {0xAA, 0x55};
+  std::string payload("abc");
+  uint8_t checksum = 0x42;
+  WriteBatch batch;
+  batch.Add(header, sizeof(header)).Add(payload).Add(nullptr, 0);
+  batch.Add(&checksum, 1);
+  EXPECT_EQ(batch.Count(), 3);
+  EXPECT_EQ(batch.Size(), 6);
+  ASSERT_EQ(port1->Write(batch), 6);
+
+  char buf[7] = "";
+  ASSERT_EQ(read(master_fd, buf, 6), 6);
+  EXPECT_EQ(std::string(buf, 6), std::string("\xAA\x55" "abc\x42"));
+}
+
+TEST_F(SerialTests, vectoredWriteWaitsForFullQueue) {
+  // More bytes than the pty can buffer, so the write must wait for the
+  // reader when the descriptor returns EAGAIN.
+  const size_t buffer_count = 64;
+  const size_t buffer_size = 4096;
+  std::vector<std::string> buffers;
+  std::vector<iovec> iov;
+  for (size_t i = 0; i < buffer_count; ++i) {
+    buffers.push_back(
+        std::string(buffer_size, static_cast<char>('a' + i % 26)));
+  }
+  for (auto &buffer : buffers) {
+    iovec v = {&buffer[0], buffer.size()};
+    iov.push_back(v);
+  }
+
+  std::string received;
+  std::thread reader([&] {
+    char buf[4096];
+    while (received.size() < buffer_count * buffer_size) {
+      ssize_t n = read(master_fd, buf, sizeof(buf));
+      if (n <= 0) {
+        break;
+      }
+      received.append(buf, n);
+    }
+  });
+  port1->SetTimeout(Timeout::SimpleTimeout(2000));
+  EXPECT_EQ(port1->Write(iov.data(), iov.size()), buffer_count * buffer_size);
+  reader.join();
+
+  std::string expected;
+  for (auto &buffer : buffers) {
+    expected += buffer;
+  }
+  EXPECT_EQ(received, expected);
+}
+
+TEST_F(SerialTests, asyncWriteWorks) {
+  port1->EnableAsyncWrite(1024);
+  ASSERT_TRUE(port1->IsAsyncWriteEnabled());
+  std::string expected;
+  for (int i = 0; i < 10; ++i) {
+    std::string message = "message " + std::to_string(i) + "\n";
+    EXPECT_EQ(port1->Write(message), message.size());
+    expected += message;
+  }
+  std::future<void> flushed = port1->FlushAsync();
+  ASSERT_EQ(flushed.wait_for(std::chrono::seconds(1)),
+            std::future_status::ready);
+  flushed.get();
+
+  std::string received(expected.size(), '\0');
+  ASSERT_EQ(read(master_fd, &received[0], received.size()),
+            static_cast<ssize_t>(expected.size()));
+  EXPECT_EQ(received, expected);
+  EXPECT_EQ(port1->GetAsyncWriteStats().queued_bytes, 0);
+  EXPECT_GT(port1->GetAsyncWriteStats().high_water_mark, 0);
+
+  port1->DisableAsyncWrite();
+  EXPECT_FALSE(port1->IsAsyncWriteEnabled());
+  port1->Write("abc\n");
+  char buf[5] = "";
+  read(master_fd, buf, 4);
+  EXPECT_EQ(std::string(buf, 4), std::string("abc\n"));
+}
+
+TEST_F(SerialTests, asyncWritePolicies) {
+  // A write bigger than the queue never fits in it.
+  port1->EnableAsyncWrite(16, AsyncWritePolicy::kDropNewest);
+  EXPECT_EQ(port1->Write(std::string(32, 'a')), 0);
+  EXPECT_EQ(port1->GetAsyncWriteStats().dropped_bytes, 32);
+  port1->FlushAsync().get();
+
+  // Only its first bytes are queued when truncating.
+  port1->EnableAsyncWrite(16, AsyncWritePolicy::kTruncate);
+  EXPECT_EQ(port1->Write(std::string(16, 'a') + std::string(16, 'b')), 16);
+  EXPECT_EQ(port1->GetAsyncWriteStats().dropped_bytes, 16);
+  port1->FlushAsync().get();
+  char buf[17] = "";
+  ASSERT_EQ(read(master_fd, buf, 16), 16);
+  EXPECT_EQ(std::string(buf, 16), std::string(16, 'a'));
+}
+
+TEST_F(SerialTests, asyncWriteDoesNotBlock) {
+  // Nobody reads the other end of the pty: fill its buffer until a
+  // synchronous write times out, so the device accepts no more bytes.
+  port1->SetTimeout(Timeout::SimpleTimeout(50));
+  const std::string message(512, 'x');
+  while (port1->Write(message) == message.size()) {
+  }
+
+  // The writes return while their bytes are still waiting for the device,
+  // and those that do not fit in the queue are dropped.
+  port1->EnableAsyncWrite(4096);
+  EXPECT_EQ(port1->Write(message), message.size());
+  for (int i = 0; i < 24; ++i) {
+    port1->Write(message);
+  }
+  std::future<void> flushed = port1->FlushAsync();
+  EXPECT_EQ(flushed.wait_for(std::chrono::seconds(0)),
+            std::future_status::timeout);
+  AsyncWriteStats stats = port1->GetAsyncWriteStats();
+  EXPECT_GT(stats.dropped_bytes, 0);
+  EXPECT_LE(stats.high_water_mark, 4096);
+}
+
+TEST_F(SerialTests, lockPolicies) {
+  port1->ReadLine();
+  port1->Write("abc\n");
+  EXPECT_GT(port1->GetReadLockStats().acquisitions, 0);
+  EXPECT_GT(port1->GetWriteLockStats().acquisitions, 0);
+  port1->ResetLockStats();
+  EXPECT_EQ(port1->GetReadLockStats().acquisitions, 0);
+
+  for (auto policy : {LockPolicy::kSpinThenPark, LockPolicy::kNone}) {
+    Serial port(std::string(name), 115200, Timeout::SimpleTimeout(250),
+                eightbits, parity_none, stopbits_one, flowcontrol_none,
+                policy);
+    write(master_fd, "def\n", 4);
+    EXPECT_EQ(port.ReadLine(), std::string("def\n"));
+  }
+}
+
+TEST_F(SerialTests, statsWork) {
+  EXPECT_FALSE(port1->IsStatsEnabled());
+  write(master_fd, "abc\n", 4);
+  port1->ReadLine();
+  EXPECT_EQ(port1->GetStats().bytes_read, 0);
+
+  port1->EnableStats();
+  write(master_fd, "abc\n", 4);
+  EXPECT_EQ(port1->ReadLine(), std::string("abc\n"));
+  write(master_fd, "def\n", 4);
+  EXPECT_EQ(port1->ReadLine(), std::string("def\n"));
+  port1->Write("ghi\n");
+  EXPECT_EQ(port1->Read(1), std::string(""));
+
+  SerialStatsSnapshot stats = port1->GetStats();
+  EXPECT_EQ(stats.bytes_read, 8);
+  EXPECT_EQ(stats.bytes_written, 4);
+  EXPECT_GE(stats.syscalls, 4);
+  EXPECT_EQ(stats.read_timeouts, 1);
+  EXPECT_EQ(stats.write_timeouts, 0);
+  EXPECT_EQ(stats.read_latency.count, 3);
+  EXPECT_EQ(stats.write_latency.count, 1);
+  EXPECT_EQ(stats.inter_byte_gap.count, 1);
+  // The timed out read lasted about 250ms.
+  EXPECT_GE(stats.read_latency.max_ns, 200000000);
+  EXPECT_GE(stats.read_latency.PercentileNs(100.), 200000000);
+  EXPECT_NE(stats.ToString().find("read timeouts: 1"), std::string::npos);
+
+  port1->ResetStats();
+  EXPECT_EQ(port1->GetStats().bytes_read, 0);
+  EXPECT_EQ(port1->GetStats().read_latency.count, 0);
+}
+
+TEST_F(SerialTests, timestampedReadsWork) {
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+  // 10 bits per byte at 115200 bauds.
+  const int64_t byte_time_ns = 1000000000 / 115200 * 10;
+
+  // Both lines are returned by the same ::read, so the second one started
+  // to arrive four byte times after the first one.
+  Serial::Timestamp before = std::chrono::steady_clock::now();
+  write(master_fd, "abc\ndef\n", 8);
+  std::string line;
+  Serial::Timestamp first, second;
+  ASSERT_EQ(port1->ReadLine(line, first), 4);
+  ASSERT_EQ(port1->ReadLine(line, second), 4);
+  EXPECT_EQ(duration_cast<nanoseconds>(second - first).count(),
+            4 * byte_time_ns);
+  EXPECT_GE(first, before - nanoseconds(8 * byte_time_ns));
+  EXPECT_LE(second, std::chrono::steady_clock::now());
+
+  uint8_t buffer[4];
+  Serial::Timestamp read_time;
+  write(master_fd, "ghij", 4);
+  ASSERT_EQ(port1->Read(buffer, 4, read_time), 4);
+  EXPECT_LE(read_time,
+            std::chrono::steady_clock::now() - nanoseconds(4 * byte_time_ns));
+
+  DelimiterFramer framer("\n");
+  FrameView frame;
+  Serial::Timestamp frame_time;
+  write(master_fd, "klm\n", 4);
+  ASSERT_TRUE(port1->ReadFrame(framer, frame, frame_time));
+  EXPECT_EQ(frame.ToString(), std::string("klm"));
+  EXPECT_GT(frame_time, read_time);
+
+  // The timestamp is left untouched when nothing is read.
+  Serial::Timestamp untouched;
+  EXPECT_EQ(port1->Read(buffer, 1, untouched), 0);
+  EXPECT_EQ(untouched, Serial::Timestamp());
+}
+
+TEST_F(SerialTests, lowLatencyWorks) {
+  port1->SetLowLatency(LowLatency());
+  EXPECT_TRUE(port1->GetLowLatency().blocking_reads);
+  write(master_fd, "abc\ndef", 7);
+  EXPECT_EQ(port1->ReadLine(), std::string("abc\n"));
+  EXPECT_EQ(port1->Read(3), std::string("def"));
+
+  // VTIME waits for 200ms of the 250ms timeout, and a poll for the rest.
+  MilliTimer timer;
+  timer.Start();
+  EXPECT_EQ(port1->Read(1), std::string(""));
+  EXPECT_GE(timer.MilliSeconds(), 240);
+
+  // A timeout under the 100ms resolution of VTIME is neither rounded up to
+  // it nor spent spinning on a ::read that returns right away.
+  port1->SetTimeout(Timeout::SimpleTimeout(30));
+  port1->EnableStats();
+  timer.Start();
+  EXPECT_EQ(port1->Read(1), std::string(""));
+  EXPECT_LT(timer.MilliSeconds(), 90);
+  EXPECT_LE(port1->GetStats().syscalls, 4);
+  port1->EnableStats(false);
+  port1->SetTimeout(Timeout::SimpleTimeout(250));
+
+  // Baudrates without a Bxxx constant are supported.
+  port1->SetBaudrate(250000);
+  EXPECT_EQ(port1->GetBaudrate(), 250000);
+  write(master_fd, "ghi\n", 4);
+  EXPECT_EQ(port1->ReadLine(), std::string("ghi\n"));
+
+  port1->SetLowLatency(LowLatency::None());
+  write(master_fd, "jkl\n", 4);
+  EXPECT_EQ(port1->ReadLine(), std::string("jkl\n"));
+}
+
+TEST(LatencyHistogramTest, bucketsArePowersOfTwo) {
+  LatencyHistogram histogram;
+  for (uint64_t duration : {0, 1, 2, 3, 4, 1000, 1023, 1024}) {
+    histogram.Record(duration);
+  }
+  LatencyHistogramSnapshot snapshot = histogram.Snapshot();
+  ASSERT_EQ(snapshot.buckets.size(),
+            static_cast<size_t>(LatencyHistogram::kBucketCount));
+  EXPECT_EQ(snapshot.buckets[0], 1);
+  EXPECT_EQ(snapshot.buckets[1], 1);
+  EXPECT_EQ(snapshot.buckets[2], 2);
+  EXPECT_EQ(snapshot.buckets[3], 1);
+  EXPECT_EQ(snapshot.buckets[10], 2);
+  EXPECT_EQ(snapshot.buckets[11], 1);
+  EXPECT_EQ(snapshot.count, 8);
+  EXPECT_EQ(snapshot.max_ns, 1024);
+  EXPECT_EQ(snapshot.PercentileNs(50.), 8);
+  EXPECT_EQ(snapshot.PercentileNs(100.), 2048);
+
+  histogram.Record(uint64_t(1) << 50);
+  EXPECT_EQ(histogram.Snapshot().buckets.back(), 1);
+  EXPECT_EQ(histogram.Snapshot().PercentileNs(100.), uint64_t(1) << 50);
+}
+
 }  // namespace
 
 int main(int argc, char **argv) {
@@ -0,0 +1,217 @@
+/**
+ * \file	task_graph_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <lib_atlas/pattern/task_future.h>
+#include <lib_atlas/pattern/task_graph.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace atlas;
+
+namespace {
+
+const ThreadPool::Scheduling kSchedulings[] = {
+    ThreadPool::Scheduling::kSharedQueue,
+    ThreadPool::Scheduling::kWorkStealing};
+
+TEST(TaskFutureTest, continuationsAreChained) {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(2, scheduling);
+    auto result = Async(pool, [](int a) { return a; }, 20)
+                      .Then([](const int &a) { return a + 1; })
+                      .Then([](const int &a) { return a * 2; });
+    ASSERT_EQ(result.Get(), 42);
+
+    std::atomic<int> calls(0);
+    auto done = Async(pool, [&calls] { calls.fetch_add(1); })
+                    .Then([&calls] { calls.fetch_add(1); })
+                    .Then([&calls] { return calls.load(); });
+    ASSERT_EQ(done.Get(), 2);
+    ASSERT_TRUE(done.IsReady());
+
+    // A continuation added to a ready future is scheduled right away.
+    ASSERT_EQ(result.Then([](const int &a) { return a + 1; }).Get(), 43);
+  }
+}
+
+TEST(TaskFutureTest, continuationsNeverBlockAWorker) {
+  // With a single worker, waiting for a result from a task would deadlock.
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(1, scheduling);
+    const int kCount = 200;
+    std::vector<TaskFuture<int>> futures;
+    for (int i = 0; i < kCount; ++i) {
+      futures.push_back(Async(pool, [i] { return i; }).Then([](const int &a) {
+        return a + 1;
+      }));
+    }
+    auto sum = WhenAll(futures).Then([](const std::vector<int> &values) {
+      int total = 0;
+      for (int value : values) {
+        total += value;
+      }
+      return total;
+    });
+    ASSERT_EQ(sum.Get(), kCount * (kCount + 1) / 2);
+
+    std::vector<TaskFuture<void>> waits;
+    std::atomic<int> count(0);
+    for (int i = 0; i < kCount; ++i) {
+      waits.push_back(Async(pool, [&count] { count.fetch_add(1); }));
+    }
+    WhenAll(waits).Get();
+    ASSERT_EQ(count.load(), kCount);
+  }
+}
+
+TEST(TaskFutureTest, exceptionsArePropagated) {
+  ThreadPool pool(2);
+  std::atomic<bool> executed(false);
+  auto failed = Async(pool, []() -> int { throw std::runtime_error("fail"); })
+                    .Then([&executed](const int &a) {
+                      executed = true;
+                      return a;
+                    });
+  ASSERT_THROW(failed.Get(), std::runtime_error);
+  ASSERT_FALSE(executed);
+
+  std::vector<TaskFuture<int>> futures = {Async(pool, [] { return 1; }),
+                                          failed};
+  ASSERT_THROW(WhenAll(futures).Get(), std::runtime_error);
+
+  ASSERT_THROW(TaskFuture<int>().Get(), std::future_error);
+  ASSERT_TRUE(WhenAll(std::vector<TaskFuture<int>>()).Get().empty());
+  WhenAll(std::vector<TaskFuture<void>>()).Get();
+}
+
+TEST(TaskGraphTest, dependenciesAreRespected) {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(4, scheduling);
+    TaskGraph graph(pool);
+    std::atomic<int> clock(0);
+    int stamps[5] = {0};
+    auto stamp = [&clock, &stamps](int i) {
+      return [&clock, &stamps, i] { stamps[i] = clock.fetch_add(1); };
+    };
+    // A diamond followed by a task depending on two levels.
+    auto a = graph.Add(stamp(0));
+    auto b = graph.Add(stamp(1), {a});
+    auto c = graph.Add(stamp(2), {a});
+    auto d = graph.Add(stamp(3), {b, c});
+    auto e = graph.Add(stamp(4), {a});
+    graph.Precede(d, e);
+    ASSERT_EQ(graph.GetNodeCount(), 5);
+
+    for (int run = 0; run < 100; ++run) {
+      clock = 0;
+      graph.Run().Get();
+      ASSERT_EQ(stamps[a], 0);
+      ASSERT_LT(stamps[a], stamps[b]);
+      ASSERT_LT(stamps[a], stamps[c]);
+      ASSERT_LT(stamps[b], stamps[d]);
+      ASSERT_LT(stamps[c], stamps[d]);
+      ASSERT_EQ(stamps[e], 4);
+    }
+  }
+}
+
+TEST(TaskGraphTest, largeGraphsComplete) {
+  ThreadPool pool(1);
+  TaskGraph graph(pool);
+  std::atomic<int> count(0);
+  // Layers fully connected to the previous one.
+  std::vector<TaskGraph::NodeId> previous;
+  for (int layer = 0; layer < 20; ++layer) {
+    std::vector<TaskGraph::NodeId> current;
+    for (int i = 0; i < 20; ++i) {
+      auto id = graph.Add([&count] { count.fetch_add(1); });
+      for (auto before : previous) {
+        graph.Precede(before, id);
+      }
+      current.push_back(id);
+    }
+    previous = current;
+  }
+  std::atomic<bool> done(false);
+  graph.Run().Then([&done] { done = true; }).Get();
+  ASSERT_EQ(count.load(), 400);
+  ASSERT_TRUE(done);
+  ASSERT_FALSE(graph.IsRunning());
+}
+
+TEST(TaskGraphTest, failureSkipsTheRemainingTasks) {
+  ThreadPool pool(2);
+  TaskGraph graph(pool);
+  bool fail = true;
+  bool after = false;
+  auto first = graph.Add([&fail] {
+    if (fail) {
+      throw std::runtime_error("fail");
+    }
+  });
+  graph.Add([&after] { after = true; }, {first});
+  ASSERT_THROW(graph.Run().Get(), std::runtime_error);
+  ASSERT_FALSE(after);
+
+  fail = false;
+  graph.Run().Get();
+  ASSERT_TRUE(after);
+}
+
+TEST(TaskGraphTest, invalidGraphs) {
+  ThreadPool pool(1);
+  TaskGraph graph(pool);
+  graph.Run().Get();
+  auto a = graph.Add([] {});
+  auto b = graph.Add([] {}, {a});
+  ASSERT_THROW(graph.Add([] {}, {5}), std::out_of_range);
+  ASSERT_THROW(graph.Precede(a, 5), std::out_of_range);
+  graph.Precede(b, a);
+  ASSERT_THROW(graph.Run(), std::invalid_argument);
+
+  TaskGraph running(pool);
+  std::atomic<bool> gate(false);
+  running.Add([&gate] {
+    while (!gate) {
+      std::this_thread::yield();
+    }
+  });
+  auto future = running.Run();
+  ASSERT_TRUE(running.IsRunning());
+  ASSERT_THROW(running.Run(), std::logic_error);
+  ASSERT_THROW(running.Add([] {}), std::logic_error);
+  gate = true;
+  future.Get();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,561 @@
+/**
+ * \file	thread_pool_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <lib_atlas/pattern/thread_pool.h>
+#include <lib_atlas/sys/timer.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "allocation_counter.h"
+
+using namespace atlas;
+
+namespace {
+
+const ThreadPool::Scheduling kSchedulings[] = {
+    ThreadPool::Scheduling::kSharedQueue,
+    ThreadPool::Scheduling::kWorkStealing};
+
+const ThreadPool::Partition kPartitions[] = {ThreadPool::Partition::kStatic,
+                                             ThreadPool::Partition::kDynamic,
+                                             ThreadPool::Partition::kGuided};
+
+void WaitFor(const std::atomic<int> &counter, int value) {
+  while (counter.load() < value) {
+    std::this_thread::yield();
+  }
+}
+
+// Enqueue tasks that each enqueue children from the worker, as a recursive
+// image split would. Returns the number of tasks executed per second.
+double FanOut(ThreadPool &pool, int roots, int children) {
+  std::atomic<int> done(0);
+  NanoTimer timer;
+  timer.Start();
+  for (int i = 0; i < roots; ++i) {
+    pool.Enqueue([&pool, &done, children] {
+      for (int j = 0; j < children; ++j) {
+        pool.Enqueue([&done] { done.fetch_add(1); });
+      }
+      done.fetch_add(1);
+    });
+  }
+  WaitFor(done, roots * (children + 1));
+  return roots * (children + 1) * 1e9 / timer.NanoSeconds();
+}
+
+// Occupy the only worker of a pool until the gate is opened, so the next
+// tasks are all queued when it looks for one.
+void BlockWorker(ThreadPool &pool, std::atomic<bool> &gate) {
+  std::atomic<int> started(0);
+  pool.Post([&gate, &started] {
+    started.fetch_add(1);
+    while (!gate.load()) {
+      std::this_thread::yield();
+    }
+  });
+  WaitFor(started, 1);
+}
+
+TEST(WorkStealingDequeTest, ownerIsLifoAndThievesAreFifo) {
+  details::WorkStealingDeque<int> deque(2);
+  int values[5] = {0, 1, 2, 3, 4};
+  ASSERT_EQ(deque.Take(), nullptr);
+  ASSERT_EQ(deque.Steal(), nullptr);
+  for (auto &value : values) {
+    deque.Push(&value);
+  }
+  ASSERT_EQ(deque.Size(), 5);
+  ASSERT_EQ(deque.Take(), &values[4]);
+  ASSERT_EQ(deque.Steal(), &values[0]);
+  ASSERT_EQ(deque.Steal(), &values[1]);
+  ASSERT_EQ(deque.Take(), &values[3]);
+  ASSERT_EQ(deque.Take(), &values[2]);
+  ASSERT_TRUE(deque.IsEmpty());
+  ASSERT_EQ(deque.Take(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, everyElementIsTakenOnce) {
+  const int kCount = 200000;
+  const int kThieves = 3;
+  details::WorkStealingDeque<int> deque(16);
+  std::vector<int> values(kCount);
+  std::vector<std::atomic<int>> seen(kCount);
+  for (auto &count : seen) {
+    count.store(0);
+  }
+  std::atomic<int> taken(0);
+  auto consume = [&](int *value) {
+    seen[value - values.data()].fetch_add(1);
+    taken.fetch_add(1);
+  };
+
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < kThieves; ++t) {
+    thieves.emplace_back([&] {
+      while (taken.load() < kCount) {
+        int *value = deque.Steal();
+        if (value != nullptr) {
+          consume(value);
+        }
+      }
+    });
+  }
+  for (int i = 0; i < kCount; ++i) {
+    deque.Push(&values[i]);
+    if (i % 3 == 0) {
+      int *value = deque.Take();
+      if (value != nullptr) {
+        consume(value);
+      }
+    }
+  }
+  while (taken.load() < kCount) {
+    int *value = deque.Take();
+    if (value != nullptr) {
+      consume(value);
+    }
+  }
+  for (auto &thief : thieves) {
+    thief.join();
+  }
+  for (auto &count : seen) {
+    ASSERT_EQ(count.load(), 1);
+  }
+}
+
+TEST(ThreadPoolTest, enqueueReturnsResults) {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(4, scheduling);
+    ASSERT_EQ(pool.GetThreadCount(), 4);
+    ASSERT_EQ(pool.GetScheduling(), scheduling);
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 1000; ++i) {
+      results.push_back(pool.Enqueue([](int x) { return x * x; }, i));
+    }
+    for (int i = 0; i < 1000; ++i) {
+      ASSERT_EQ(results[i].get(), i * i);
+    }
+    auto failure =
+        pool.Enqueue([]() -> int { throw std::logic_error("failure"); });
+    ASSERT_THROW(failure.get(), std::logic_error);
+  }
+}
+
+TEST(ThreadPoolTest, nestedTasksComplete) {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(4, scheduling);
+    std::atomic<int> done(0);
+    FanOut(pool, 100, 100);
+    for (int i = 0; i < 10; ++i) {
+      pool.Enqueue([&done] { done.fetch_add(1); });
+    }
+    WaitFor(done, 10);
+  }
+}
+
+TEST(ThreadPoolTest, pendingTasksRunOnDestruction) {
+  for (auto scheduling : kSchedulings) {
+    std::atomic<int> done(0);
+    {
+      ThreadPool pool(2, scheduling);
+      for (int i = 0; i < 1000; ++i) {
+        pool.Enqueue([&done] { done.fetch_add(1); });
+      }
+    }
+    ASSERT_EQ(done.load(), 1000);
+  }
+}
+
+// Post or enqueue tasks one at a time and wait for each of them, as a control
+// loop would. Returns the number of allocations per task.
+double AllocationsPerTask(ThreadPool &pool, bool post, int tasks) {
+  std::atomic<int> done(0);
+  size_t allocations = g_allocations.load();
+  for (int i = 0; i < tasks; ++i) {
+    if (post) {
+      pool.Post([&done] { done.fetch_add(1); });
+      WaitFor(done, i + 1);
+    } else {
+      pool.Enqueue([&done](int value) { return done.fetch_add(value); }, 1)
+          .get();
+    }
+  }
+  return static_cast<double>(g_allocations.load() - allocations) / tasks;
+}
+
+TEST(SmallTaskTest, smallCallablesAreInline) {
+  int calls = 0;
+  details::SmallTask task([&calls] { ++calls; });
+  ASSERT_TRUE(task.IsInline());
+  task();
+  details::SmallTask moved(std::move(task));
+  ASSERT_FALSE(static_cast<bool>(task));
+  ASSERT_TRUE(static_cast<bool>(moved));
+  moved();
+  ASSERT_EQ(calls, 2);
+  ASSERT_THROW(task(), std::bad_function_call);
+
+  char large[2 * details::SmallTask::kInlineSize] = {1};
+  details::SmallTask heap([large, &calls] { calls += large[0]; });
+  ASSERT_FALSE(heap.IsInline());
+  task = std::move(heap);
+  task();
+  ASSERT_EQ(calls, 3);
+}
+
+TEST(SmallTaskTest, moveOnlyCallables) {
+  std::promise<int> promise;
+  std::future<int> future = promise.get_future();
+  details::SmallTask task(details::MakePromisedCall(
+      std::move(promise), std::bind([](int x) { return x + 1; }, 41)));
+  ASSERT_TRUE(task.IsInline());
+  details::SmallTask moved(std::move(task));
+  moved();
+  ASSERT_EQ(future.get(), 42);
+}
+
+TEST(ThreadPoolTest, postRunsTasks) {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(4, scheduling);
+    std::atomic<int> done(0);
+    for (int i = 0; i < 1000; ++i) {
+      pool.Post([&done](int value) { done.fetch_add(value); }, 2);
+    }
+    WaitFor(done, 2000);
+  }
+}
+
+TEST(ThreadPoolTest, submissionDoesNotAllocate) {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(2, scheduling);
+    for (bool post : {true, false}) {
+      // A burst of tasks fills the node and the block pools, so that the free
+      // nodes kept by the workers cannot starve the shared free list.
+      std::vector<std::future<int>> futures;
+      for (int i = 0; i < 2000; ++i) {
+        futures.push_back(pool.Enqueue([] { return 0; }));
+      }
+      for (auto &future : futures) {
+        future.get();
+      }
+      futures.clear();
+      AllocationsPerTask(pool, post, 2000);
+      ASSERT_EQ(AllocationsPerTask(pool, post, 2000), 0.);
+    }
+  }
+}
+
+TEST(ThreadPoolTest, parallelForVisitsEveryIndexOnce) {
+  const int kCount = 100003;
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(4, scheduling);
+    for (auto partition : kPartitions) {
+      for (int grain : {1, 100, 1000000}) {
+        std::vector<std::atomic<int>> visits(kCount);
+        for (auto &visit : visits) {
+          visit.store(0);
+        }
+        pool.ParallelFor(0, kCount, grain,
+                         [&visits](int i) { visits[i].fetch_add(1); },
+                         partition);
+        for (auto &visit : visits) {
+          ASSERT_EQ(visit.load(), 1);
+        }
+      }
+    }
+    // An empty range does not call the function.
+    pool.ParallelFor(5, 5, 1, [](int) { FAIL(); });
+  }
+}
+
+TEST(ThreadPoolTest, parallelForRunsOnTheCallerWithoutWorkers) {
+  ThreadPool pool(0);
+  std::thread::id caller = std::this_thread::get_id();
+  int sum = 0;
+  pool.ParallelFor(size_t(0), size_t(100), 10, [&](size_t i) {
+    ASSERT_EQ(std::this_thread::get_id(), caller);
+    sum += static_cast<int>(i);
+  });
+  ASSERT_EQ(sum, 4950);
+}
+
+TEST(ThreadPoolTest, parallelForRethrows) {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(4, scheduling);
+    std::atomic<int> calls(0);
+    ASSERT_THROW(pool.ParallelFor(0, 100000, 10,
+                                  [&calls](int i) {
+                                    calls.fetch_add(1);
+                                    if (i == 500) {
+                                      throw std::logic_error("failure");
+                                    }
+                                  }),
+                 std::logic_error);
+    ASSERT_LT(calls.load(), 100000);
+  }
+}
+
+TEST(ThreadPoolTest, nestedParallelForDoesNotDeadlock) {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(2, scheduling);
+    std::atomic<int> count(0);
+    pool.ParallelFor(0, 8, 1, [&pool, &count](int) {
+      pool.ParallelFor(0, 1000, 10, [&count](int) { count.fetch_add(1); });
+    });
+    ASSERT_EQ(count.load(), 8000);
+  }
+}
+
+TEST(ThreadPoolTest, parallelReduce) {
+  std::vector<int64_t> values(1000000);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int64_t>(i % 1000) - 300;
+  }
+  int64_t expected = 0;
+  for (auto value : values) {
+    expected += value;
+  }
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(4, scheduling);
+    for (auto partition : kPartitions) {
+      int64_t sum = pool.ParallelReduce(
+          size_t(0), values.size(), 1000, int64_t(0),
+          [&values](size_t first, size_t last) {
+            int64_t chunk = 0;
+            for (size_t i = first; i < last; ++i) {
+              chunk += values[i];
+            }
+            return chunk;
+          },
+          [](int64_t a, int64_t b) { return a + b; }, partition);
+      ASSERT_EQ(sum, expected);
+    }
+    ASSERT_EQ(pool.ParallelReduce(
+                  0, 0, 1, 42, [](int, int) { return 0; },
+                  [](int a, int b) { return a + b; }),
+              42);
+  }
+}
+
+TEST(ThreadPoolTest, higherPrioritiesAreServedFirst) {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(1, scheduling);
+    std::atomic<bool> gate(false);
+    BlockWorker(pool, gate);
+
+    std::mutex mutex;
+    std::vector<int> order;
+    std::atomic<int> done(0);
+    auto record = [&mutex, &order, &done](int value) {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(value);
+      done.fetch_add(1);
+    };
+    pool.Post(ThreadPool::Priority::kBackground, record, 2);
+    pool.Post(record, 1);
+    pool.Post(ThreadPool::Priority::kRealtime, record, 0);
+    pool.Post(ThreadPool::Priority::kBackground, record, 3);
+    auto future = pool.Enqueue(ThreadPool::Priority::kRealtime,
+                               [](int value) { return value * 2; }, 21);
+    gate.store(true);
+
+    WaitFor(done, 4);
+    ASSERT_EQ(future.get(), 42);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+  }
+}
+
+TEST(ThreadPoolTest, expiredTasksAreDroppedOrRunLate) {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(1, scheduling);
+    std::atomic<bool> gate(false);
+    BlockWorker(pool, gate);
+
+    auto deadline =
+        ThreadPool::Clock::now() + std::chrono::milliseconds(1);
+    auto dropped = pool.Enqueue(
+        ThreadPool::TaskOptions(ThreadPool::Priority::kNormal, deadline),
+        [] { return 1; });
+    auto late = pool.Enqueue(
+        ThreadPool::TaskOptions(ThreadPool::Priority::kBackground, deadline,
+                                ThreadPool::Expiry::kRunLate),
+        [] { return ThreadPool::IsLate(); });
+    auto on_time = pool.Enqueue(
+        ThreadPool::TaskOptions(
+            ThreadPool::Priority::kRealtime,
+            ThreadPool::Clock::now() + std::chrono::seconds(60)),
+        [] { return ThreadPool::IsLate(); });
+    MilliTimer::Sleep(5);
+    gate.store(true);
+
+    ASSERT_FALSE(on_time.get());
+    ASSERT_TRUE(late.get());
+    try {
+      dropped.get();
+      FAIL() << "an expired task was executed";
+    } catch (const std::future_error &e) {
+      ASSERT_EQ(e.code(), std::future_errc::broken_promise);
+    }
+    ASSERT_FALSE(ThreadPool::IsLate());
+
+    auto normal = pool.GetPriorityStats(ThreadPool::Priority::kNormal);
+    ASSERT_EQ(normal.expired, 1);
+    ASSERT_EQ(normal.dropped, 1);
+    auto background = pool.GetPriorityStats(ThreadPool::Priority::kBackground);
+    ASSERT_EQ(background.expired, 1);
+    ASSERT_EQ(background.dropped, 0);
+    auto realtime = pool.GetPriorityStats(ThreadPool::Priority::kRealtime);
+    ASSERT_EQ(realtime.expired, 0);
+
+    pool.ResetStats();
+    ASSERT_EQ(pool.GetPriorityStats(ThreadPool::Priority::kNormal).expired,
+              0);
+  }
+}
+
+TEST(ThreadPoolTest, waitTimeIsMeasuredPerClass) {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool pool(1, scheduling);
+    ASSERT_FALSE(pool.IsStatsEnabled());
+    pool.Enqueue([] {}).get();
+    ASSERT_EQ(pool.GetPriorityStats(ThreadPool::Priority::kNormal).executed,
+              0);
+
+    pool.EnableStats();
+    std::atomic<bool> gate(false);
+    BlockWorker(pool, gate);
+    std::atomic<int> done(0);
+    for (int i = 0; i < 10; ++i) {
+      pool.Post(ThreadPool::Priority::kBackground,
+                [&done] { done.fetch_add(1); });
+    }
+    pool.Post(ThreadPool::Priority::kRealtime, [&done] { done.fetch_add(1); });
+    MilliTimer::Sleep(5);
+    gate.store(true);
+    WaitFor(done, 11);
+
+    auto realtime = pool.GetPriorityStats(ThreadPool::Priority::kRealtime);
+    auto background = pool.GetPriorityStats(ThreadPool::Priority::kBackground);
+    ASSERT_EQ(realtime.executed, 1);
+    ASSERT_EQ(realtime.wait.count, 1);
+    ASSERT_GE(realtime.wait.max_ns, 5000000);
+    ASSERT_EQ(background.executed, 10);
+    ASSERT_EQ(background.wait.count, 10);
+    // The task blocking the worker.
+    ASSERT_EQ(pool.GetPriorityStats(ThreadPool::Priority::kNormal).executed,
+              1);
+  }
+}
+
+TEST(ThreadPoolTest, elasticPoolGrowsAndShrinks) {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool::Sizing sizing;
+    sizing.min_threads = 1;
+    sizing.max_threads = 4;
+    sizing.idle_timeout = std::chrono::milliseconds(20);
+    sizing.spin_count = 100;
+    ThreadPool pool(sizing, scheduling);
+    ASSERT_TRUE(pool.IsElastic());
+    ASSERT_EQ(pool.GetThreadCount(), 1);
+
+    std::atomic<bool> gate(false);
+    std::atomic<int> started(0);
+    std::atomic<int> done(0);
+    for (int i = 0; i < 6; ++i) {
+      pool.Post([&gate, &started, &done] {
+        started.fetch_add(1);
+        while (!gate.load()) {
+          std::this_thread::yield();
+        }
+        done.fetch_add(1);
+      });
+    }
+    WaitFor(started, 4);
+    ASSERT_EQ(pool.GetThreadCount(), 4);
+    ASSERT_EQ(pool.GetActiveCount(), 4);
+    ASSERT_EQ(pool.GetIdleCount(), 0);
+    ASSERT_EQ(pool.GetQueuedCount(), 2);
+
+    gate.store(true);
+    WaitFor(done, 6);
+    // The extra workers exit once idle for the timeout.
+    for (int i = 0; i < 500 && pool.GetThreadCount() > 1; ++i) {
+      MilliTimer::Sleep(10);
+    }
+    ASSERT_EQ(pool.GetThreadCount(), 1);
+    ASSERT_EQ(pool.GetIdleCount(), 1);
+    ASSERT_EQ(pool.GetQueuedCount(), 0);
+
+    // The slots of the exited workers are reused.
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 100; ++i) {
+      results.push_back(pool.Enqueue([i] { return i; }));
+    }
+    for (int i = 0; i < 100; ++i) {
+      ASSERT_EQ(results[i].get(), i);
+    }
+  }
+}
+
+TEST(ThreadPoolTest, elasticPoolWithoutWorkers) {
+  for (auto scheduling : kSchedulings) {
+    ThreadPool::Sizing sizing;
+    sizing.max_threads = 2;
+    sizing.idle_timeout = std::chrono::milliseconds(1);
+    ThreadPool pool(sizing, scheduling);
+    ASSERT_EQ(pool.GetThreadCount(), 0);
+    ASSERT_EQ(pool.Enqueue([] { return 42; }).get(), 42);
+
+    std::vector<std::atomic<int>> visits(1000);
+    for (auto &visit : visits) {
+      visit.store(0);
+    }
+    pool.ParallelFor(size_t(0), visits.size(), 10,
+                     [&visits](size_t i) { visits[i].fetch_add(1); });
+    for (auto &visit : visits) {
+      ASSERT_EQ(visit.load(), 1);
+    }
+  }
+
+  ThreadPool::Sizing sizing;
+  sizing.min_threads = 2;
+  sizing.max_threads = 1;
+  ASSERT_THROW(ThreadPool pool(sizing), std::invalid_argument);
+  sizing.min_threads = 0;
+  sizing.max_threads = 0;
+  ASSERT_THROW(ThreadPool pool(sizing), std::invalid_argument);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,195 @@
+/**
+ * \file	thread_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <lib_atlas/pattern/runnable.h>
+#include <lib_atlas/pattern/thread_pool.h>
+#include <lib_atlas/sys/thread.h>
+#include <pthread.h>
+#include <sched.h>
+#include <atomic>
+#include <cerrno>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace atlas;
+
+namespace {
+
+std::string CurrentName() {
+  char name[16] = {0};
+  pthread_getname_np(pthread_self(), name, sizeof(name));
+  return name;
+}
+
+size_t CurrentStackSize() {
+  pthread_attr_t attr;
+  size_t size = 0;
+  pthread_getattr_np(pthread_self(), &attr);
+  pthread_attr_getstacksize(&attr, &size);
+  pthread_attr_destroy(&attr);
+  return size;
+}
+
+class NamedRunnable : public Runnable {
+ public:
+  std::string name;
+  std::atomic<bool> done = {false};
+
+ protected:
+  void Run() override {
+    // The name is set by the creating thread once the thread exists.
+    while (CurrentName() != GetThreadAttributes().name) {
+    }
+    name = CurrentName();
+    done = true;
+    while (!MustStop()) {
+      std::this_thread::yield();
+    }
+  }
+};
+
+TEST(ThreadTest, defaultAttributes) {
+  int value = 0;
+  Thread thread(ThreadAttributes(), [&value] { value = 42; });
+  ASSERT_TRUE(thread.IsJoinable());
+  thread.Join();
+  ASSERT_FALSE(thread.IsJoinable());
+  ASSERT_EQ(value, 42);
+
+  Thread empty;
+  ASSERT_FALSE(empty.IsJoinable());
+  Thread moved(ThreadAttributes(), [] {});
+  empty = std::move(moved);
+  ASSERT_FALSE(moved.IsJoinable());
+  empty.Join();
+}
+
+TEST(ThreadTest, attributesAreApplied) {
+  ThreadAttributes attributes;
+  attributes.cpus = {0};
+  attributes.name = "a_very_long_thread_name";
+  attributes.stack_size = 4 << 20;
+  attributes.policy = ThreadAttributes::Policy::kOther;
+
+  std::atomic<bool> named(false);
+  int cpu = -1;
+  size_t stack_size = 0;
+  int policy = -1;
+  cpu_set_t cpus;
+  Thread thread(attributes, [&] {
+    while (CurrentName() != "a_very_long_thr") {
+    }
+    named = true;
+    cpu = sched_getcpu();
+    stack_size = CurrentStackSize();
+    policy = sched_getscheduler(0);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  });
+  thread.Join();
+  ASSERT_TRUE(named);
+  ASSERT_EQ(cpu, 0);
+  ASSERT_EQ(CPU_COUNT(&cpus), 1);
+  ASSERT_TRUE(CPU_ISSET(0, &cpus));
+  ASSERT_GE(stack_size, attributes.stack_size);
+  ASSERT_EQ(policy, SCHED_OTHER);
+  ASSERT_EQ(thread.GetAttributes().name, attributes.name);
+}
+
+TEST(ThreadTest, realtimePolicy) {
+  ThreadAttributes attributes;
+  attributes.policy = ThreadAttributes::Policy::kFifo;
+  attributes.priority = 10;
+  int policy = -1;
+  sched_param param;
+  try {
+    Thread thread(attributes, [&] {
+      pthread_getschedparam(pthread_self(), &policy, &param);
+    });
+    thread.Join();
+    ASSERT_EQ(policy, SCHED_FIFO);
+    ASSERT_EQ(param.sched_priority, 10);
+  } catch (const std::system_error &e) {
+    // Without CAP_SYS_NICE, the creation must fail rather than silently
+    // running with the default policy.
+    ASSERT_EQ(e.code().value(), EPERM);
+  }
+
+  attributes.priority = 1000;
+  ASSERT_THROW(Thread(attributes, [] {}), std::system_error);
+}
+
+TEST(ThreadTest, invalidCpuThrows) {
+  ThreadAttributes attributes;
+  attributes.cpus = {-1};
+  ASSERT_THROW(Thread(attributes, [] {}), std::system_error);
+}
+
+TEST(ThreadTest, numaNodeCpus) {
+  ASSERT_TRUE(GetNumaNodeCpus(100000).empty());
+  for (int cpu : GetNumaNodeCpus(0)) {
+    ASSERT_GE(cpu, 0);
+  }
+}
+
+TEST(ThreadTest, threadPoolWorkers) {
+  std::vector<ThreadAttributes> workers(2);
+  workers[0].name = "worker_0";
+  workers[0].cpus = {0};
+  workers[1].name = "worker_1";
+  ThreadPool pool(workers, ThreadPool::Scheduling::kWorkStealing);
+  ASSERT_EQ(pool.GetThreadCount(), 2);
+  ASSERT_EQ(pool.GetWorkerAttributes(1).name, "worker_1");
+  ASSERT_THROW(pool.GetWorkerAttributes(2), std::out_of_range);
+
+  char name[16] = {0};
+  pthread_getname_np(pool.GetWorkerHandle(0), name, sizeof(name));
+  ASSERT_EQ(std::string(name), "worker_0");
+  ASSERT_EQ(pool.Enqueue([](int a) { return a + 1; }, 1).get(), 2);
+
+  workers[1].cpus = {-1};
+  ASSERT_THROW(ThreadPool invalid(workers), std::system_error);
+}
+
+TEST(ThreadTest, runnableAttributes) {
+  NamedRunnable runnable;
+  ThreadAttributes attributes;
+  attributes.name = "runnable";
+  runnable.SetThreadAttributes(attributes);
+  runnable.Start();
+  while (!runnable.done) {
+    std::this_thread::yield();
+  }
+  runnable.Stop();
+  ASSERT_EQ(runnable.name, "runnable");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
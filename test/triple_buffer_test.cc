@@ -0,0 +1,127 @@
+/**
+ * \file	triple_buffer_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2015 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <lib_atlas/pattern/triple_buffer.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using namespace atlas;
+
+namespace {
+
+struct Sample {
+  uint64_t sequence = {0};
+
+  /** Always sequence * 3, to detect a torn read. */
+  uint64_t checksum = {0};
+};
+
+}  // namespace
+
+TEST(TripleBufferTest, readerGetsTheLatestValue) {
+  TripleBuffer<int> buffer(-1);
+  ASSERT_FALSE(buffer.HasUpdate());
+  ASSERT_FALSE(buffer.Update());
+  ASSERT_EQ(-1, buffer.GetReadBuffer());
+
+  buffer.Write(1);
+  buffer.Write(2);
+  buffer.Write(3);
+  ASSERT_TRUE(buffer.HasUpdate());
+  ASSERT_TRUE(buffer.Update());
+  ASSERT_EQ(3, buffer.GetReadBuffer());
+
+  // Nothing new, the reader keeps its value.
+  ASSERT_FALSE(buffer.Update());
+  ASSERT_EQ(3, buffer.GetReadBuffer());
+}
+
+TEST(TripleBufferTest, readBufferIsStableWhileWriting) {
+  TripleBuffer<int> buffer;
+  buffer.Write(1);
+  ASSERT_TRUE(buffer.Update());
+  const int &value = buffer.GetReadBuffer();
+  for (int i = 2; i < 10; ++i) {
+    buffer.GetWriteBuffer() = i;
+    buffer.Publish();
+    ASSERT_EQ(1, value);
+  }
+  ASSERT_TRUE(buffer.Update());
+  ASSERT_EQ(9, buffer.GetReadBuffer());
+}
+
+TEST(TripleBufferTest, writeBufferIsReused) {
+  TripleBuffer<std::unique_ptr<int>> buffer;
+  buffer.Write(std::unique_ptr<int>(new int(1)));
+  ASSERT_TRUE(buffer.Update());
+  buffer.Write(std::unique_ptr<int>(new int(2)));
+  buffer.Write(std::unique_ptr<int>(new int(3)));
+  // The write buffer now holds the value 2 the reader missed.
+  ASSERT_NE(nullptr, buffer.GetWriteBuffer());
+  ASSERT_EQ(2, *buffer.GetWriteBuffer());
+  ASSERT_TRUE(buffer.Update());
+  ASSERT_EQ(3, *buffer.GetReadBuffer());
+}
+
+TEST(TripleBufferTest, concurrentWriterAndReader) {
+  const uint64_t kWrites = 200000;
+  TripleBuffer<Sample> buffer;
+  std::atomic<bool> done(false);
+
+  std::thread writer([&]() {
+    for (uint64_t i = 1; i <= kWrites; ++i) {
+      Sample &sample = buffer.GetWriteBuffer();
+      sample.sequence = i;
+      sample.checksum = i * 3;
+      buffer.Publish();
+    }
+    done = true;
+  });
+
+  uint64_t last = 0;
+  uint64_t updates = 0;
+  while (!done || buffer.HasUpdate()) {
+    if (!buffer.Update()) {
+      std::this_thread::yield();
+      continue;
+    }
+    const Sample &sample = buffer.GetReadBuffer();
+    ASSERT_EQ(sample.sequence * 3, sample.checksum);
+    ASSERT_GT(sample.sequence, last);
+    last = sample.sequence;
+    ++updates;
+  }
+  writer.join();
+
+  ASSERT_EQ(kWrites, last);
+  ASSERT_LE(updates, kWrites);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}